@@ -0,0 +1,55 @@
+// Compares parseDate with the std::get_time + mktime parsing Fridge used to do per item.
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CivilDate.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::vector<std::string> dates;
+    dates.reserve(count);
+    int first = daysFromCivil(2020, 1, 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        dates.push_back(formatDate(first + static_cast<int>(i * 7919 % 3650)));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for (const auto& date : dates) {
+        int days;
+        if (parseDate(date, days)) {
+            sum += days;
+        }
+    }
+    double fast = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    long long check = 0;
+    for (const auto& date : dates) {
+        tm parsed = {};
+        std::istringstream ss(date);
+        ss >> std::get_time(&parsed, "%Y-%m-%d");
+        if (!ss.fail()) {
+            parsed.tm_hour = 12;   // away from DST changes, so dividing by a day is exact
+            check += static_cast<long long>(mktime(&parsed)) / (24 * 60 * 60);
+        }
+    }
+    double slow = secondsSince(start);
+
+    std::cout << count << " dates" << (sum == check ? "" : " (results differ!)") << "\n";
+    std::cout << "parseDate:          " << count / fast / 1e6 << " million dates/s\n";
+    std::cout << "get_time + mktime:  " << count / slow / 1e6 << " million dates/s\n";
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/Benchmarks/CivilDateBenchmark.cpp -I/path/to/project/HeaderFiles -o civilDateBenchmark
+//./civilDateBenchmark [dates]
@@ -0,0 +1,59 @@
+// Times ranking a large synthetic catalog by expiring stock.
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "ExpiryRanking.h"
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int recipeCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+    const int vocabulary = 2000;
+    const int rounds = 5;
+
+    std::vector<Recipe> recipes;
+    recipes.reserve(recipeCount);
+    unsigned seed = 12345;
+    for (int i = 0; i < recipeCount; ++i) {
+        std::vector<std::pair<std::string, std::string>> ingredients;
+        for (int k = 0; k < 8; ++k) {
+            seed = seed * 1103515245 + 12345;
+            ingredients.push_back({ "ingredient " + std::to_string((seed >> 8) % vocabulary), "1 unit" });
+        }
+        recipes.emplace_back("recipe " + std::to_string(i), std::move(ingredients), std::vector<std::pair<std::string, std::string>>{},
+                             std::vector<std::string>{}, i % 2 ? "Sweet" : "Savory");
+    }
+    RecipeCatalog catalog(std::move(recipes));
+
+    std::vector<Ingredient> inventory;
+    std::vector<std::pair<std::string, int>> daysLeft;
+    for (int i = 0; i < vocabulary; i += 2) {
+        inventory.emplace_back("ingredient " + std::to_string(i), 1, "");
+        if (i % 40 == 0) {
+            daysLeft.emplace_back("ingredient " + std::to_string(i), i % 9);
+        }
+    }
+
+    double bestBuild = 1e300;
+    double bestRank = 1e300;
+    std::size_t results = 0;
+    for (int round = 0; round < rounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        ExpiryRanker ranker(catalog, inventory, daysLeft);
+        bestBuild = std::min(bestBuild, millisecondsSince(start));
+
+        start = std::chrono::steady_clock::now();
+        results = ranker.rank(2, 20).size();
+        bestRank = std::min(bestRank, millisecondsSince(start));
+    }
+
+    std::cout << recipeCount << " recipes, " << catalog.ingredientCount() << " ingredients, " << daysLeft.size()
+              << " expiring items, best of " << rounds << " rounds\n";
+    std::cout << "weights: " << bestBuild << " ms, rank: " << bestRank << " ms (" << results << " results)\n";
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/ExpiryRankingBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -o expiryRankingBenchmark
+//./expiryRankingBenchmark [recipes]
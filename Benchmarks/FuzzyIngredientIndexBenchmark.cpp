@@ -0,0 +1,68 @@
+// Time per fuzzy lookup (edit distance <= 2) with the deletion dictionary against comparing
+// the query with every name.
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "FuzzyIngredientIndex.h"
+
+int main(int argc, char** argv) {
+    std::size_t vocabulary = argc > 1 ? std::stoul(argv[1]) : 10000;
+    const std::size_t queries = 2000;
+    const char* syllables[] = { "ba", "ce", "di", "fo", "gu", "ha", "ke", "li", "mo", "nu", "pa", "ro", "sa", "te", "vi", "zo" };
+
+    std::mt19937 random(42);
+    std::vector<std::string> words;
+    FuzzyIngredientIndex index;
+    while (words.size() < vocabulary) {
+        std::string word;
+        for (std::size_t n = 2 + random() % 4; n > 0; --n) {
+            word += syllables[random() % 16];
+        }
+        if (!index.contains(word)) {
+            index.add(word, static_cast<std::uint32_t>(random() % 100));
+            words.push_back(word);
+        }
+    }
+
+    // Each query is a known word with one or two typing mistakes.
+    std::vector<std::string> typos;
+    for (std::size_t q = 0; q < queries; ++q) {
+        std::string word = words[random() % words.size()];
+        for (std::size_t edits = 1 + random() % 2; edits > 0; --edits) {
+            std::size_t at = random() % word.size();
+            switch (random() % 3) {
+                case 0: word[at] = static_cast<char>('a' + random() % 26); break;
+                case 1: word.erase(at, 1); break;
+                default: word.insert(at, 1, static_cast<char>('a' + random() % 26)); break;
+            }
+        }
+        typos.push_back(word);
+    }
+
+    std::size_t treeMatches = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& typo : typos) {
+        treeMatches += index.suggest(typo, 2, words.size()).size();
+    }
+    double treeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t scanMatches = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& typo : typos) {
+        std::string key = IngredientAliases::wordForm(typo);
+        for (const auto& word : words) {
+            scanMatches += FuzzyIngredientIndex::editDistance(key, word) <= 2 ? 1 : 0;
+        }
+    }
+    double scanSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << words.size() << " names, " << queries << " lookups\n"
+              << "Index: " << treeSeconds / queries * 1e6 << " us per lookup (" << treeMatches << " matches)\n"
+              << "Scan:  " << scanSeconds / queries * 1e6 << " us per lookup (" << scanMatches << " matches)\n";
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/FuzzyIngredientIndexBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -pthread -o fuzzyIngredientIndexBenchmark
+//./fuzzyIngredientIndexBenchmark [names]
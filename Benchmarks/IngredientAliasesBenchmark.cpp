@@ -0,0 +1,33 @@
+// Names canonicalized per second by IngredientAliases, on a mix of recipe-style names.
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "IngredientAliases.h"
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 5000000;
+    const std::vector<std::string> samples = {
+        "Eggs", "cheddar cheese", "2 large eggs", "Fresh Basil Leaves", "tomatoes", "olive oil",
+        "chopped scallions", "all-purpose flour", "Chicken Breasts", "heavy cream", "bay leaves",
+        "ground beef", "soy sauce", "white rice", "sweet potatoes", "berries",
+    };
+
+    IngredientAliases aliases;
+    std::string out;
+    std::size_t totalLength = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string& name = samples[i % samples.size()];
+        aliases.canonical(name.data(), name.size(), out);
+        totalLength += out.size();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << aliases.termCount() << " terms, " << count << " names: " << count / seconds / 1e6
+              << " million names/s (checksum " << totalLength << ")\n";
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/Benchmarks/IngredientAliasesBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -o ingredientAliasesBenchmark
+//./ingredientAliasesBenchmark [names]
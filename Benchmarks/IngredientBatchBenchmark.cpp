@@ -0,0 +1,80 @@
+// Compares adding a delivery one item at a time (a message and a storage file rewrite per
+// item, as collectIngredients used to do) with a committed IngredientBatch.
+// Results go to stderr; run with stdout sent to a file or /dev/null to include the cost
+// of the messages without flooding the terminal.
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Fridge.h"
+#include "IngredientBatch.h"
+#include "Pantry.h"
+#include "PersistenceFormat.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void save(const Fridge& fridge, const Pantry& pantry, const std::string& path) {
+    json j;
+    j["Fridge"] = fridge.toJSON();
+    j["Pantry"] = pantry.toJSON();
+    writeDocument(path, j, PersistenceFormat::Json);
+}
+
+int main(int argc, char** argv) {
+    std::size_t itemCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+    // The per-item path rewrites the whole file each time, so it only runs on a prefix.
+    std::size_t perItemCount = argc > 2 ? std::stoul(argv[2]) : 2000;
+    const std::size_t distinctNames = 5000;
+    const std::string path = "ingredient_batch_benchmark.json";
+
+    std::vector<Ingredient> delivery;
+    delivery.reserve(itemCount);
+    for (std::size_t i = 0; i < itemCount; ++i) {
+        std::string date = i % 2 == 0 ? "2030-01-" + std::to_string(10 + i % 20) : "";
+        delivery.emplace_back("item " + std::to_string(i * 7919 % distinctNames), 1 + static_cast<int>(i % 5), date);
+    }
+
+    {
+        Fridge fridge;
+        Pantry pantry;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < perItemCount && i < itemCount; ++i) {
+            if (i % 2 == 0) {
+                fridge.addIngredient(delivery[i]);
+            } else {
+                pantry.addIngredient(delivery[i]);
+            }
+            save(fridge, pantry, path);
+        }
+        double seconds = secondsSince(start);
+        std::cerr << "per item: " << perItemCount / seconds << " items/s (" << perItemCount << " items)\n";
+    }
+
+    {
+        Fridge fridge;
+        Pantry pantry;
+        auto start = std::chrono::steady_clock::now();
+        IngredientBatch batch(fridge, pantry, [&]() { save(fridge, pantry, path); });
+        batch.reserve(itemCount / 2 + 1, itemCount / 2 + 1);
+        for (std::size_t i = 0; i < itemCount; ++i) {
+            if (i % 2 == 0) {
+                batch.addToFridge(delivery[i]);
+            } else {
+                batch.addToPantry(delivery[i]);
+            }
+        }
+        batch.commit();
+        double seconds = secondsSince(start);
+        std::cerr << "batch:    " << itemCount / seconds << " items/s (" << itemCount << " items, "
+                  << fridge.getIngredients().size() + pantry.getIngredients().size() << " after merging)\n";
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/IngredientBatchBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -pthread -o ingredientBatchBenchmark
+//./ingredientBatchBenchmark [items] [items for the per-item path] > /dev/null
@@ -0,0 +1,61 @@
+// Import throughput on a generated delivery manifest, in MB/s for a few thread counts.
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "Fridge.h"
+#include "InventoryImport.h"
+#include "Pantry.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t megabytes = argc > 1 ? std::stoul(argv[1]) : 100;
+    const std::string path = "inventory_import_benchmark.csv";
+    const int distinctNames = 20000;
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "name,quantity,expiration,location\n";
+        std::string line;
+        unsigned seed = 12345;
+        for (std::size_t written = 0; written < megabytes * 1024 * 1024; written += line.size()) {
+            seed = seed * 1103515245 + 12345;
+            unsigned r = seed >> 8;
+            line = "Supplier Item " + std::to_string(r % distinctNames) + "," + std::to_string(1 + r % 12) + "." + std::to_string(r % 10);
+            line += r % 3 == 0 ? ",2030-0" + std::to_string(1 + r % 9) + "-1" + std::to_string(r % 10) + ",fridge\n" : ",,pantry\n";
+            out << line;
+        }
+    }
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= cores; threads *= 2) {
+        double best = 1e9;
+        ImportReport report;
+        for (int round = 0; round < 3; ++round) {
+            Fridge fridge;
+            Pantry pantry;
+            IngredientBatch batch(fridge, pantry);
+            ImportOptions options;
+            options.threadCount = threads;
+            auto start = std::chrono::steady_clock::now();
+            importInventory(path, batch, report, options);
+            best = std::min(best, secondsSince(start));
+        }
+        std::cout << threads << " thread(s): " << report.bytes / best / (1024 * 1024) << " MB/s, "
+                  << report.imported << " items\n";
+        if (threads * 2 > cores && threads != cores) {
+            threads = cores / 2;
+        }
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/InventoryImportBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -o inventoryImportBenchmark
+//./inventoryImportBenchmark [megabytes]
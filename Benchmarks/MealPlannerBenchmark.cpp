@@ -0,0 +1,60 @@
+// Shows how meal-plan quality grows with the time budget on a large synthetic catalog.
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "MealPlanner.h"
+
+int main(int argc, char** argv) {
+    int recipeCount = argc > 1 ? std::stoi(argv[1]) : 5000;
+    int days = argc > 2 ? std::stoi(argv[2]) : 7;
+    const int vocabulary = 300;
+
+    std::vector<Recipe> recipes;
+    unsigned seed = 12345;
+    auto random = [&](unsigned range) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) % range;
+    };
+    for (int i = 0; i < recipeCount; ++i) {
+        std::vector<std::pair<std::string, std::string>> ingredients;
+        int count = 2 + random(4);
+        for (int k = 0; k < count; ++k) {
+            ingredients.push_back({ "ingredient " + std::to_string(random(vocabulary)), std::to_string(1 + random(3)) + " units" });
+        }
+        recipes.emplace_back("recipe " + std::to_string(i), std::move(ingredients), std::vector<std::pair<std::string, std::string>>{},
+                             std::vector<std::string>{}, "Savory");
+    }
+    RecipeCatalog catalog(std::move(recipes));
+
+    std::vector<Ingredient> inventory;
+    std::vector<std::pair<std::string, int>> daysLeft;
+    for (int i = 0; i < vocabulary; i += 2) {
+        std::string name = "ingredient " + std::to_string(i);
+        inventory.emplace_back(name, 1 + static_cast<int>(random(6)), "");
+        if (i % 3 == 0) {
+            daysLeft.emplace_back(name, static_cast<int>(random(days + 3)));
+        }
+    }
+    MealPlanner planner(catalog, inventory, daysLeft);
+
+    std::cout << recipeCount << " recipes, " << inventory.size() << " stock items, " << days << " days\n";
+    std::cout << std::setw(10) << "budget ms" << std::setw(8) << "beam" << std::setw(10) << "score" << std::setw(10) << "bound"
+              << std::setw(10) << "waste" << std::setw(12) << "states" << std::setw(12) << "memo hits"
+              << std::setw(12) << "elapsed ms" << std::setw(10) << "complete" << "\n";
+    for (int budget : { 0, 1, 5, 20, 100, 500 }) {
+        for (std::size_t beam : { 8, 64, 512 }) {
+            MealPlanOptions options;
+            options.days = days;
+            options.beamWidth = beam;
+            options.timeBudget = std::chrono::milliseconds(budget);
+            MealPlan plan = planner.plan(options);
+            std::cout << std::fixed << std::setprecision(3) << std::setw(10) << budget << std::setw(8) << beam << std::setw(10) << plan.score
+                      << std::setw(10) << plan.upperBound << std::setw(10) << plan.waste << std::setw(12) << plan.statesExplored
+                      << std::setw(12) << plan.memoHits << std::setw(12) << plan.elapsedMs << std::setw(10) << (plan.completed ? "yes" : "no") << "\n";
+        }
+    }
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/MealPlannerBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -o mealPlannerBenchmark
+//./mealPlannerBenchmark [recipes] [days]
@@ -0,0 +1,87 @@
+// Time per completion (one keystroke) from the radix trie against scanning every name.
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "NameCompleter.h"
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+    const char* syllables[] = { "ba", "ce", "di", "fo", "gu", "ha", "ke", "li", "mo", "nu", "pa", "ro", "sa", "te", "vi", "zo" };
+
+    std::mt19937 random(5);
+    std::vector<std::string> names;
+    std::vector<double> scores;
+    NameCompleter completer;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string name;
+        for (std::size_t n = 2 + random() % 5; n > 0; --n) {
+            name += syllables[random() % 16];
+            if (n > 1 && random() % 4 == 0) {
+                name += ' ';
+            }
+        }
+        double score = static_cast<double>(random() % 1000);
+        completer.setScore(name, i % 2 ? CompletionKind::Recipe : CompletionKind::Ingredient, score);
+        names.push_back(name);
+        scores.push_back(score);
+    }
+    double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Every prefix of some names, as if typed one key at a time.
+    std::vector<std::string> keystrokes;
+    for (int i = 0; i < 2000; ++i) {
+        const std::string& name = names[random() % names.size()];
+        for (std::size_t length = 1; length <= name.size(); ++length) {
+            keystrokes.push_back(name.substr(0, length));
+        }
+    }
+
+    std::size_t trieResults = 0;
+    std::vector<const Completion*> found;
+    start = std::chrono::steady_clock::now();
+    for (const auto& prefix : keystrokes) {
+        completer.complete(prefix, found);
+        trieResults += found.size();
+    }
+    double trieSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t copiedResults = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& prefix : keystrokes) {
+        copiedResults += completer.complete(prefix).size();
+    }
+    double copiedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t scanResults = 0;
+    std::size_t scanned = std::min<std::size_t>(keystrokes.size(), 500);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t k = 0; k < scanned; ++k) {
+        std::vector<std::pair<double, std::size_t>> matches;
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (names[i].compare(0, keystrokes[k].size(), keystrokes[k]) == 0) {
+                matches.emplace_back(-scores[i], i);
+            }
+        }
+        std::size_t keep = std::min<std::size_t>(matches.size(), NameCompleter::kTopK);
+        std::partial_sort(matches.begin(), matches.begin() + keep, matches.end());
+        scanResults += keep;
+    }
+    double scanSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << completer.size() << " names, built incrementally in " << buildSeconds * 1000 << " ms ("
+              << buildSeconds / count * 1e6 << " us per name)\n"
+              << "Trie: " << trieSeconds / keystrokes.size() * 1e9 << " ns per keystroke over " << keystrokes.size()
+              << " keystrokes (" << trieResults << " completions)\n"
+              << "Trie, copying the names: " << copiedSeconds / keystrokes.size() * 1e9 << " ns per keystroke ("
+              << copiedResults << " completions)\n"
+              << "Scan: " << scanSeconds / scanned * 1e9 << " ns per keystroke over " << scanned << " keystrokes ("
+              << scanResults << " completions)\n";
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/NameCompleterBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -pthread -o nameCompleterBenchmark
+//./nameCompleterBenchmark [names]
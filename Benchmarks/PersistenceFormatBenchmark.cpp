@@ -0,0 +1,63 @@
+// Compares document size and encode/decode time of the storage formats on a large inventory.
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "PersistenceFormat.h"
+#include "Storage.h"
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int itemCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+    const int rounds = 5;
+
+    // Names are unique, so load through fromJSON rather than paying addIngredient's duplicate scan.
+    json fridgeItems = json::array();
+    json pantryItems = json::array();
+    for (int i = 0; i < itemCount; ++i) {
+        std::string day = std::to_string(10 + i % 18);
+        fridgeItems.push_back(Ingredient("fridge item " + std::to_string(i), i % 50, "2024-11-" + day).toJSON());
+        pantryItems.push_back(Ingredient("pantry item " + std::to_string(i), i % 20, "").toJSON());
+    }
+    Storage fridge;
+    Storage pantry;
+    fridge.fromJSON(std::move(fridgeItems));
+    pantry.fromJSON(std::move(pantryItems));
+
+    json document;
+    document["Fridge"] = fridge.toJSON();
+    document["Pantry"] = pantry.toJSON();
+
+    std::cout << itemCount << " items per storage, best of " << rounds << " rounds\n";
+    std::cout << std::left << std::setw(10) << "format" << std::right << std::setw(14) << "bytes"
+              << std::setw(14) << "encode ms" << std::setw(14) << "decode ms" << "\n";
+
+    for (PersistenceFormat format : { PersistenceFormat::Json, PersistenceFormat::Cbor, PersistenceFormat::MessagePack }) {
+        double bestEncode = 1e300;
+        double bestDecode = 1e300;
+        std::size_t size = 0;
+        for (int round = 0; round < rounds; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::uint8_t> bytes = encodeDocument(document, format);
+            bestEncode = std::min(bestEncode, millisecondsSince(start));
+            size = bytes.size();
+
+            start = std::chrono::steady_clock::now();
+            json decoded = decodeDocument(bytes);
+            bestDecode = std::min(bestDecode, millisecondsSince(start));
+            if (decoded != document) {
+                std::cerr << formatName(format) << " did not round-trip\n";
+                return 1;
+            }
+        }
+        std::cout << std::left << std::setw(10) << formatName(format) << std::right << std::setw(14) << size
+                  << std::fixed << std::setprecision(2) << std::setw(14) << bestEncode << std::setw(14) << bestDecode << "\n";
+    }
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/Ingredient.cpp /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/HeaderFiles/Storage.cpp /path/to/project/HeaderFiles/PersistenceFormat.cpp /path/to/project/Benchmarks/PersistenceFormatBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -o persistenceBenchmark
+//./persistenceBenchmark [items]
@@ -0,0 +1,95 @@
+// Time per recipe for the streaming duplicate pass, and how many of the planted duplicates
+// and near-duplicates it finds, against comparing every pair on a smaller feed.
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "RecipeDeduplication.h"
+
+struct Feed {
+    std::vector<Recipe> recipes;
+    std::size_t exactCopies = 0;
+    std::size_t nearCopies = 0;
+};
+
+// Distinct dishes, then copies of earlier ones: renamed ("Easy ...", reordered ingredients)
+// or changed by one added ingredient.
+static Feed makeFeed(std::size_t count, std::mt19937& random) {
+    const char* fillers[] = { "Easy ", "The Best ", "Classic ", "Homemade " };
+    Feed feed;
+    std::vector<std::vector<std::string>> dishes;
+    while (feed.recipes.size() < count) {
+        std::size_t roll = random() % 10;
+        std::vector<std::pair<std::string, std::string>> amounts;
+        std::string name;
+        if (dishes.empty() || roll < 7) {
+            std::vector<std::string> ingredients;
+            for (std::size_t n = 5 + random() % 6; n > 0; --n) {
+                ingredients.push_back("ingredient " + std::to_string(random() % 20000));
+            }
+            name = "Dish " + std::to_string(dishes.size());
+            dishes.push_back(ingredients);
+            for (const auto& ingredient : ingredients) {
+                amounts.push_back({ ingredient, "1" });
+            }
+        } else {
+            std::size_t dish = random() % dishes.size();
+            const auto& ingredients = dishes[dish];
+            for (auto it = ingredients.rbegin(); it != ingredients.rend(); ++it) {
+                amounts.push_back({ *it, "1" });
+            }
+            name = fillers[random() % 4] + std::string("dish ") + std::to_string(dish);
+            if (roll < 9) {
+                ++feed.exactCopies;
+            } else {
+                amounts.push_back({ "ingredient " + std::to_string(20000 + random() % 1000), "1" });
+                ++feed.nearCopies;
+            }
+        }
+        feed.recipes.emplace_back(name, amounts, std::vector<std::pair<std::string, std::string>>{},
+                                  std::vector<std::string>{}, "Savory");
+    }
+    return feed;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::mt19937 random(42);
+    Feed feed = makeFeed(count, random);
+
+    // Normalized up front, so the all-pairs timing below covers only the comparisons.
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < count / 200; ++i) {
+        names.push_back(RecipeDeduplicator::normalizedName(feed.recipes[i].getRecipeName()));
+    }
+
+    RecipeDeduplicator deduplicator;
+    auto start = std::chrono::steady_clock::now();
+    for (auto& recipe : feed.recipes) {
+        deduplicator.add(std::move(recipe));
+    }
+    double streamSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const DedupReport& report = deduplicator.getReport();
+    std::cout << count << " recipes: " << streamSeconds / count * 1e9 << " ns per recipe ("
+              << streamSeconds * 1000 << " ms in total)\n"
+              << "Merged " << report.merged.size() << " of " << feed.exactCopies << " exact copies, flagged "
+              << report.nearDuplicates.size() << " of " << feed.nearCopies << " near copies\n";
+
+    // Every pair, by name alone, just to show the quadratic cost on a feed 200 times smaller.
+    std::size_t small = names.size();
+    std::size_t equalNames = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < small; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            equalNames += names[i] == names[j] ? 1 : 0;
+        }
+    }
+    double pairSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "All pairs of " << small << " recipes, names only: " << pairSeconds / small * 1e9 << " ns per recipe ("
+              << equalNames << " equal names)\n";
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/RecipeDeduplicationBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -pthread -o recipeDeduplicationBenchmark
+//./recipeDeduplicationBenchmark [recipes]
@@ -0,0 +1,90 @@
+// Recall and time per "similar recipes" query with MinHash LSH at several band / row
+// settings, against computing the exact Jaccard similarity with every recipe.
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "RecipeSimilarity.h"
+
+int main(int argc, char** argv) {
+    std::size_t recipeCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+    const std::size_t vocabulary = 5000;
+    const std::size_t queries = 200;
+    const std::size_t k = 10;
+
+    // Recipes come in families of variations on a dish: most of a base set, plus a few extras.
+    std::mt19937 random(42);
+    std::vector<Recipe> recipes;
+    std::vector<std::string> base;
+    while (recipes.size() < recipeCount) {
+        if (recipes.size() % 20 == 0) {
+            base.clear();
+            for (std::size_t n = 6 + random() % 6; n > 0; --n) {
+                base.push_back("ingredient " + std::to_string(random() % vocabulary));
+            }
+        }
+        std::vector<std::pair<std::string, std::string>> ingredients;
+        for (const auto& name : base) {
+            if (random() % 4 != 0) {
+                ingredients.push_back({ name, "1" });
+            }
+        }
+        for (std::size_t n = random() % 3; n > 0; --n) {
+            ingredients.push_back({ "ingredient " + std::to_string(random() % vocabulary), "1" });
+        }
+        recipes.emplace_back("Recipe " + std::to_string(recipes.size()), ingredients,
+                             std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Savory");
+    }
+    auto catalog = std::make_shared<const RecipeCatalog>(std::move(recipes));
+
+    std::vector<std::size_t> sample;
+    for (std::size_t q = 0; q < queries; ++q) {
+        sample.push_back(random() % catalog->size());
+    }
+
+    // The exact answer: the k-th best similarity for each query, so ties count as found.
+    RecipeSimilarityIndex exact(catalog);
+    std::vector<float> kthBest;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t query : sample) {
+        std::vector<float> all;
+        all.reserve(catalog->size());
+        for (std::size_t other = 0; other < catalog->size(); ++other) {
+            if (other != query) {
+                all.push_back(exact.jaccard(query, other));
+            }
+        }
+        std::nth_element(all.begin(), all.begin() + (k - 1), all.end(), [](float a, float b) { return a > b; });
+        kthBest.push_back(all[k - 1]);
+    }
+    double bruteSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << catalog->size() << " recipes, top " << k << " over " << queries << " queries\n"
+              << "Brute force: " << bruteSeconds / queries * 1e6 << " us per query\n";
+
+    const std::uint32_t settings[][2] = { { 8, 4 }, { 16, 3 }, { 24, 2 }, { 32, 2 }, { 64, 1 } };
+    for (const auto& setting : settings) {
+        SimilarityOptions options;
+        options.bands = setting[0];
+        options.rows = setting[1];
+        start = std::chrono::steady_clock::now();
+        RecipeSimilarityIndex index(catalog, options);
+        double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::size_t found = 0;
+        start = std::chrono::steady_clock::now();
+        for (std::size_t q = 0; q < queries; ++q) {
+            for (const auto& similar : index.similarTo(sample[q], k)) {
+                found += similar.similarity >= kthBest[q] ? 1 : 0;
+            }
+        }
+        double querySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << options.bands << " bands x " << options.rows << " rows: built in " << buildSeconds * 1000 << " ms, "
+                  << querySeconds / queries * 1e6 << " us per query, recall " << 100.0 * found / (queries * k) << "%\n";
+    }
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/RecipeSimilarityBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -pthread -o recipeSimilarityBenchmark
+//./recipeSimilarityBenchmark [recipes]
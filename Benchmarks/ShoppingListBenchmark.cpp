@@ -0,0 +1,57 @@
+// Times the greedy "enable the most recipes" shopping list on a large synthetic catalog.
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "ShoppingList.h"
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int recipeCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+    std::size_t maxItems = argc > 2 ? std::stoul(argv[2]) : 20;
+    const int vocabulary = 5000;
+    const int rounds = 5;
+
+    std::vector<Recipe> recipes;
+    recipes.reserve(recipeCount);
+    unsigned seed = 12345;
+    for (int i = 0; i < recipeCount; ++i) {
+        std::vector<std::pair<std::string, std::string>> ingredients;
+        for (int k = 0; k < 6; ++k) {
+            seed = seed * 1103515245 + 12345;
+            // Skewed so that some ingredients are far more common than others, as in real recipes.
+            unsigned r = (seed >> 8) % vocabulary;
+            ingredients.push_back({ "ingredient " + std::to_string(r * r / vocabulary), "1" });
+        }
+        recipes.emplace_back("recipe " + std::to_string(i), std::move(ingredients), std::vector<std::pair<std::string, std::string>>{},
+                             std::vector<std::string>{}, "Savory");
+    }
+    RecipeCatalog catalog(std::move(recipes));
+
+    std::vector<Ingredient> inventory;
+    for (int i = 0; i < vocabulary; i += 3) {
+        inventory.emplace_back("ingredient " + std::to_string(i), 1, "");
+    }
+    ShoppingListPlanner planner(catalog, inventory);
+
+    std::cout << recipeCount << " recipes, " << catalog.ingredientCount() << " ingredients, up to " << maxItems
+              << " purchases, best of " << rounds << " rounds\n";
+    for (unsigned threads : { 1u, std::max(1u, std::thread::hardware_concurrency()) }) {
+        double best = 1e300;
+        ShoppingList list;
+        for (int round = 0; round < rounds; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            list = planner.enableMost(maxItems, threads);
+            best = std::min(best, millisecondsSince(start));
+        }
+        std::cout << threads << " thread(s): " << best << " ms, " << list.items.size() << " items enable "
+                  << list.enabledRecipes.size() << " recipes\n";
+    }
+    return 0;
+}
+
+//to run: g++ -std=c++17 -O2 -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Benchmarks/ShoppingListBenchmark.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -o shoppingListBenchmark
+//./shoppingListBenchmark [recipes] [max items]
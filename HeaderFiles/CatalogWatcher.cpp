@@ -0,0 +1,123 @@
+#include "CatalogWatcher.h"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+#include "RecipeCatalog.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// How often the worker wakes up to check whether it has been stopped.
+static const int kWakeIntervalMs = 200;
+// Editors often write a file in several steps; wait for them to settle before reloading.
+static const int kSettleMs = 100;
+
+CatalogWatcher::CatalogWatcher(std::string src, std::function<void()> callback)
+    : source(std::move(src)), onChange(std::move(callback)), running(false) {}
+
+CatalogWatcher::~CatalogWatcher() {
+    stop();
+}
+
+void CatalogWatcher::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    worker = std::thread(&CatalogWatcher::run, this);
+}
+
+void CatalogWatcher::stop() {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+#ifdef __linux__
+
+void CatalogWatcher::run() {
+    // Watch the containing directory rather than the file itself, so a save that
+    // replaces the file (write to temp + rename) is still seen.
+    std::error_code ec;
+    bool watchingDirectory = source.find_first_of("*?") != std::string::npos || fs::is_directory(source, ec);
+    fs::path sourcePath(source);
+    fs::path directory = fs::is_directory(source, ec) ? sourcePath : sourcePath.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    std::string filename = sourcePath.filename().string();
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0 || inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0) {
+        std::cerr << "Could not watch recipe source: " << source << "\n";
+        if (fd >= 0) {
+            close(fd);
+        }
+        return;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while (running) {
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, kWakeIntervalMs) <= 0) {
+            continue;
+        }
+
+        bool changed = false;
+        do {
+            ssize_t length;
+            while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + length; ) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                    if (watchingDirectory || (event->len > 0 && filename == event->name)) {
+                        changed = true;
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            pfd.revents = 0;
+        } while (poll(&pfd, 1, kSettleMs) > 0);
+
+        if (changed && running) {
+            onChange();
+        }
+    }
+
+    close(fd);
+}
+
+#else
+
+// Latest modification time across every file the source currently expands to.
+static fs::file_time_type latestWriteTime(const std::string& source) {
+    fs::file_time_type latest{};
+    std::error_code ec;
+    for (const auto& shard : findRecipeShards(source)) {
+        auto time = fs::last_write_time(shard, ec);
+        if (!ec && time > latest) {
+            latest = time;
+        }
+    }
+    return latest;
+}
+
+void CatalogWatcher::run() {
+    fs::file_time_type lastSeen = latestWriteTime(source);
+    while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kWakeIntervalMs));
+        fs::file_time_type current = latestWriteTime(source);
+        if (current != lastSeen) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kSettleMs));
+            lastSeen = latestWriteTime(source);
+            onChange();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef CATALOGWATCHER_H
+#define CATALOGWATCHER_H
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+// Watches a recipe source (a recipes.json, a shard directory or a "dir/*.json" pattern)
+// on a background thread and calls onChange after the files are modified.
+// Uses inotify on Linux and falls back to polling modification times elsewhere.
+class CatalogWatcher {
+private:
+    std::string source;
+    std::function<void()> onChange;
+    std::atomic<bool> running;
+    std::thread worker;
+
+    void run();
+
+public:
+    CatalogWatcher(std::string source, std::function<void()> onChange);
+    ~CatalogWatcher();
+
+    CatalogWatcher(const CatalogWatcher&) = delete;
+    CatalogWatcher& operator=(const CatalogWatcher&) = delete;
+
+    void start();
+    void stop();
+};
+
+#endif
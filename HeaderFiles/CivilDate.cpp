@@ -0,0 +1,151 @@
+#include "CivilDate.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIVILDATE_SSE2 1
+#endif
+
+// Howard Hinnant's days_from_civil: eras of 400 years, with years starting in March so the
+// leap day is the last day of the year.
+int daysFromCivil(int year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int>(dayOfEra) - 719468;
+}
+
+void civilFromDays(int days, int& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = static_cast<int>(yearOfEra) + era * 400 + (month <= 2);
+}
+
+static unsigned daysInMonth(int year, unsigned month) {
+    static const unsigned char lengths[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return lengths[month - 1] + (month == 2 && leap);
+}
+
+static bool toDays(int year, unsigned month, unsigned day, int& days) {
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+    days = daysFromCivil(year, month, day);
+    return true;
+}
+
+// True if every byte of the 10-character form is a digit except the two dashes.
+static bool hasDateShape(const char* text) {
+#ifdef CIVILDATE_SSE2
+    char padded[16] = {};
+    std::memcpy(padded, text, 10);
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded));
+    __m128i digits = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_max_epu8(digits, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+    __m128i isDash = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('-'));
+    const int digitMask = _mm_movemask_epi8(isDigit) & 0x3ff;
+    const int dashMask = _mm_movemask_epi8(isDash) & 0x3ff;
+    return digitMask == 0x36f && dashMask == 0x090;   // digits at 0-3, 5-6, 8-9; dashes at 4, 7
+#else
+    unsigned bad = 0;
+    for (int i = 0; i < 10; ++i) {
+        unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+        bad |= (i == 4 || i == 7) ? text[i] != '-' : digit > 9;
+    }
+    return bad == 0;
+#endif
+}
+
+// Reads 1 to maxDigits digits at text[pos], advancing pos.
+static bool readNumber(const char* text, std::size_t length, std::size_t& pos, std::size_t maxDigits, unsigned& value) {
+    std::size_t start = pos;
+    value = 0;
+    while (pos < length && pos - start < maxDigits && text[pos] >= '0' && text[pos] <= '9') {
+        value = value * 10 + static_cast<unsigned>(text[pos++] - '0');
+    }
+    return pos > start;
+}
+
+bool parseDate(const char* text, std::size_t length, int& days) {
+    if (length == 10 && hasDateShape(text)) {
+        auto digit = [text](int i) { return static_cast<unsigned>(text[i] - '0'); };
+        int year = static_cast<int>(digit(0) * 1000 + digit(1) * 100 + digit(2) * 10 + digit(3));
+        return toDays(year, digit(5) * 10 + digit(6), digit(8) * 10 + digit(9), days);
+    }
+
+    // The unpadded forms that std::get_time used to accept.
+    std::size_t pos = 0;
+    unsigned year, month, day;
+    if (!readNumber(text, length, pos, 4, year) || pos != 4 || pos >= length || text[pos++] != '-' ||
+        !readNumber(text, length, pos, 2, month) || pos >= length || text[pos++] != '-' ||
+        !readNumber(text, length, pos, 2, day) || pos != length) {
+        return false;
+    }
+    return toDays(static_cast<int>(year), month, day, days);
+}
+
+bool parseDate(const std::string& text, int& days) {
+    return parseDate(text.data(), text.size(), days);
+}
+
+void formatDate(int days, char* out) {
+    int year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+    unsigned y = static_cast<unsigned>(year) % 10000;
+    out[0] = static_cast<char>('0' + y / 1000);
+    out[1] = static_cast<char>('0' + y / 100 % 10);
+    out[2] = static_cast<char>('0' + y / 10 % 10);
+    out[3] = static_cast<char>('0' + y % 10);
+    out[4] = '-';
+    out[5] = static_cast<char>('0' + month / 10);
+    out[6] = static_cast<char>('0' + month % 10);
+    out[7] = '-';
+    out[8] = static_cast<char>('0' + day / 10);
+    out[9] = static_cast<char>('0' + day % 10);
+}
+
+std::string formatDate(int days) {
+    char buffer[10];
+    formatDate(days, buffer);
+    return std::string(buffer, sizeof(buffer));
+}
+
+// The cached local date in the low 32 bits and the clock time it stays valid until in the
+// high 32, in one atomic so a reader never pairs a day with another day's deadline. Zero
+// has a deadline in 1970, so the first call always computes the date.
+static std::atomic<std::uint64_t> cachedToday(0);
+
+int today() {
+    time_t now = time(0);
+    std::uint64_t cached = cachedToday.load(std::memory_order_acquire);
+    if (static_cast<long long>(now) < static_cast<long long>(cached >> 32)) {
+        return static_cast<int>(static_cast<std::uint32_t>(cached));
+    }
+
+    tm local = {};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    int days = daysFromCivil(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1), static_cast<unsigned>(local.tm_mday));
+    // Recheck at least hourly so a DST change during the day cannot carry the date past midnight.
+    long long untilMidnight = 24 * 3600 - (local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec);
+    long long valid = untilMidnight < 3600 ? untilMidnight : 3600;
+    std::uint64_t until = static_cast<std::uint64_t>(static_cast<long long>(now) + valid);
+    cachedToday.store(until << 32 | static_cast<std::uint32_t>(days), std::memory_order_release);
+    return days;
+}
@@ -0,0 +1,29 @@
+#ifndef CIVILDATE_H
+#define CIVILDATE_H
+
+#include <string>
+
+// Calendar dates as a day number: days since 1970-01-01 in the proleptic Gregorian calendar.
+// Differences between day numbers are whole days, with no time zone or DST involved.
+
+// Day number used for "no date".
+const int kNoDate = -2147483647 - 1;
+
+int daysFromCivil(int year, unsigned month, unsigned day);
+void civilFromDays(int days, int& year, unsigned& month, unsigned& day);
+
+// Reads a YYYY-MM-DD date. The padded 10-character form is validated in one step (with SSE2
+// where available); a month or day written with one digit ("2024-1-5") is also accepted.
+// Returns false for anything else, including dates that do not exist such as 2023-02-29.
+bool parseDate(const char* text, std::size_t length, int& days);
+bool parseDate(const std::string& text, int& days);
+
+// Writes the date as YYYY-MM-DD into out[0..9] (not terminated).
+void formatDate(int days, char* out);
+std::string formatDate(int days);
+
+// Today's local date. Worked out from the clock at most once an hour and shared between
+// threads, so calling it per item is cheap and safe.
+int today();
+
+#endif
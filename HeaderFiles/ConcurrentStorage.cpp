@@ -0,0 +1,45 @@
+#include "ConcurrentStorage.h"
+
+ConcurrentStorage::ConcurrentStorage() : current(std::make_shared<const Storage>()), version(0) {}
+
+ConcurrentStorage::ConcurrentStorage(const Storage& initial) : current(std::make_shared<const Storage>(initial)), version(0) {}
+
+ConcurrentStorage::Snapshot ConcurrentStorage::snapshot() const {
+    return std::atomic_load(&current);
+}
+
+std::uint64_t ConcurrentStorage::getVersion() const {
+    return version.load(std::memory_order_acquire);
+}
+
+void ConcurrentStorage::update(const std::function<void(Storage&)>& mutation) {
+    std::lock_guard<std::mutex> guard(writeLock);
+    auto draft = std::make_shared<Storage>(*current);
+    mutation(*draft);
+    std::atomic_store(&current, Snapshot(std::move(draft)));
+    version.fetch_add(1, std::memory_order_release);
+}
+
+void ConcurrentStorage::addIngredient(const Ingredient& ingredient) {
+    update([&](Storage& storage) { storage.addIngredient(ingredient); });
+}
+
+void ConcurrentStorage::addIngredients(const std::vector<Ingredient>& items) {
+    update([&](Storage& storage) { storage.addIngredients(items); });
+}
+
+bool ConcurrentStorage::setQuantity(const std::string& name, int quantity) {
+    bool found = false;
+    update([&](Storage& storage) { found = storage.setQuantity(name, quantity); });
+    return found;
+}
+
+bool ConcurrentStorage::removeIngredient(const std::string& name) {
+    bool found = false;
+    update([&](Storage& storage) { found = storage.removeIngredient(name); });
+    return found;
+}
+
+json ConcurrentStorage::toJSON() const {
+    return snapshot()->toJSON();
+}
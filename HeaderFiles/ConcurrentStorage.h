@@ -0,0 +1,46 @@
+#ifndef CONCURRENTSTORAGE_H
+#define CONCURRENTSTORAGE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Storage.h"
+#include "Ingredient.h"
+
+// A Storage that many threads can read while others update it.
+// Each update copies the current inventory, changes the copy and publishes it as a new
+// version. Readers take a snapshot, which never changes underneath them and stays valid
+// for as long as they hold it, so matching never waits on a writer.
+class ConcurrentStorage {
+public:
+    using Snapshot = std::shared_ptr<const Storage>;
+
+private:
+    Snapshot current;            // only accessed through std::atomic_load/atomic_store
+    std::mutex writeLock;        // serializes writers; readers never take it
+    std::atomic<std::uint64_t> version;
+
+public:
+    ConcurrentStorage();
+    explicit ConcurrentStorage(const Storage& initial);
+
+    Snapshot snapshot() const;
+    std::uint64_t getVersion() const;
+
+    // Applies mutation to a private copy of the inventory and publishes the result.
+    void update(const std::function<void(Storage&)>& mutation);
+
+    void addIngredient(const Ingredient& ingredient);
+    // The whole batch becomes visible to readers as a single new version.
+    void addIngredients(const std::vector<Ingredient>& items);
+    bool setQuantity(const std::string& name, int quantity);
+    bool removeIngredient(const std::string& name);
+
+    json toJSON() const;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "Cooking.h"
+#include "CivilDate.h"
+#include "IngredientAliases.h"
+#include <algorithm>
+#include <map>
+#include <utility>
+
+
+static Storage& storageNamed(const std::string& name, Storage& fridge, Storage& pantry) {
+    return name == "Fridge" ? fridge : pantry;
+}
+
+// Ingredient amounts are kept in thousandths; anything less rounds to nothing.
+static const double kNothing = 0.5 / Ingredient::kAmountScale;
+
+// Takes `amount` units of the named item, removing it once nothing is left.
+static void take(Storage& storage, const std::string& name, double amount) {
+    for (const auto& ingredient : storage.getIngredients()) {
+        if (ingredient.getName() == name) {
+            double left = ingredient.getAmount() - amount;
+            if (left >= kNothing) {
+                storage.setAmount(name, left);
+            } else {
+                storage.removeIngredient(name);
+            }
+            return;
+        }
+    }
+}
+
+bool planDeductions(const Recipe& recipe, const Storage& fridge, const Storage& pantry,
+                    std::vector<Deduction>& deductions, std::vector<std::string>& missing,
+                    const Substitutions& substitutions, const IngredientAliases* aliases) {
+    deductions.clear();
+    missing.clear();
+
+    const std::pair<const char*, const Storage*> storages[] = { { "Fridge", &fridge }, { "Pantry", &pantry } };
+    // Stored items and recipe ingredients are matched by canonical name ("eggs" takes "egg").
+    std::shared_ptr<const IngredientAliases> installed;
+    if (!aliases) {
+        installed = IngredientAliases::current();
+        aliases = installed.get();
+    }
+    std::vector<std::string> storedNames[2];
+    for (int s = 0; s < 2; ++s) {
+        for (const auto& item : storages[s].second->getIngredients()) {
+            storedNames[s].push_back(aliases->canonical(item.getName()));
+        }
+    }
+    // What is left of each stored item after the ingredients planned so far, and its deduction.
+    std::map<std::pair<int, std::size_t>, double> left;
+    std::map<std::pair<int, std::size_t>, std::size_t> deductionOf;
+
+    for (const auto& required : recipe.getRequiredIngredients()) {
+        std::string name = aliases->canonical(required.first);
+        auto substitute = substitutions.find(name);
+        if (substitute != substitutions.end()) {
+            name = aliases->canonical(substitute->second);
+        }
+        double need = stockNeeded(required.second);
+        bool present = false;
+        for (int s = 0; s < 2 && (need >= kNothing || !present); ++s) {
+            const auto& items = storages[s].second->getIngredients();
+            for (std::size_t i = 0; i < items.size() && (need >= kNothing || !present); ++i) {
+                if (storedNames[s][i] != name) {
+                    continue;
+                }
+                auto key = std::make_pair(s, i);
+                auto known = left.emplace(key, items[i].getAmount()).first;
+                if (known->second < kNothing) {
+                    continue;
+                }
+                present = true;
+                double taken = std::min(need, known->second);
+                if (taken < kNothing) {
+                    continue;
+                }
+                known->second -= taken;
+                need -= taken;
+                auto inserted = deductionOf.emplace(key, deductions.size());
+                if (inserted.second) {
+                    deductions.push_back(Deduction{ storages[s].first, items[i], taken });
+                } else {
+                    deductions[inserted.first->second].amount += taken;
+                }
+            }
+        }
+        if (!present || need >= kNothing) {
+            missing.push_back(required.first);
+        }
+    }
+
+    if (!missing.empty()) {
+        deductions.clear();
+        return false;
+    }
+    return true;
+}
+
+void applyDeductions(Storage& fridge, Storage& pantry, const std::vector<Deduction>& deductions) {
+    for (const auto& deduction : deductions) {
+        take(storageNamed(deduction.storage, fridge, pantry), deduction.before.getName(), deduction.amount);
+    }
+}
+
+void undoDeductions(Storage& fridge, Storage& pantry, const std::vector<Deduction>& deductions) {
+    for (auto it = deductions.rbegin(); it != deductions.rend(); ++it) {
+        Storage& storage = storageNamed(it->storage, fridge, pantry);
+        if (!storage.setAmount(it->before.getName(), it->before.getAmount())) {
+            // Qualified so that Fridge does not announce an item it never lost.
+            storage.Storage::addIngredient(it->before);
+        }
+    }
+}
+
+json cookRecord(const std::string& recipeName, std::size_t recipeId, const std::vector<Deduction>& deductions) {
+    json record;
+    record["type"] = "cook";
+    record["name"] = recipeName;
+    if (recipeId != static_cast<std::size_t>(-1)) {
+        record["id"] = recipeId;
+    }
+    record["date"] = formatDate(today());
+
+    record["deductions"] = json::array();
+    for (const auto& deduction : deductions) {
+        record["deductions"].push_back({ {"storage", deduction.storage}, {"name", deduction.before.getName()}, {"quantity", deduction.amount} });
+    }
+    return record;
+}
+
+void replayCookRecord(const json& record, Storage& fridge, Storage& pantry) {
+    if (!record.contains("deductions") || !record["deductions"].is_array()) {
+        return;
+    }
+    for (const auto& deduction : record["deductions"]) {
+        take(storageNamed(deduction.value("storage", ""), fridge, pantry), deduction.value("name", ""), deduction.value("quantity", 0.0));
+    }
+}
+
+json historyEntry(const json& record) {
+    json entry;
+    entry["name"] = record.value("name", "");
+    if (record.contains("id")) {
+        entry["id"] = record["id"];
+    }
+    entry["date"] = record.value("date", "");
+    entry["seq"] = record.value("seq", std::uint64_t(0));
+    return entry;
+}
@@ -0,0 +1,48 @@
+#ifndef COOKING_H
+#define COOKING_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Ingredient.h"
+#include "IngredientAliases.h"
+#include "Recipe.h"
+#include "Storage.h"
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+// One change cooking makes to a storage: `amount` units (to a thousandth) taken from the item
+// that looked like `before`. An item whose amount reaches zero is removed.
+struct Deduction {
+    std::string storage;   // "Fridge" or "Pantry"
+    Ingredient before;
+    double amount;
+};
+
+// Stocked items to take instead of recipe ingredients, keyed by the ingredient's canonical
+// name: {"butter": "margarine"} takes margarine wherever the recipe asks for butter.
+using Substitutions = std::unordered_map<std::string, std::string>;
+
+// Works out what cooking the recipe takes, from the fridge first and then the pantry.
+// Stored items count for an ingredient when their canonical names match, and each
+// ingredient takes stockNeeded of its amount, from its substitute if it has one. Names are
+// canonicalized with `aliases`, or IngredientAliases::current() if it is null. Returns
+// false, with the short ingredients in `missing`, if the stock is not enough. Nothing is
+// changed either way.
+bool planDeductions(const Recipe& recipe, const Storage& fridge, const Storage& pantry,
+                    std::vector<Deduction>& deductions, std::vector<std::string>& missing,
+                    const Substitutions& substitutions = Substitutions(), const IngredientAliases* aliases = nullptr);
+
+void applyDeductions(Storage& fridge, Storage& pantry, const std::vector<Deduction>& deductions);
+// Puts back what applyDeductions took, including removed items and their dates.
+void undoDeductions(Storage& fridge, Storage& pantry, const std::vector<Deduction>& deductions);
+
+// The log form of a cooked recipe: {"type": "cook", "name", "id", "date", "deductions": [...]}.
+json cookRecord(const std::string& recipeName, std::size_t recipeId, const std::vector<Deduction>& deductions);
+// Re-applies the deductions of a logged cook record.
+void replayCookRecord(const json& record, Storage& fridge, Storage& pantry);
+// The history.json entry for a cook record.
+json historyEntry(const json& record);
+
+#endif
@@ -0,0 +1,107 @@
+#include "EditDistance.h"
+#include <algorithm>
+#include <cstring>
+
+EditDistancePattern::EditDistancePattern(const std::string& query) : text(query) {
+    std::memset(peq, 0, sizeof(peq));
+    for (std::size_t i = 0; i < text.size() && i < 64; ++i) {
+        peq[static_cast<unsigned char>(text[i])] |= std::uint64_t(1) << i;
+    }
+}
+
+// Plain dynamic programming, for patterns too long for one machine word.
+std::uint32_t EditDistancePattern::slowDistance(const std::string& other) const {
+    std::vector<std::uint32_t> row(other.size() + 1);
+    for (std::size_t j = 0; j <= other.size(); ++j) {
+        row[j] = static_cast<std::uint32_t>(j);
+    }
+    for (std::size_t i = 1; i <= text.size(); ++i) {
+        std::uint32_t diagonal = row[0];
+        row[0] = static_cast<std::uint32_t>(i);
+        for (std::size_t j = 1; j <= other.size(); ++j) {
+            std::uint32_t above = row[j];
+            row[j] = std::min({ above + 1, row[j - 1] + 1, diagonal + (text[i - 1] == other[j - 1] ? 0u : 1u) });
+            diagonal = above;
+        }
+    }
+    return row[other.size()];
+}
+
+// Myers' bit-vector algorithm in Hyyrö's form for whole-string distance: the column of
+// the DP table is kept as vertical +1/-1 deltas in two words, and each character of
+// `other` updates all of it with a handful of word operations.
+std::uint32_t EditDistancePattern::distance(const std::string& other) const {
+    if (text.size() > 64) {
+        return slowDistance(other);
+    }
+    if (text.empty()) {
+        return static_cast<std::uint32_t>(other.size());
+    }
+    const std::uint64_t last = std::uint64_t(1) << (text.size() - 1);
+    std::uint64_t pv = ~std::uint64_t(0);
+    std::uint64_t mv = 0;
+    std::uint32_t score = static_cast<std::uint32_t>(text.size());
+    for (unsigned char c : other) {
+        std::uint64_t eq = peq[c];
+        std::uint64_t xv = eq | mv;
+        std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+        if (ph & last) {
+            ++score;
+        } else if (mh & last) {
+            --score;
+        }
+        // The top row of the table is 0, 1, 2, ...: every step to the right adds one.
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+std::size_t boundedEditDistance(const std::string& a, const std::string& b, std::size_t maxDistance) {
+    std::size_t lengthGap = a.size() > b.size() ? a.size() - b.size() : b.size() - a.size();
+    if (lengthGap > maxDistance) {
+        return maxDistance + 1;
+    }
+    return std::min<std::size_t>(EditDistancePattern(a).distance(b), maxDistance + 1);
+}
+
+// FNV-1a; only used to file deletions, where a collision costs one extra distance check.
+static std::uint64_t hashBytes(const char* text, std::size_t length) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (std::size_t i = 0; i < length; ++i) {
+        h = (h ^ static_cast<unsigned char>(text[i])) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+// Deletes positions at or after `from` only, so each set of deleted positions is reached
+// in one order; scratch holds one buffer per remaining level.
+static void addDeletions(const std::string& text, std::size_t from, std::size_t depth, std::string* scratch,
+                         std::vector<std::uint64_t>& hashes) {
+    hashes.push_back(hashBytes(text.data(), text.size()));
+    if (depth == 0) {
+        return;
+    }
+    std::string& shorter = *scratch;
+    for (std::size_t i = from; i < text.size(); ++i) {
+        shorter.assign(text, 0, i);
+        shorter.append(text, i + 1, std::string::npos);
+        addDeletions(shorter, i, depth - 1, scratch + 1, hashes);
+    }
+}
+
+void deletionHashes(const std::string& key, std::size_t depth, std::vector<std::uint64_t>& hashes) {
+    thread_local std::vector<std::string> scratch;
+    hashes.clear();
+    depth = std::min(depth, key.size());
+    if (scratch.size() < depth) {
+        scratch.resize(depth);
+    }
+    addDeletions(key, 0, depth, scratch.data(), hashes);
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+}
@@ -0,0 +1,36 @@
+#ifndef EDITDISTANCE_H
+#define EDITDISTANCE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Levenshtein distance and deletion neighbourhoods, shared by the typo-tolerant lookups in
+// RecipeSearchIndex and FuzzyIngredientIndex.
+
+// A string prepared for repeated distance computations: for each byte, the bit mask of the
+// positions where it occurs. The string must outlive the pattern.
+class EditDistancePattern {
+private:
+    std::uint64_t peq[256];
+    const std::string& text;
+
+    std::uint32_t slowDistance(const std::string& other) const;
+
+public:
+    explicit EditDistancePattern(const std::string& text);
+
+    // Levenshtein distance to other (insertions, deletions and substitutions all cost 1).
+    std::uint32_t distance(const std::string& other) const;
+};
+
+// Levenshtein distance, or maxDistance + 1 if it is more than maxDistance.
+std::size_t boundedEditDistance(const std::string& a, const std::string& b, std::size_t maxDistance);
+
+// Hashes of the key and of every string left after deleting up to `depth` of its characters,
+// sorted and without repeats. Two strings within k edits share a hash once each has had at
+// most k characters deleted (a substitution is one deletion on each side), so an index
+// filed under these hashes finds the candidates without comparing against everything.
+void deletionHashes(const std::string& key, std::size_t depth, std::vector<std::uint64_t>& hashes);
+
+#endif
@@ -0,0 +1,60 @@
+#include "ExpiryRanking.h"
+#include <algorithm>
+
+ExpiryRanker::ExpiryRanker(const RecipeCatalog& recipeCatalog, const std::vector<Ingredient>& inventory,
+                           const std::vector<std::pair<std::string, int>>& daysLeft, int horizonDays)
+    : catalog(recipeCatalog), urgency(recipeCatalog.ingredientCount(), 0.0f), lacking(recipeCatalog.ingredientCount(), 1.0f) {
+    for (const auto& ingredient : inventory) {
+        IngredientId id = catalog.findIngredient(ingredient.getName());
+        if (id != RecipeCatalog::kNoIngredient) {
+            lacking[id] = 0.0f;
+        }
+    }
+
+    horizonDays = std::max(horizonDays, 0);
+    for (const auto& item : daysLeft) {
+        IngredientId id = catalog.findIngredient(item.first);
+        if (id == RecipeCatalog::kNoIngredient || item.second > horizonDays) {
+            continue;
+        }
+        float weight = static_cast<float>(horizonDays + 1 - std::max(item.second, 0)) / (horizonDays + 1);
+        // The same item can be stored twice with different dates; the soonest one counts.
+        urgency[id] = std::max(urgency[id], weight);
+    }
+}
+
+float ExpiryRanker::getUrgency(IngredientId id) const {
+    return id < urgency.size() ? urgency[id] : 0.0f;
+}
+
+std::vector<ExpiryRanker::Ranked> ExpiryRanker::rank(std::size_t maxMissing, std::size_t limit) const {
+    std::vector<Ranked> ranked;
+    const float* weights = urgency.data();
+    const float* missingWeights = lacking.data();
+    for (std::size_t recipeId = 0; recipeId < catalog.size(); ++recipeId) {
+        float score = 0.0f;
+        float missing = 0.0f;
+        for (IngredientId id : catalog.getRecipeIngredients(recipeId)) {
+            score += weights[id];
+            missing += missingWeights[id];
+        }
+        if (score > 0.0f && missing <= maxMissing) {
+            std::uint32_t missingCount = static_cast<std::uint32_t>(missing);
+            ranked.push_back(Ranked{ recipeId, score / (1 + missingCount), missingCount });
+        }
+    }
+
+    auto better = [](const Ranked& a, const Ranked& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        if (a.missing != b.missing) {
+            return a.missing < b.missing;
+        }
+        return a.recipeId < b.recipeId;
+    };
+    std::size_t keep = std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(), better);
+    ranked.resize(keep);
+    return ranked;
+}
@@ -0,0 +1,44 @@
+#ifndef EXPIRYRANKING_H
+#define EXPIRYRANKING_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Ingredient.h"
+#include "RecipeCatalog.h"
+
+// Ranks recipes by how much of the soon-to-expire stock they would use up.
+//
+// Every ingredient gets an urgency weight once, when the ranker is built: 1 for an item
+// that expires today (or already has), falling linearly to 1 / (horizonDays + 1) at the
+// horizon, and 0 for everything else. A recipe's score is then the dot product of that
+// weight vector with its ingredient list, divided by (1 + missing ingredients) so that
+// recipes the household can make right away come before ones that need shopping.
+class ExpiryRanker {
+public:
+    struct Ranked {
+        std::size_t recipeId;
+        float score;
+        std::uint32_t missing;   // main ingredients not in the inventory
+    };
+
+private:
+    const RecipeCatalog& catalog;
+    // Indexed by IngredientId. Kept as floats so scoring is one flat gather-and-add per recipe.
+    std::vector<float> urgency;
+    std::vector<float> lacking;   // 1 if the ingredient is not in the inventory, else 0
+
+public:
+    // inventory: everything on hand (fridge and pantry). daysLeft: days until expiry for the
+    // items that have a date, as given by Fridge::daysUntilExpiry.
+    ExpiryRanker(const RecipeCatalog& catalog, const std::vector<Ingredient>& inventory,
+                 const std::vector<std::pair<std::string, int>>& daysLeft, int horizonDays = 7);
+
+    float getUrgency(IngredientId id) const;
+    // Recipes that use at least one urgent item and miss at most maxMissing ingredients,
+    // best first; ties go to fewer missing ingredients, then catalog order.
+    std::vector<Ranked> rank(std::size_t maxMissing = 1, std::size_t limit = 10) const;
+};
+
+#endif
@@ -1,13 +1,13 @@
 #include "Fridge.h"
 #include <vector>
 #include <iostream>
-#include <ctime>
-#include <sstream>
-#include <iomanip>
+#include <utility>
+#include "CivilDate.h"
 #include "Storage.h"
 #include "Ingredient.h"
 
 
+Fridge::Fridge() : Storage(IngredientLocation::Fridge) {}
 
 // void Fridge::addIngredient(const Ingredient& ingredient) {
 //    Storage::addIngredient(ingredient);
@@ -48,31 +48,45 @@ void Fridge::addIngredient(const Ingredient& ingredient) {
     std::cout << ingredient.getName() << " added to Fridge.\n";
 }
 
+void Fridge::addIngredient(Ingredient&& ingredient) {
+    std::cout << ingredient.getName() << " added to Fridge.\n";
+    Storage::addIngredient(std::move(ingredient));
+}
 
-void Fridge::expiringSoon() const {
-    time_t now= time(0);
-    tm *ltm= localtime(&now);
+void Fridge::addIngredients(const Ingredient* items, std::size_t count) {
+    Storage::addIngredients(items, count);
+    if (count == 0) {
+        return;
+    }
+    std::cout << count << (count == 1 ? " ingredient" : " ingredients") << " added to Fridge.\n";
+}
 
 
-    for (const auto& ingredient : ingredients) {
-        if (!ingredient.getExpirationDate().empty()) {
-            tm exp= {};
-            std::istringstream ss(ingredient.getExpirationDate());
-            ss >> std::get_time(&exp, "%Y-%m-%d");
+bool Fridge::daysUntilExpiry(const Ingredient& ingredient, int& days) {
+    if (ingredient.getExpiryDay() == kNoDate) {
+        return false;
+    }
+    days = ingredient.getExpiryDay() - today();
+    return true;
+}
 
 
-            if (ss.fail()) {
-                std::cerr << "Failed to parse date for ingredients: " << ingredient.getName() << " \n";
-                continue;
-            }
+std::vector<Ingredient> Fridge::getExpiringSoon(int days) const {
+    std::vector<Ingredient> expiring;
 
 
-            time_t exp_time = mktime(&exp);
+    for (const auto& ingredient : ingredients) {
+        int left;
+        if (daysUntilExpiry(ingredient, left) && left <= days) {
+            expiring.push_back(ingredient);
+        }
+    }
+    return expiring;
+}
 
 
-            if (difftime(exp_time, now) <= 5*24*60*60) {
-                std::cout << ingredient.getName() << " is expiring in less than 5 days.\n";
-            }
-        }
+void Fridge::expiringSoon() const {
+    for (const auto& ingredient : getExpiringSoon(5)) {
+        std::cout << ingredient.getName() << " is expiring in less than 5 days.\n";
     }
-}
\ No newline at end of file
+}
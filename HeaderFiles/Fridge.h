@@ -3,13 +3,26 @@
 
 #include <iostream>
 #include <ctime>
+#include <vector>
 #include "Storage.h"
 #include "Ingredient.h"
 
 class Fridge : public Storage {
 public:
+    Fridge();
+
     void addIngredient(const Ingredient& ingredient) override;
+    void addIngredient(Ingredient&& ingredient) override;
+    // Prints one line for the whole batch.
+    void addIngredients(const Ingredient* items, std::size_t count) override;
+    using Storage::addIngredients;
+
+    // Whole days from now until the ingredient expires: 0 for today, negative once past.
+    // Returns false if the ingredient has no expiration date.
+    static bool daysUntilExpiry(const Ingredient& ingredient, int& days);
 
+    // Ingredients whose expiration date is at most `days` days away (or already past).
+    std::vector<Ingredient> getExpiringSoon(int days = 5) const;
     void expiringSoon() const;
 };
 
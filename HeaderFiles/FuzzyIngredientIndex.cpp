@@ -0,0 +1,151 @@
+#include "FuzzyIngredientIndex.h"
+#include <algorithm>
+
+FuzzyIngredientIndex::FuzzyIngredientIndex() : aliases(IngredientAliases::current()) {}
+
+FuzzyIngredientIndex::FuzzyIngredientIndex(const RecipeCatalog& catalog) : aliases(catalog.getAliasTable()) {
+    entries.reserve(catalog.ingredientCount());
+    byKey.reserve(catalog.ingredientCount());
+    for (IngredientId id = 0; id < catalog.ingredientCount(); ++id) {
+        add(catalog.getIngredientName(id), static_cast<std::uint32_t>(catalog.getRecipesUsing(id).size()));
+    }
+}
+
+// Linear probing; the table is kept at most half full.
+std::size_t FuzzyIngredientIndex::slotFor(std::uint64_t hash) const {
+    std::size_t mask = slots.size() - 1;
+    std::size_t slot = static_cast<std::size_t>(hash ^ (hash >> 32)) & mask;
+    while (slots[slot].head != kNone && slots[slot].hash != hash) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void FuzzyIngredientIndex::file(std::uint64_t hash, std::uint32_t entry) {
+    if ((usedSlots + 1) * 2 > slots.size()) {
+        std::vector<Slot> old(std::max<std::size_t>(slots.size() * 2, 64), Slot{ 0, kNone });
+        old.swap(slots);
+        for (const Slot& slot : old) {
+            if (slot.head != kNone) {
+                slots[slotFor(slot.hash)] = slot;
+            }
+        }
+    }
+    Slot& slot = slots[slotFor(hash)];
+    if (slot.head == kNone) {
+        slot.hash = hash;
+        ++usedSlots;
+    }
+    links.push_back(Link{ entry, slot.head });
+    slot.head = static_cast<std::uint32_t>(links.size() - 1);
+}
+
+void FuzzyIngredientIndex::add(const std::string& name, std::uint32_t uses) {
+    std::string key = IngredientAliases::wordForm(name);
+    if (key.empty()) {
+        return;
+    }
+    auto known = byKey.find(key);
+    if (known != byKey.end()) {
+        entries[known->second].uses += uses;
+        return;
+    }
+
+    std::uint32_t index = static_cast<std::uint32_t>(entries.size());
+    std::string display = name;
+    std::transform(display.begin(), display.end(), display.begin(), ::tolower);
+    thread_local std::vector<std::uint64_t> hashes;
+    deletionHashes(key, kIndexedDistance, hashes);
+    for (std::uint64_t hash : hashes) {
+        file(hash, index);
+    }
+    entries.push_back(Entry{ key, std::move(display), uses });
+    byKey.emplace(std::move(key), index);
+}
+
+bool FuzzyIngredientIndex::contains(const std::string& name) const {
+    return byKey.count(IngredientAliases::wordForm(name)) != 0;
+}
+
+std::size_t FuzzyIngredientIndex::size() const {
+    return entries.size();
+}
+
+void FuzzyIngredientIndex::search(const std::string& key, std::uint32_t maxDistance, std::vector<Match>& found) const {
+    EditDistancePattern pattern(key);
+    if (maxDistance > kIndexedDistance) {
+        for (const auto& entry : entries) {
+            std::uint32_t distance = pattern.distance(entry.key);
+            if (distance <= maxDistance) {
+                found.push_back(Match{ entry.name, distance, entry.uses });
+            }
+        }
+        return;
+    }
+    if (slots.empty()) {
+        return;
+    }
+
+    // Only names sharing a deletion with the query can be within maxDistance edits.
+    thread_local std::vector<std::uint64_t> hashes;
+    thread_local std::vector<std::uint32_t> candidates;
+    deletionHashes(key, maxDistance, hashes);
+    candidates.clear();
+    for (std::uint64_t hash : hashes) {
+        const Slot& slot = slots[slotFor(hash)];
+        for (std::uint32_t link = slot.head; link != kNone; link = links[link].next) {
+            candidates.push_back(links[link].entry);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    for (std::uint32_t candidate : candidates) {
+        const Entry& entry = entries[candidate];
+        std::size_t gap = entry.key.size() > key.size() ? entry.key.size() - key.size() : key.size() - entry.key.size();
+        if (gap > maxDistance) {
+            continue;
+        }
+        std::uint32_t distance = pattern.distance(entry.key);
+        if (distance <= maxDistance) {
+            found.push_back(Match{ entry.name, distance, entry.uses });
+        }
+    }
+}
+
+std::vector<FuzzyIngredientIndex::Match> FuzzyIngredientIndex::suggest(const std::string& name, std::uint32_t maxDistance, std::size_t limit) const {
+    std::vector<Match> found;
+    search(IngredientAliases::wordForm(name), maxDistance, found);
+    std::sort(found.begin(), found.end(), [](const Match& a, const Match& b) {
+        if (a.distance != b.distance) {
+            return a.distance < b.distance;
+        }
+        if (a.uses != b.uses) {
+            return a.uses > b.uses;
+        }
+        return a.name < b.name;
+    });
+    if (found.size() > limit) {
+        found.resize(limit);
+    }
+    return found;
+}
+
+std::string FuzzyIngredientIndex::correction(const std::string& name) const {
+    std::string key = IngredientAliases::wordForm(name);
+    // Canonical names are already in word form.
+    if (key.size() < 4 || byKey.count(key) != 0 || byKey.count(aliases->canonical(name)) != 0) {
+        return std::string();
+    }
+    std::vector<Match> found;
+    search(key, key.size() < 6 ? 1 : 2, found);
+    if (found.empty()) {
+        return std::string();
+    }
+    auto best = std::min_element(found.begin(), found.end(), [](const Match& a, const Match& b) { return a.distance < b.distance; });
+    std::size_t tied = std::count_if(found.begin(), found.end(), [&](const Match& match) { return match.distance == best->distance; });
+    return tied == 1 ? best->name : std::string();
+}
+
+std::uint32_t FuzzyIngredientIndex::editDistance(const std::string& a, const std::string& b) {
+    return EditDistancePattern(a).distance(b);
+}
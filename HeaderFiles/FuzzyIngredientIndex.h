@@ -0,0 +1,89 @@
+#ifndef FUZZYINGREDIENTINDEX_H
+#define FUZZYINGREDIENTINDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "EditDistance.h"
+#include "IngredientAliases.h"
+#include "RecipeCatalog.h"
+
+// Finds known ingredient names close to a misspelled one ("tomatoe" -> "tomato"), so typos
+// do not turn into items that never match a recipe.
+//
+// Names are compared in IngredientAliases::wordForm, lowercase and singular but with no
+// aliases replaced, so a typo of "cheddar" is still close to it. Lookups use a deletion
+// dictionary (as in SymSpell): every name is filed under each string left after deleting up
+// to two of its characters. Two names within two edits always share such a string, so a
+// lookup only generates the deletions of the query and checks the names filed under them,
+// instead of comparing against the whole vocabulary. Candidates are then checked with the
+// bit-parallel Myers / Hyyrö edit distance, one pass over the name for words of up to 64
+// characters.
+class FuzzyIngredientIndex {
+public:
+    struct Match {
+        std::string name;
+        std::uint32_t distance;
+        std::uint32_t uses;   // recipes using the ingredient
+    };
+
+private:
+    struct Entry {
+        std::string key;    // word form, the one compared
+        std::string name;   // as first added, for display
+        std::uint32_t uses;
+    };
+    // Open-addressing table from the hash of a deletion to the head of its list of entries.
+    // Hash collisions only add candidates, which the distance check then drops.
+    struct Slot {
+        std::uint64_t hash;
+        std::uint32_t head;   // kNone when the slot is empty
+    };
+    struct Link {
+        std::uint32_t entry;
+        std::uint32_t next;
+    };
+
+    static constexpr std::uint32_t kNone = 0xffffffff;
+
+    std::shared_ptr<const IngredientAliases> aliases;   // the catalog's, or the table current when built
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, std::uint32_t> byKey;
+    std::vector<Slot> slots;
+    std::size_t usedSlots = 0;
+    std::vector<Link> links;
+
+    std::size_t slotFor(std::uint64_t hash) const;
+    void file(std::uint64_t hash, std::uint32_t entry);
+
+    void search(const std::string& key, std::uint32_t maxDistance, std::vector<Match>& found) const;
+
+public:
+    FuzzyIngredientIndex();
+    // The catalog's ingredient vocabulary, with how many recipes use each name, compared
+    // under the catalog's alias table.
+    explicit FuzzyIngredientIndex(const RecipeCatalog& catalog);
+
+    // Adds a name, or raises the use count of one already known in the same word form.
+    void add(const std::string& name, std::uint32_t uses = 0);
+    bool contains(const std::string& name) const;
+    std::size_t size() const;
+
+    // The most edits the deletion dictionary covers; suggest() scans every name beyond it.
+    static constexpr std::uint32_t kIndexedDistance = 2;
+
+    // Known names within maxDistance edits, closest first, then most used, then by name.
+    std::vector<Match> suggest(const std::string& name, std::uint32_t maxDistance = 2, std::size_t limit = 5) const;
+    // The known name a typo most likely meant: the only closest match within 1 edit for
+    // names of 4-5 characters and 2 edits for longer ones. Empty if the name is already
+    // known, directly or through an alias ("ground beef" when "beef" is known), too short to
+    // correct, or no single name is closest.
+    std::string correction(const std::string& name) const;
+
+    // Levenshtein distance (insertions, deletions and substitutions all cost 1).
+    static std::uint32_t editDistance(const std::string& a, const std::string& b);
+};
+
+#endif
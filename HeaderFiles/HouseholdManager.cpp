@@ -0,0 +1,227 @@
+#include "HouseholdManager.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <iterator>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include "PersistenceFormat.h"
+#include "RecipeManager.h"
+
+namespace fs = std::filesystem;
+
+Household::Household(std::string householdId) : id(std::move(householdId)), dirty(false) {}
+
+const std::string& Household::getId() const {
+    return id;
+}
+
+const Fridge& Household::getFridge() const {
+    return fridge;
+}
+
+const Pantry& Household::getPantry() const {
+    return pantry;
+}
+
+std::vector<Ingredient> Household::allIngredients() const {
+    std::vector<Ingredient> all;
+    all.reserve(fridge.getIngredients().size() + pantry.getIngredients().size());
+    all.insert(all.end(), fridge.getIngredients().begin(), fridge.getIngredients().end());
+    all.insert(all.end(), pantry.getIngredients().begin(), pantry.getIngredients().end());
+    return all;
+}
+
+void Household::addToFridge(Ingredient ingredient) {
+    fridge.Storage::addIngredient(std::move(ingredient));
+    dirty = true;
+}
+
+void Household::addToPantry(Ingredient ingredient) {
+    pantry.Storage::addIngredient(std::move(ingredient));
+    dirty = true;
+}
+
+HouseholdManager::HouseholdManager(std::shared_ptr<const RecipeCatalog> sharedCatalog, std::string root, std::size_t capacity)
+    : catalog(std::move(sharedCatalog)), rootDirectory(std::move(root)),
+      capacityPerShard(std::max<std::size_t>(1, (capacity + kShardCount - 1) / kShardCount)) {
+    for (std::size_t i = 0; i < kShardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+HouseholdManager::~HouseholdManager() {
+    saveAll();
+}
+
+HouseholdManager::Shard& HouseholdManager::shardFor(const std::string& tenantId) {
+    return *shards[std::hash<std::string>{}(tenantId) % kShardCount];
+}
+
+std::string HouseholdManager::storagePath(const std::string& tenantId) const {
+    return (fs::path(rootDirectory) / tenantId / "storage.json").string();
+}
+
+std::string HouseholdManager::historyPath(const std::string& tenantId) const {
+    return (fs::path(rootDirectory) / tenantId / "history.json").string();
+}
+
+// A tenant with no storage file yet simply starts out empty.
+void HouseholdManager::load(Household& household) const {
+    try {
+        json j;
+        if (!readDocument(storagePath(household.id), j) || !j.is_object()) {
+            return;
+        }
+        if (j.contains("Fridge")) {
+            household.fridge.fromJSON(std::move(j["Fridge"]));
+        }
+        if (j.contains("Pantry")) {
+            household.pantry.fromJSON(std::move(j["Pantry"]));
+        }
+    } catch (json::exception& e) {
+        std::cerr << "Error parsing storage for household " << household.id << ": " << e.what() << "\n";
+    }
+}
+
+void HouseholdManager::save(Household& household) const {
+    if (!household.dirty) {
+        return;
+    }
+
+    json j;
+    j["Fridge"] = household.fridge.toJSON();
+    j["Pantry"] = household.pantry.toJSON();
+
+    std::error_code ec;
+    fs::create_directories(fs::path(rootDirectory) / household.id, ec);
+    if (writeDocument(storagePath(household.id), j, PersistenceFormat::Json)) {
+        household.dirty = false;
+    } else {
+        std::cerr << "Unable to save storage for household " << household.id << "\n";
+    }
+}
+
+std::shared_ptr<Household> HouseholdManager::acquire(const std::string& tenantId) {
+    if (tenantId.empty() || tenantId == "." || tenantId == ".." || tenantId.find_first_of("/\\") != std::string::npos) {
+        std::cerr << "Invalid household id: " << tenantId << "\n";
+        return nullptr;
+    }
+
+    Shard& shard = shardFor(tenantId);
+    std::shared_ptr<Household> household;
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto found = shard.index.find(tenantId);
+        if (found != shard.index.end()) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+            return *found->second;
+        }
+
+        // Loading under the shard lock means two threads asking for the same new tenant
+        // cannot both load it; other shards are unaffected.
+        household = std::make_shared<Household>(tenantId);
+        load(*household);
+        shard.lru.push_front(household);
+        shard.index.emplace(tenantId, shard.lru.begin());
+
+        // Evict the least recently used household nobody else is holding, so changes made
+        // through an outstanding pointer are never lost. Pointers are only handed out under
+        // this lock, so a use count of one cannot be stale. It is saved before it leaves the
+        // index, so a later request for it reads the saved file.
+        if (shard.lru.size() > capacityPerShard) {
+            for (auto it = std::prev(shard.lru.end()); it != shard.lru.begin(); --it) {
+                if (it->use_count() == 1) {
+                    {
+                        std::lock_guard<std::mutex> guard((*it)->lock);
+                        save(**it);
+                    }
+                    if ((*it)->dirty) {
+                        continue;   // could not be saved; keep it rather than lose its changes
+                    }
+                    shard.index.erase((*it)->id);
+                    shard.lru.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+    return household;
+}
+
+std::vector<std::string> HouseholdManager::findMakeableRecipes(const std::string& tenantId, const std::string& category) {
+    std::vector<std::string> names;
+    std::shared_ptr<Household> household = acquire(tenantId);
+    if (!household) {
+        return names;
+    }
+
+    std::vector<Ingredient> ingredients;
+    {
+        std::lock_guard<std::mutex> guard(household->lock);
+        ingredients = household->allIngredients();
+    }
+    for (const Recipe* recipe : catalog->findMakeable(ingredients, category)) {
+        names.push_back(recipe->getRecipeName());
+    }
+    return names;
+}
+
+std::vector<std::vector<std::string>> HouseholdManager::findMakeableRecipes(const std::vector<std::string>& tenantIds,
+                                                                           const std::string& category, unsigned threadCount) {
+    std::vector<std::vector<std::string>> results(tenantIds.size());
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, tenantIds.size()));
+
+    std::atomic<std::size_t> nextTenant{0};
+    auto worker = [&]() {
+        for (std::size_t i = nextTenant++; i < tenantIds.size(); i = nextTenant++) {
+            results[i] = findMakeableRecipes(tenantIds[i], category);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
+
+void HouseholdManager::recordCooked(const std::string& tenantId, const std::string& recipeName) {
+    std::shared_ptr<Household> household = acquire(tenantId);
+    if (!household) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(household->lock);
+    std::error_code ec;
+    fs::create_directories(fs::path(rootDirectory) / tenantId, ec);
+    appendRecipeHistory(historyPath(tenantId), recipeName, catalog->idOf(recipeName));
+}
+
+void HouseholdManager::saveAll() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> shardGuard(shard->lock);
+        for (auto& household : shard->lru) {
+            std::lock_guard<std::mutex> guard(household->lock);
+            save(*household);
+        }
+    }
+}
+
+std::size_t HouseholdManager::residentCount() {
+    std::size_t count = 0;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        count += shard->lru.size();
+    }
+    return count;
+}
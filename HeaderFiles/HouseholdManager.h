@@ -0,0 +1,83 @@
+#ifndef HOUSEHOLDMANAGER_H
+#define HOUSEHOLDMANAGER_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Fridge.h"
+#include "Pantry.h"
+#include "RecipeCatalog.h"
+
+// The per-tenant state: just the two storages. Its files live in <root>/<id>/storage.json
+// and <root>/<id>/history.json; history is appended on disk and never held in memory.
+class Household {
+private:
+    std::string id;
+    Fridge fridge;
+    Pantry pantry;
+    bool dirty;
+
+    friend class HouseholdManager;
+
+public:
+    // Held while reading or changing the household.
+    std::mutex lock;
+
+    explicit Household(std::string id);
+
+    const std::string& getId() const;
+    const Fridge& getFridge() const;
+    const Pantry& getPantry() const;
+    std::vector<Ingredient> allIngredients() const;
+
+    void addToFridge(Ingredient ingredient);
+    void addToPantry(Ingredient ingredient);
+};
+
+// Serves many households against one shared, read-only recipe catalog.
+// Households are loaded on first use and the least recently used ones are saved and
+// dropped once a shard holds more than its share of the capacity. Tenants are spread
+// over independently locked shards, so there is no lock shared by every request.
+class HouseholdManager {
+private:
+    struct Shard {
+        std::mutex lock;
+        std::list<std::shared_ptr<Household>> lru; // most recently used at the front
+        std::unordered_map<std::string, std::list<std::shared_ptr<Household>>::iterator> index;
+    };
+
+    static const std::size_t kShardCount = 16;
+
+    std::shared_ptr<const RecipeCatalog> catalog;
+    std::string rootDirectory;
+    std::size_t capacityPerShard;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard& shardFor(const std::string& tenantId);
+    std::string storagePath(const std::string& tenantId) const;
+    std::string historyPath(const std::string& tenantId) const;
+    void load(Household& household) const;
+    void save(Household& household) const;
+
+public:
+    HouseholdManager(std::shared_ptr<const RecipeCatalog> catalog, std::string rootDirectory, std::size_t capacity = 1024);
+    ~HouseholdManager();
+
+    // Returns the household, loading it if it is not resident. Returns nullptr for ids
+    // that are not a plain directory name.
+    std::shared_ptr<Household> acquire(const std::string& tenantId);
+
+    std::vector<std::string> findMakeableRecipes(const std::string& tenantId, const std::string& category = "");
+    // Runs findMakeableRecipes for every tenant on a pool of threads (0 = one per core).
+    std::vector<std::vector<std::string>> findMakeableRecipes(const std::vector<std::string>& tenantIds,
+                                                              const std::string& category = "", unsigned threadCount = 0);
+
+    void recordCooked(const std::string& tenantId, const std::string& recipeName);
+    void saveAll();
+    std::size_t residentCount();
+};
+
+#endif
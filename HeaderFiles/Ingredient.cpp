@@ -1,23 +1,208 @@
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include "../json.hpp"
 using json = nlohmann::json;  
 #include "Ingredient.h"
+#include "IngredientAliases.h"
 
-    Ingredient::Ingredient() {}
-    Ingredient::Ingredient(std::string n, int q, std::string exp = "") : name(n), quantity(q), expirationDate(exp) {}
+static_assert(sizeof(Ingredient) == 16, "Ingredient should stay packed");
 
-    std::string Ingredient::getName() const { return name; }
-    int Ingredient::getQuantity() const { return quantity; }
-    std::string Ingredient::getExpirationDate() const { return expirationDate; }
+// Names live in fixed-size chunks that are never moved or freed, so nameOf can read them
+// without a lock: an id only reaches a reader after the name behind it was written.
+static const std::size_t kChunkBits = 10;
+static const std::size_t kChunkSize = std::size_t(1) << kChunkBits;
+static const std::size_t kMaxChunks = 4096;
+// Name ids share a word with the location.
+static_assert(kMaxChunks * kChunkSize <= (std::size_t(1) << 30), "name ids must fit in 30 bits");
 
-    void Ingredient::setQuantity(int q) { quantity = q; }
+struct NameEntry {
+    std::string name;
+    std::uint32_t stockKey;   // see Ingredient::stockKeyOf
+};
 
-    void Ingredient::setExpirationDate(const std::string& expDate) {expirationDate = expDate;}
+struct NameTable {
+    std::shared_mutex lock;
+    std::unordered_map<std::string_view, std::uint32_t> ids;   // views into the chunks
+    std::atomic<NameEntry*> chunks[kMaxChunks];
+    std::uint32_t count = 0;
+
+    NameTable() {
+        for (auto& chunk : chunks) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+        add(std::string());   // id 0 is the empty name of a default-constructed ingredient
+    }
+
+    // Caller holds the lock exclusively. The stock key is worked out here, once per name,
+    // so that storages can merge items without allocating; a new word form is added too.
+    std::uint32_t add(std::string&& name) {
+        std::uint32_t id = store(std::move(name));
+        NameEntry& entry = entryAt(id);
+        std::string form = IngredientAliases::wordForm(entry.name);
+        if (form != entry.name) {
+            auto found = ids.find(std::string_view(form));
+            entry.stockKey = found != ids.end() ? found->second : store(std::move(form));
+        }
+        return id;
+    }
+
+    // Adds the name as its own stock key.
+    std::uint32_t store(std::string&& name) {
+        std::uint32_t id = count;
+        std::size_t chunk = id >> kChunkBits;
+        if (chunk >= kMaxChunks) {
+            throw std::length_error("too many distinct ingredient names");
+        }
+        NameEntry* slots = chunks[chunk].load(std::memory_order_relaxed);
+        if (slots == nullptr) {
+            slots = new NameEntry[kChunkSize];
+            chunks[chunk].store(slots, std::memory_order_release);
+        }
+        NameEntry& slot = slots[id & (kChunkSize - 1)];
+        slot.name = std::move(name);
+        slot.stockKey = id;
+        ids.emplace(std::string_view(slot.name), id);
+        ++count;
+        return id;
+    }
+
+    NameEntry& entryAt(std::uint32_t id) const {
+        return chunks[id >> kChunkBits].load(std::memory_order_acquire)[id & (kChunkSize - 1)];
+    }
+};
+
+// Never destroyed, so names stay readable while other statics are torn down.
+static NameTable& names() {
+    static NameTable* table = new NameTable();
+    return *table;
+}
+
+template <typename Name>
+static std::uint32_t intern(Name&& name) {
+    NameTable& table = names();
+    {
+        std::shared_lock<std::shared_mutex> guard(table.lock);
+        auto found = table.ids.find(std::string_view(name));
+        if (found != table.ids.end()) {
+            return found->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> guard(table.lock);
+    auto found = table.ids.find(std::string_view(name));
+    if (found != table.ids.end()) {
+        return found->second;
+    }
+    return table.add(std::string(std::forward<Name>(name)));
+}
+
+// 2^63 thousandths, the first value an int64 amount cannot hold.
+static const double kAmountLimit = 9223372036854775808.0;
+
+static std::int64_t toAmount(double units) {
+    double scaled = std::round(units * Ingredient::kAmountScale);
+    if (std::isnan(scaled)) {
+        return 0;
+    }
+    if (scaled >= kAmountLimit) {
+        return INT64_MAX;
+    }
+    return scaled < -kAmountLimit ? INT64_MIN : static_cast<std::int64_t>(scaled);
+}
+
+// A date that cannot be read is reported, since it is dropped on the next save.
+static std::int32_t expiryDayOf(const std::string& expDate, const std::string& name) {
+    int day;
+    if (parseDate(expDate, day)) {
+        return day;
+    }
+    if (!expDate.empty()) {
+        std::cerr << "Failed to parse expiration date \"" << expDate << "\" for " << name << "; it is kept without a date\n";
+    }
+    return kNoDate;
+}
+
+    Ingredient::Ingredient() : nameId(0), location(0), expiryDay(kNoDate), amount(0) {}
+    Ingredient::Ingredient(std::string n, int q, std::string exp = "") : nameId(internName(std::move(n))), location(0), expiryDay(expiryDayOf(exp, nameOf(nameId))), amount(toAmount(q)) {}
+
+    std::uint32_t Ingredient::internName(const std::string& name) { return intern(name); }
+    std::uint32_t Ingredient::internName(std::string&& name) { return intern(std::move(name)); }
+
+    const std::string& Ingredient::nameOf(std::uint32_t id) {
+        return names().entryAt(id).name;
+    }
+
+    std::uint32_t Ingredient::stockKeyOf(std::uint32_t id) { return names().entryAt(id).stockKey; }
+
+    const std::string& Ingredient::getName() const { return nameOf(nameId); }
+    std::uint32_t Ingredient::getNameId() const { return nameId; }
+    std::uint32_t Ingredient::getStockKey() const { return stockKeyOf(nameId); }
+    int Ingredient::getQuantity() const {
+        std::int64_t units = amount / kAmountScale - (amount % kAmountScale < 0 ? 1 : 0);
+        return static_cast<int>(std::max<std::int64_t>(INT_MIN, std::min<std::int64_t>(INT_MAX, units)));
+    }
+    double Ingredient::getAmount() const { return static_cast<double>(amount) / kAmountScale; }
+    std::string Ingredient::getExpirationDate() const { return expiryDay == kNoDate ? std::string() : formatDate(expiryDay); }
+    int Ingredient::getExpiryDay() const { return expiryDay; }
+    IngredientLocation Ingredient::getLocation() const { return static_cast<IngredientLocation>(location); }
+
+    void Ingredient::setQuantity(int q) { amount = toAmount(q); }
+    void Ingredient::setAmount(double a) { amount = toAmount(a); }
+
+    void Ingredient::setExpirationDate(const std::string& expDate) {expiryDay = expiryDayOf(expDate, getName());}
+
+    void Ingredient::setExpiryDay(int day) { expiryDay = day; }
+    void Ingredient::setLocation(IngredientLocation where) { location = static_cast<std::uint32_t>(where); }
 
     json Ingredient::toJSON() const {
-        return { {"name", name}, {"quantity", quantity}, {"expirationDate", expirationDate} };
+        json quantity = amount % kAmountScale == 0 ? json(amount / kAmountScale) : json(getAmount());
+        return { {"name", getName()}, {"quantity", quantity}, {"expirationDate", getExpirationDate()} };
+    }
+
+    static void readQuantity(const json& j, Ingredient& ingredient) {
+        const json& quantity = j.at("quantity");
+        if (quantity.is_number_integer()) {
+            ingredient.setAmount(static_cast<double>(quantity.get<std::int64_t>()));
+        } else {
+            ingredient.setAmount(quantity.get<double>());
+        }
+    }
+
+    Ingredient Ingredient::fromParts(std::uint32_t nameId, double amount, int expiryDay) {
+        Ingredient ingredient;
+        ingredient.nameId = nameId;
+        ingredient.amount = toAmount(amount);
+        ingredient.expiryDay = expiryDay;
+        return ingredient;
     }
 
     Ingredient Ingredient::fromJSON(const json& j) {
-        return Ingredient(j["name"], j["quantity"], j.value("expirationDate", ""));
-    }
\ No newline at end of file
+        Ingredient ingredient;
+        ingredient.nameId = internName(j.at("name").get_ref<const std::string&>());
+        readQuantity(j, ingredient);
+        auto it = j.find("expirationDate");
+        if (it != j.end() && it->is_string()) {
+            ingredient.setExpirationDate(it->get_ref<const std::string&>());
+        }
+        return ingredient;
+    }
+
+    // A name seen for the first time is moved out of the parsed document instead of copied.
+    Ingredient Ingredient::fromJSON(json&& j) {
+        Ingredient ingredient;
+        ingredient.nameId = internName(std::move(j.at("name").get_ref<std::string&>()));
+        readQuantity(j, ingredient);
+        auto it = j.find("expirationDate");
+        if (it != j.end() && it->is_string()) {
+            ingredient.setExpirationDate(it->get_ref<const std::string&>());
+        }
+        return ingredient;
+    }
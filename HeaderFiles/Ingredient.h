@@ -1,28 +1,68 @@
 #ifndef INGREDIENT_H
 #define INGREDIENT_H
 
+#include <cstdint>
 #include <string>
 #include "../json.hpp"
+#include "CivilDate.h"
 
 using json = nlohmann::json;
 
+// Where an item is kept; set by the storage it is added to.
+enum class IngredientLocation : std::uint8_t { None, Fridge, Pantry };
+
+// One stored item, packed into 16 bytes so large inventories stay in flat arrays. The name
+// is interned (each distinct name is stored once for the life of the program) and shares a
+// word with the location, the quantity is 64-bit fixed point in thousandths of a unit, and
+// the expiration date is a day number. Quantities range over about ±9.2 * 10^15 units and
+// are exact to a thousandth up to about 9 * 10^12 units; every int quantity fits exactly.
 class Ingredient {
 private:
-    std::string name;
-    int quantity;
-    std::string expirationDate;
+    std::uint32_t nameId : 30;
+    std::uint32_t location : 2;  // an IngredientLocation
+    std::int32_t expiryDay;      // CivilDate day number, kNoDate if there is none
+    std::int64_t amount;         // thousandths of a unit
+
 public:
+    static const std::int64_t kAmountScale = 1000;
+
     Ingredient();
+    // An expiration date that is empty or cannot be read as YYYY-MM-DD is stored as none;
+    // one that cannot be read is reported on std::cerr.
     Ingredient(std::string name, int quantity, std::string exp);
 
-    std::string getName() const;
+    // Interned names: the id for a name (added if new) and the name for an id. References
+    // returned by nameOf stay valid for the rest of the program.
+    static std::uint32_t internName(const std::string& name);
+    static std::uint32_t internName(std::string&& name);
+    static const std::string& nameOf(std::uint32_t id);
+    // The id of the name's word form (see IngredientAliases::wordForm), which storages merge
+    // items by: "Milk" and "milk", or "eggs" and "egg", share one key.
+    static std::uint32_t stockKeyOf(std::uint32_t id);
+
+    const std::string& getName() const;
+    std::uint32_t getNameId() const;
+    std::uint32_t getStockKey() const;
+    // Whole units, rounded down and capped at INT_MAX; getAmount keeps the fraction.
     int getQuantity() const;
+    double getAmount() const;
+    // "YYYY-MM-DD", or empty if there is no date. Built on each call.
     std::string getExpirationDate() const;
+    // The expiration date as a CivilDate day number, or kNoDate.
+    int getExpiryDay() const;
+    IngredientLocation getLocation() const;
+
     void setQuantity(int q);
+    void setAmount(double a);
     void setExpirationDate(const std::string& expDate);
+    void setExpiryDay(int day);
+    void setLocation(IngredientLocation where);
 
     json toJSON() const;
+    // For loaders that have already interned the name and parsed the date.
+    static Ingredient fromParts(std::uint32_t nameId, double amount, int expiryDay);
     static Ingredient fromJSON(const json& j);
+    static Ingredient fromJSON(json&& j);
 };
 
 #endif
@@ -0,0 +1,284 @@
+#include "IngredientAliases.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+// {canonical, alias}. Kept to names that mean the same thing when shopping; real
+// substitutions (margarine for butter) belong in the substitution graph instead.
+static const char* const kBuiltInAliases[][2] = {
+    { "cheese", "cheddar cheese" }, { "cheese", "cheddar" },
+    { "green onion", "scallion" }, { "green onion", "spring onion" },
+    { "zucchini", "courgette" }, { "eggplant", "aubergine" },
+    { "cilantro", "coriander leaf" }, { "cilantro", "fresh coriander" },
+    { "chickpea", "garbanzo bean" }, { "bell pepper", "capsicum" }, { "bell pepper", "sweet pepper" },
+    { "flour", "all-purpose flour" }, { "flour", "all purpose flour" }, { "flour", "plain flour" },
+    { "heavy cream", "double cream" }, { "heavy cream", "whipping cream" },
+    { "shrimp", "prawn" }, { "arugula", "rocket" }, { "cornstarch", "corn starch" }, { "cornstarch", "cornflour" },
+    { "powdered sugar", "icing sugar" }, { "powdered sugar", "confectioners sugar" },
+    { "baking soda", "bicarbonate of soda" }, { "rice", "cooked rice" }, { "rice", "white rice" },
+    // Descriptions that do not change what has to be bought.
+    { "", "fresh" }, { "", "large" }, { "", "medium" }, { "", "small" }, { "", "ripe" },
+    { "", "chopped" }, { "", "diced" }, { "", "minced" }, { "", "sliced" }, { "", "grated" }, { "", "shredded" },
+};
+
+static bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';' || c == '(' || c == ')';
+}
+
+static bool endsWith(const char* word, std::size_t length, const char* suffix) {
+    std::size_t n = std::strlen(suffix);
+    return length >= n && std::memcmp(word + length - n, suffix, n) == 0;
+}
+
+// Appends the singular of one lowercase word. Plurals and their singulars only need to end
+// up the same, not to be correct English: "cookies" and "cookie" both become "cooky".
+static void appendSingular(std::string& out, const char* word, std::size_t length) {
+    static const char* const irregular[][2] = { { "leaves", "leaf" }, { "loaves", "loaf" }, { "halves", "half" }, { "knives", "knife" } };
+    if (endsWith(word, length, "ves")) {
+        for (const auto& pair : irregular) {
+            if (length == std::strlen(pair[0]) && std::memcmp(word, pair[0], length) == 0) {
+                out += pair[1];
+                return;
+            }
+        }
+    }
+    if (length > 4 && endsWith(word, length, "ies")) {
+        out.append(word, length - 3);
+        out += 'y';
+    } else if (length > 4 && endsWith(word, length, "ie")) {
+        out.append(word, length - 2);
+        out += 'y';
+    } else if (length > 3 && (endsWith(word, length, "oes") || endsWith(word, length, "ches") || endsWith(word, length, "shes") ||
+                              endsWith(word, length, "sses") || endsWith(word, length, "xes") || endsWith(word, length, "zes"))) {
+        out.append(word, length - 2);
+    } else if (length > 3 && word[length - 1] == 's' && !endsWith(word, length, "ss") && !endsWith(word, length, "us") &&
+               !endsWith(word, length, "is")) {
+        out.append(word, length - 1);
+    } else {
+        out.append(word, length);
+    }
+}
+
+// " word word ... " with each word lowercased and singular; the outer spaces let terms match
+// whole words only.
+static void prepare(const char* text, std::size_t length, std::string& out) {
+    out.assign(1, ' ');
+    char word[64];
+    std::size_t wordLength = 0;
+    std::size_t i = 0;
+    while (i <= length) {
+        if (i == length || isSeparator(text[i])) {
+            if (wordLength > 0) {
+                appendSingular(out, word, wordLength);
+                out += ' ';
+                wordLength = 0;
+            }
+            ++i;
+            continue;
+        }
+        char c = text[i++];
+        c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        if (wordLength < sizeof(word)) {
+            word[wordLength++] = c;
+        } else {
+            // Absurdly long words are kept as they are.
+            out.append(word, wordLength);
+            wordLength = 0;
+            word[wordLength++] = c;
+        }
+    }
+}
+
+IngredientAliases::IngredientAliases() : IngredientAliases(json::object()) {}
+
+IngredientAliases::IngredientAliases(const json& dictionary) {
+    std::vector<std::pair<std::string, std::string>> aliases;
+    for (const auto& entry : kBuiltInAliases) {
+        aliases.emplace_back(entry[0], entry[1]);
+    }
+    if (dictionary.is_object()) {
+        for (auto it = dictionary.begin(); it != dictionary.end(); ++it) {
+            if (!it.value().is_array()) {
+                continue;
+            }
+            for (const auto& alias : it.value()) {
+                if (alias.is_string()) {
+                    aliases.emplace_back(it.key(), alias.get<std::string>());
+                }
+            }
+        }
+    }
+    compile(aliases);
+}
+
+IngredientAliases IngredientAliases::fromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return IngredientAliases();
+    }
+    json dictionary = json::parse(file, nullptr, false);
+    if (dictionary.is_discarded() || !dictionary.is_object()) {
+        std::cerr << "Unable to read ingredient aliases from " << path << "\n";
+        return IngredientAliases();
+    }
+    return IngredientAliases(dictionary);
+}
+
+void IngredientAliases::compile(const std::vector<std::pair<std::string, std::string>>& aliases) {
+    // Terms go through the same preparation as the names they will be matched against.
+    std::vector<std::string> patterns;
+    std::string prepared;
+    for (const auto& alias : aliases) {
+        prepare(alias.second.data(), alias.second.size(), prepared);
+        if (prepared.size() < 3) {
+            continue;   // nothing but spaces
+        }
+        patterns.push_back(prepared);
+        std::string canonicalName;
+        prepare(alias.first.data(), alias.first.size(), canonicalName);
+        canonicalName = canonicalName.size() > 2 ? canonicalName.substr(1, canonicalName.size() - 2) : std::string();
+        terms.push_back(Term{ static_cast<std::uint32_t>(prepared.size() - 2), canonicalName });
+    }
+
+    // Bytes that occur in no term all share class 0, which always leads back to the root.
+    std::memset(byteClass, 0, sizeof(byteClass));
+    classCount = 1;
+    for (const auto& pattern : patterns) {
+        for (unsigned char c : pattern) {
+            if (byteClass[c] == 0) {
+                byteClass[c] = static_cast<std::uint8_t>(classCount++);
+            }
+        }
+    }
+
+    transitions.assign(classCount, -1);
+    termAt.assign(1, -1);
+    for (std::size_t t = 0; t < patterns.size(); ++t) {
+        std::int32_t state = 0;
+        for (unsigned char c : patterns[t]) {
+            std::int32_t& next = transitions[state * classCount + byteClass[c]];
+            if (next < 0) {
+                next = static_cast<std::int32_t>(termAt.size());
+                termAt.push_back(-1);
+                transitions.resize(transitions.size() + classCount, -1);
+            }
+            state = transitions[state * classCount + byteClass[c]];
+        }
+        termAt[state] = static_cast<std::int32_t>(t);   // later entries (the user's) win
+    }
+
+    // Breadth-first: failure links, output links, and the missing transitions filled in so
+    // matching takes exactly one table lookup per byte.
+    std::size_t stateCount = termAt.size();
+    std::vector<std::int32_t> failure(stateCount, 0);
+    nextOutput.assign(stateCount, -1);
+    std::vector<std::int32_t> queue;
+    queue.reserve(stateCount);
+    for (std::uint32_t c = 0; c < classCount; ++c) {
+        std::int32_t& next = transitions[c];
+        if (next < 0) {
+            next = 0;
+        } else {
+            queue.push_back(next);
+        }
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        std::int32_t state = queue[head];
+        for (std::uint32_t c = 0; c < classCount; ++c) {
+            std::int32_t& next = transitions[state * classCount + c];
+            std::int32_t fallback = transitions[failure[state] * classCount + c];
+            if (next < 0) {
+                next = fallback;
+                continue;
+            }
+            failure[next] = fallback;
+            nextOutput[next] = termAt[fallback] >= 0 ? fallback : nextOutput[fallback];
+            queue.push_back(next);
+        }
+    }
+}
+
+void IngredientAliases::canonical(const char* text, std::size_t length, std::string& out) const {
+    struct Match {
+        std::size_t start;   // index of the space before the term
+        std::size_t end;     // index of the space after it
+        std::int32_t term;
+    };
+    thread_local std::string prepared;
+    thread_local std::vector<Match> matches;
+    prepare(text, length, prepared);
+    matches.clear();
+
+    std::int32_t state = 0;
+    for (std::size_t i = 0; i < prepared.size(); ++i) {
+        state = transitions[state * classCount + byteClass[static_cast<unsigned char>(prepared[i])]];
+        for (std::int32_t s = termAt[state] >= 0 ? state : nextOutput[state]; s >= 0; s = nextOutput[s]) {
+            std::int32_t term = termAt[s];
+            matches.push_back(Match{ i - terms[term].length - 1, i, term });
+        }
+    }
+
+    // Leftmost first, then longest; neighbouring terms may share the space between them.
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        return a.start != b.start ? a.start < b.start : a.end > b.end;
+    });
+    out.clear();
+    std::size_t copied = 1;
+    auto append = [&out](const char* piece, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (piece[i] != ' ' || (!out.empty() && out.back() != ' ')) {
+                out += piece[i];
+            }
+        }
+    };
+    for (const Match& match : matches) {
+        if (match.start + 1 < copied) {
+            continue;   // overlaps a term already replaced
+        }
+        append(prepared.data() + copied, match.start + 1 - copied);
+        const std::string& replacement = terms[match.term].canonical;
+        append(replacement.data(), replacement.size());
+        append(" ", 1);
+        copied = match.end;
+    }
+    if (copied < prepared.size()) {
+        append(prepared.data() + copied, prepared.size() - copied);
+    }
+    while (!out.empty() && out.back() == ' ') {
+        out.pop_back();
+    }
+    if (!out.empty() && out.front() == ' ') {
+        out.erase(0, 1);
+    }
+}
+
+std::string IngredientAliases::canonical(const std::string& name) const {
+    std::string out;
+    canonical(name.data(), name.size(), out);
+    return out;
+}
+
+std::string IngredientAliases::wordForm(const std::string& name) {
+    std::string prepared;
+    prepare(name.data(), name.size(), prepared);
+    return prepared.size() > 1 ? prepared.substr(1, prepared.size() - 2) : std::string();
+}
+
+std::size_t IngredientAliases::termCount() const {
+    return terms.size();
+}
+
+static std::shared_ptr<const IngredientAliases>& installedAliases() {
+    static std::shared_ptr<const IngredientAliases> aliases = std::make_shared<const IngredientAliases>();
+    return aliases;
+}
+
+std::shared_ptr<const IngredientAliases> IngredientAliases::current() {
+    return std::atomic_load(&installedAliases());
+}
+
+void IngredientAliases::install(std::shared_ptr<const IngredientAliases> aliases) {
+    std::atomic_store(&installedAliases(), std::move(aliases));
+}
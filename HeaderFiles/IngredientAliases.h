@@ -0,0 +1,59 @@
+#ifndef INGREDIENTALIASES_H
+#define INGREDIENTALIASES_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+// Turns the many ways of writing an ingredient into one key, so that "Eggs", "large egg"
+// and "egg" all match, and "cheddar cheese" in a recipe matches "cheese" in the fridge.
+//
+// A name is lowercased, its spacing is cleaned up and every word is made singular
+// ("tomatoes" -> "tomato"). Then known terms are replaced using one Aho-Corasick pass:
+// multi-word terms first, longest and leftmost wins, and a term may map to nothing (for
+// example "chopped"). The automaton is compiled once, and normalizing then does not
+// allocate beyond the returned string.
+class IngredientAliases {
+private:
+    struct Term {
+        std::uint32_t length;    // characters between the surrounding spaces
+        std::string canonical;   // already normalized; empty removes the term
+    };
+
+    std::uint8_t byteClass[256];          // 0 for bytes that appear in no term
+    std::uint32_t classCount = 1;
+    std::vector<std::int32_t> transitions;   // state * classCount + class -> state
+    std::vector<std::int32_t> termAt;        // term ending exactly at each state, or -1
+    std::vector<std::int32_t> nextOutput;    // nearest shorter suffix state with a term, or -1
+    std::vector<Term> terms;
+
+    void compile(const std::vector<std::pair<std::string, std::string>>& aliases);
+
+public:
+    // The built-in dictionary only.
+    IngredientAliases();
+    // The built-in dictionary plus `dictionary`, whose entries win on conflicts. The format
+    // is {"canonical name": ["alias", ...], ...}; "" as the canonical name removes words.
+    explicit IngredientAliases(const json& dictionary);
+    // Reads a dictionary file; a missing or unreadable file gives the built-ins alone.
+    static IngredientAliases fromFile(const std::string& path);
+
+    std::string canonical(const std::string& name) const;
+    void canonical(const char* text, std::size_t length, std::string& out) const;
+    // Only the first step: lowercase, single spaces and singular words, with no terms
+    // replaced ("Cheddar  Cheeses" -> "cheddar cheese").
+    static std::string wordForm(const std::string& name);
+    std::size_t termCount() const;
+
+    // The table used by catalogs and matchers that are not given one. Starts as the built-ins.
+    // A RecipeManager keeps its own table, loaded next to its recipes, and does not change
+    // this one. Catalogs keep the table they were built with.
+    static std::shared_ptr<const IngredientAliases> current();
+    static void install(std::shared_ptr<const IngredientAliases> aliases);
+};
+
+#endif
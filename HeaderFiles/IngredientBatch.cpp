@@ -0,0 +1,37 @@
+#include "IngredientBatch.h"
+#include <utility>
+
+IngredientBatch::IngredientBatch(Storage& fridgeStorage, Storage& pantryStorage, std::function<void()> commitHook)
+    : fridge(fridgeStorage), pantry(pantryStorage), onCommit(std::move(commitHook)) {}
+
+IngredientBatch& IngredientBatch::addToFridge(const Ingredient& ingredient) {
+    fridgeItems.push_back(ingredient);
+    return *this;
+}
+
+IngredientBatch& IngredientBatch::addToPantry(const Ingredient& ingredient) {
+    pantryItems.push_back(ingredient);
+    return *this;
+}
+
+void IngredientBatch::reserve(std::size_t fridgeCount, std::size_t pantryCount) {
+    fridgeItems.reserve(fridgeItems.size() + fridgeCount);
+    pantryItems.reserve(pantryItems.size() + pantryCount);
+}
+
+std::size_t IngredientBatch::size() const {
+    return fridgeItems.size() + pantryItems.size();
+}
+
+void IngredientBatch::commit() {
+    if (size() == 0) {
+        return;
+    }
+    fridge.addIngredients(fridgeItems);
+    pantry.addIngredients(pantryItems);
+    fridgeItems.clear();
+    pantryItems.clear();
+    if (onCommit) {
+        onCommit();
+    }
+}
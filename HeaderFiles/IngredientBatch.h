@@ -0,0 +1,35 @@
+#ifndef INGREDIENTBATCH_H
+#define INGREDIENTBATCH_H
+
+#include <functional>
+#include <vector>
+#include "Ingredient.h"
+#include "Storage.h"
+
+// Collects ingredients for the fridge and pantry and adds them in one go when committed:
+// each storage merges the batch in a single pass and announces it once, and onCommit (for
+// RecipeManager, saving storage.json) runs once. A batch that is never committed is dropped.
+class IngredientBatch {
+private:
+    Storage& fridge;
+    Storage& pantry;
+    std::function<void()> onCommit;
+    std::vector<Ingredient> fridgeItems;
+    std::vector<Ingredient> pantryItems;
+
+public:
+    IngredientBatch(Storage& fridge, Storage& pantry, std::function<void()> onCommit = nullptr);
+    IngredientBatch(const IngredientBatch&) = delete;
+    IngredientBatch& operator=(const IngredientBatch&) = delete;
+
+    IngredientBatch& addToFridge(const Ingredient& ingredient);
+    IngredientBatch& addToPantry(const Ingredient& ingredient);
+    // Makes room for this many more items of each kind.
+    void reserve(std::size_t fridgeCount, std::size_t pantryCount);
+    std::size_t size() const;
+
+    // Applies everything added so far and empties the batch, which can then be reused.
+    void commit();
+};
+
+#endif
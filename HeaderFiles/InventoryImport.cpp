@@ -0,0 +1,507 @@
+#include "InventoryImport.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include "CivilDate.h"
+#include "FuzzyIngredientIndex.h"
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INVENTORYIMPORT_SSE2 1
+#endif
+
+// Below this a chunk is not worth a thread handing it over.
+static const std::size_t kMinChunkBytes = 256 * 1024;
+static const std::size_t kMaxBadLines = 10;
+
+// The whole file as one read-only block: mapped where mmap exists, read into memory otherwise.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef __unix__
+    void* mapping = nullptr;
+#endif
+    std::string buffer;
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef __unix__
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0) {
+            std::size_t fileSize = static_cast<std::size_t>(info.st_size);
+            void* mapped = fileSize > 0 ? ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+            if (fileSize == 0) {
+                bytes = buffer.data();
+            } else if (mapped != MAP_FAILED) {
+                ::madvise(mapped, fileSize, MADV_SEQUENTIAL);
+                mapping = mapped;
+                bytes = static_cast<const char*>(mapped);
+                length = fileSize;
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (in.is_open()) {
+            buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            bytes = buffer.data();
+            length = buffer.size();
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef __unix__
+        if (mapping != nullptr) {
+            ::munmap(mapping, length);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return bytes != nullptr; }
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+};
+
+// First '\n' in [begin, end), or end. Sixteen bytes per step with SSE2.
+static const char* findNewline(const char* begin, const char* end) {
+#ifdef INVENTORYIMPORT_SSE2
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - begin >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+        if (mask != 0) {
+#if defined(__GNUC__) || defined(__clang__)
+            return begin + __builtin_ctz(static_cast<unsigned>(mask));
+#else
+            unsigned long index;
+            _BitScanForward(&index, static_cast<unsigned long>(mask));
+            return begin + index;
+#endif
+        }
+        begin += 16;
+    }
+#endif
+    const void* found = std::memchr(begin, '\n', static_cast<std::size_t>(end - begin));
+    return found ? static_cast<const char*>(found) : end;
+}
+
+struct Field {
+    const char* text = nullptr;
+    std::size_t length = 0;
+    bool quoted = false;   // inside quotes, "" stands for one quote
+};
+
+// Splits one line (without its newline) into at most maxFields fields; returns how many.
+static std::size_t splitFields(const char* begin, const char* end, char delimiter, Field* fields, std::size_t maxFields) {
+    std::size_t count = 0;
+    const char* p = begin;
+    while (count < maxFields) {
+        Field& field = fields[count++];
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+        if (p < end && *p == '"') {
+            const char* start = ++p;
+            while (p < end && !(*p == '"' && (p + 1 == end || p[1] != '"'))) {
+                p += *p == '"' ? 2 : 1;
+            }
+            field.text = start;
+            field.length = static_cast<std::size_t>(std::min(p, end) - start);
+            field.quoted = true;
+            p = std::min(p + 1, end);
+            while (p < end && *p != delimiter) {
+                ++p;
+            }
+        } else {
+            const char* start = p;
+            while (p < end && *p != delimiter) {
+                ++p;
+            }
+            const char* last = p;
+            while (last > start && (last[-1] == ' ' || last[-1] == '\r')) {
+                --last;
+            }
+            field.text = start;
+            field.length = static_cast<std::size_t>(last - start);
+            field.quoted = false;
+        }
+        if (p >= end) {
+            break;
+        }
+        ++p;   // the delimiter
+    }
+    return count;
+}
+
+static void normalizeInto(std::string& out, const char* text, std::size_t length, bool quoted) {
+    out.clear();
+    bool pendingSpace = false;
+    for (std::size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        if (quoted && c == '"' && i + 1 < length && text[i + 1] == '"') {
+            ++i;
+        }
+        if (c == ' ' || c == '\t' || c == '\r') {
+            pendingSpace = !out.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            out += ' ';
+            pendingSpace = false;
+        }
+        out += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+}
+
+std::string normalizeIngredientName(const char* text, std::size_t length) {
+    std::string out;
+    normalizeInto(out, text, length, false);
+    return out;
+}
+
+// Digits with an optional fraction, e.g. "3" or "1.25".
+static bool parseQuantity(const Field& field, double& quantity) {
+    std::size_t i = 0;
+    double whole = 0.0;
+    std::size_t digits = 0;
+    for (; i < field.length && field.text[i] >= '0' && field.text[i] <= '9'; ++i, ++digits) {
+        whole = whole * 10.0 + (field.text[i] - '0');
+    }
+    double scale = 1.0;
+    if (i < field.length && field.text[i] == '.') {
+        for (++i; i < field.length && field.text[i] >= '0' && field.text[i] <= '9'; ++i, ++digits) {
+            scale /= 10.0;
+            whole += (field.text[i] - '0') * scale;
+        }
+    }
+    quantity = whole;
+    return digits > 0 && i == field.length;
+}
+
+static bool equalsIgnoreCase(const Field& field, const char* word) {
+    std::size_t length = std::strlen(word);
+    if (field.length != length) {
+        return false;
+    }
+    for (std::size_t i = 0; i < length; ++i) {
+        char c = field.text[i];
+        if ((c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c) != word[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace {
+
+// Maps a name as written in the file to its interned id. Manifests repeat the same few
+// thousand names, so each chunk normalizes and interns a spelling only the first time.
+// Open addressing over a flat array with the keys copied into one local buffer, so a lookup
+// touches this chunk's memory only and never the file pages where a name was first seen.
+class NameCache {
+private:
+    struct Slot {
+        std::uint64_t hash = 0;
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+        std::uint32_t id = 0;
+        bool corrected = false;
+        bool used = false;
+    };
+    std::vector<Slot> slots = std::vector<Slot>(1024);
+    std::string keys;
+    std::size_t count = 0;
+
+    void grow() {
+        std::vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+        for (const Slot& slot : old) {
+            if (slot.used) {
+                std::size_t i = slot.hash & (slots.size() - 1);
+                while (slots[i].used) {
+                    i = (i + 1) & (slots.size() - 1);
+                }
+                slots[i] = slot;
+            }
+        }
+    }
+
+public:
+    // Eight bytes at a time; names are short, so this is a handful of multiplies.
+    static std::uint64_t hash(const char* text, std::size_t length) {
+        std::uint64_t h = 0x9e3779b97f4a7c15ull ^ length;
+        std::size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, text + i, 8);
+            h = (h ^ word) * 0xff51afd7ed558ccdull;
+            h ^= h >> 32;
+        }
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, text + i, length - i);
+        h = (h ^ tail) * 0xc4ceb9fe1a85ec53ull;
+        return h ^ (h >> 29);
+    }
+
+    bool find(const char* text, std::size_t length, std::uint64_t h, std::uint32_t& id, bool& corrected) const {
+        for (std::size_t i = h & (slots.size() - 1); slots[i].used; i = (i + 1) & (slots.size() - 1)) {
+            const Slot& slot = slots[i];
+            if (slot.hash == h && slot.length == length && std::memcmp(keys.data() + slot.offset, text, length) == 0) {
+                id = slot.id;
+                corrected = slot.corrected;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insert(const char* text, std::size_t length, std::uint64_t h, std::uint32_t id, bool corrected) {
+        if ((count + 1) * 2 > slots.size()) {
+            grow();
+        }
+        std::size_t i = h & (slots.size() - 1);
+        while (slots[i].used) {
+            i = (i + 1) & (slots.size() - 1);
+        }
+        Slot& slot = slots[i];
+        slot.hash = h;
+        slot.offset = static_cast<std::uint32_t>(keys.size());
+        slot.length = static_cast<std::uint32_t>(length);
+        slot.id = id;
+        slot.corrected = corrected;
+        slot.used = true;
+        keys.append(text, length);
+        ++count;
+    }
+};
+
+enum Column { kName, kQuantity, kDate, kLocation, kColumnCount };
+
+struct Layout {
+    char delimiter = ',';
+    int column[kColumnCount] = { 0, 1, 2, 3 };   // field index of each column, -1 if absent
+    std::size_t fieldCount = 4;
+};
+
+struct ChunkResult {
+    std::vector<Ingredient> fridge;
+    std::vector<Ingredient> pantry;
+    std::size_t physicalLines = 0;   // including blank ones, for line numbers
+    std::size_t lines = 0;
+    std::size_t skipped = 0;
+    std::size_t corrected = 0;
+    std::vector<std::pair<std::string, std::string>> corrections;   // first time in the chunk
+    std::vector<std::size_t> badLines;   // 0-based within the chunk
+};
+
+}
+
+// Reads the header if the first line is one; returns true and fills the layout if so.
+static bool readHeader(const Field* fields, std::size_t count, Layout& layout) {
+    int column[kColumnCount] = { -1, -1, -1, -1 };
+    for (std::size_t i = 0; i < count; ++i) {
+        const Field& field = fields[i];
+        if (equalsIgnoreCase(field, "name") || equalsIgnoreCase(field, "ingredient")) {
+            column[kName] = static_cast<int>(i);
+        } else if (equalsIgnoreCase(field, "quantity") || equalsIgnoreCase(field, "qty")) {
+            column[kQuantity] = static_cast<int>(i);
+        } else if (equalsIgnoreCase(field, "expiration") || equalsIgnoreCase(field, "expirationdate") || equalsIgnoreCase(field, "date")) {
+            column[kDate] = static_cast<int>(i);
+        } else if (equalsIgnoreCase(field, "location") || equalsIgnoreCase(field, "storage")) {
+            column[kLocation] = static_cast<int>(i);
+        }
+    }
+    if (column[kName] < 0 || column[kQuantity] < 0) {
+        return false;
+    }
+    std::copy(column, column + kColumnCount, layout.column);
+    layout.fieldCount = count;
+    return true;
+}
+
+static void parseChunk(const char* begin, const char* end, const Layout& layout, const FuzzyIngredientIndex* spelling,
+                       ChunkResult& result) {
+    const std::size_t maxFields = std::max<std::size_t>(layout.fieldCount, 4);
+    std::vector<Field> fields(maxFields);
+    std::string name;
+    NameCache knownNames;
+    auto field = [&](Column column, std::size_t count) -> const Field* {
+        int index = layout.column[column];
+        return index >= 0 && static_cast<std::size_t>(index) < count ? &fields[index] : nullptr;
+    };
+
+    for (const char* line = begin; line < end; ++result.physicalLines) {
+        const char* lineEnd = findNewline(line, end);
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+        if (lineEnd > line && lineEnd[-1] == '\r') {
+            --lineEnd;
+        }
+        if (lineEnd == line) {
+            line = next;
+            continue;
+        }
+        ++result.lines;
+
+        std::size_t count = splitFields(line, lineEnd, layout.delimiter, fields.data(), maxFields);
+        const Field* nameField = field(kName, count);
+        const Field* quantityField = field(kQuantity, count);
+        const Field* dateField = field(kDate, count);
+        const Field* locationField = field(kLocation, count);
+
+        double quantity = 0.0;
+        int expiryDay = kNoDate;
+        bool ok = nameField && quantityField && parseQuantity(*quantityField, quantity);
+        std::uint32_t nameId = 0;
+        bool corrected = false;
+        if (ok) {
+            std::uint64_t h = NameCache::hash(nameField->text, nameField->length);
+            if (!knownNames.find(nameField->text, nameField->length, h, nameId, corrected)) {
+                normalizeInto(name, nameField->text, nameField->length, nameField->quoted);
+                // Looked up once per distinct spelling in the chunk, like the interning.
+                std::string fixed = spelling && !name.empty() ? spelling->correction(name) : std::string();
+                corrected = !fixed.empty();
+                if (corrected) {
+                    result.corrections.emplace_back(name, fixed);
+                }
+                nameId = name.empty() ? 0 : Ingredient::internName(corrected ? fixed : name);
+                knownNames.insert(nameField->text, nameField->length, h, nameId, corrected);
+            }
+            ok = nameId != 0;
+        }
+        if (ok && dateField && dateField->length > 0) {
+            ok = parseDate(dateField->text, dateField->length, expiryDay);
+        }
+        bool toFridge = expiryDay != kNoDate;
+        if (ok && locationField && locationField->length > 0) {
+            if (equalsIgnoreCase(*locationField, "fridge") || equalsIgnoreCase(*locationField, "f")) {
+                toFridge = true;
+            } else if (equalsIgnoreCase(*locationField, "pantry") || equalsIgnoreCase(*locationField, "p")) {
+                toFridge = false;
+            } else {
+                ok = false;
+            }
+        }
+
+        if (ok) {
+            Ingredient item = Ingredient::fromParts(nameId, quantity, expiryDay);
+            (toFridge ? result.fridge : result.pantry).push_back(item);
+            result.corrected += corrected ? 1 : 0;
+        } else {
+            ++result.skipped;
+            if (result.badLines.size() < kMaxBadLines) {
+                result.badLines.push_back(result.physicalLines);
+            }
+        }
+        line = next;
+    }
+}
+
+bool importInventory(const std::string& path, IngredientBatch& batch, ImportReport& report, const ImportOptions& options) {
+    report = ImportReport();
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    report.bytes = file.size();
+    if (begin == end) {
+        return true;
+    }
+
+    Layout layout;
+    const char* firstEnd = findNewline(begin, end);
+    layout.delimiter = options.delimiter ? options.delimiter
+                                         : (std::find(begin, firstEnd, '\t') != firstEnd ? '\t' : ',');
+    std::vector<Field> header(64);
+    std::size_t headerFields = splitFields(begin, firstEnd, layout.delimiter, header.data(), header.size());
+    std::size_t headerLines = 0;
+    if (readHeader(header.data(), headerFields, layout)) {
+        begin = firstEnd < end ? firstEnd + 1 : end;
+        headerLines = 1;
+    }
+
+    // Chunk boundaries sit just after a newline, so no line is split between two chunks.
+    unsigned threadCount = options.threadCount ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t size = static_cast<std::size_t>(end - begin);
+    std::size_t chunkCount = std::max<std::size_t>(1, std::min<std::size_t>(threadCount * 4, size / kMinChunkBytes));
+    std::vector<const char*> bounds(1, begin);
+    for (std::size_t c = 1; c < chunkCount; ++c) {
+        const char* cut = std::max(begin + size * c / chunkCount, bounds.back());
+        const char* newline = findNewline(cut, end);
+        bounds.push_back(newline < end ? newline + 1 : end);
+    }
+    bounds.push_back(end);
+
+    std::vector<ChunkResult> results(chunkCount);
+    std::atomic<std::size_t> next(0);
+    auto work = [&]() {
+        for (std::size_t c = next.fetch_add(1); c < chunkCount; c = next.fetch_add(1)) {
+            parseChunk(bounds[c], bounds[c + 1], layout, options.spelling, results[c]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned worker = 1; worker < std::min<std::size_t>(threadCount, chunkCount); ++worker) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::size_t fridgeCount = 0;
+    std::size_t pantryCount = 0;
+    for (const auto& result : results) {
+        fridgeCount += result.fridge.size();
+        pantryCount += result.pantry.size();
+    }
+    batch.reserve(fridgeCount, pantryCount);
+
+    std::size_t firstLine = headerLines + 1;
+    std::unordered_set<std::string> listed;
+    for (const auto& result : results) {
+        for (const auto& item : result.fridge) {
+            batch.addToFridge(item);
+        }
+        for (const auto& item : result.pantry) {
+            batch.addToPantry(item);
+        }
+        for (std::size_t bad : result.badLines) {
+            if (report.badLines.size() < kMaxBadLines) {
+                report.badLines.push_back(firstLine + bad);
+            }
+        }
+        report.lines += result.lines;
+        report.skipped += result.skipped;
+        report.corrected += result.corrected;
+        for (const auto& correction : result.corrections) {
+            if (listed.insert(correction.first).second) {
+                report.corrections.push_back(correction);
+            }
+        }
+        firstLine += result.physicalLines;
+    }
+    report.imported = fridgeCount + pantryCount;
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef INVENTORYIMPORT_H
+#define INVENTORYIMPORT_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "IngredientBatch.h"
+
+class FuzzyIngredientIndex;
+
+// Reading supplier delivery manifests (CSV or TSV) into the fridge and pantry.
+//
+// Each line is one item: name, quantity, and optionally an expiration date (YYYY-MM-DD)
+// and a location ("fridge" or "pantry"). An optional header line names the columns
+// (name, quantity, expiration / expirationDate / date, location / storage) and may list
+// them in any order. Items without a location go to the fridge if they have a date and to
+// the pantry otherwise. Fields may be double-quoted to contain the delimiter, but not a
+// line break. Quantities may have a fraction ("1.5").
+
+struct ImportOptions {
+    char delimiter = 0;        // ',' or '\t'; 0 picks whichever the first line contains
+    unsigned threadCount = 0;  // 0 = one per core
+    // When set, a name that is not known but is a likely typo of a known one is replaced by
+    // it ("tomatoe" -> "tomato"); see FuzzyIngredientIndex::correction. Off by default, as a
+    // real item can be one letter away from a known one ("beef" and "beet").
+    const FuzzyIngredientIndex* spelling = nullptr;
+};
+
+struct ImportReport {
+    std::size_t bytes = 0;
+    std::size_t lines = 0;                // data lines, not counting the header or blank lines
+    std::size_t imported = 0;
+    std::vector<std::size_t> badLines;    // 1-based line numbers of skipped lines, first few only
+    std::size_t skipped = 0;
+    std::size_t corrected = 0;            // imported items whose name was a corrected typo
+    // Each corrected name once, as (name in the file, normalized; name imported), in file order.
+    std::vector<std::pair<std::string, std::string>> corrections;
+};
+
+// Trims the name, collapses runs of spaces and lowercases it, so "  Olive  Oil" and
+// "olive oil" end up as one item.
+std::string normalizeIngredientName(const char* text, std::size_t length);
+
+// Parses the file on several threads and adds the items to `batch` without committing it.
+// Returns false if the file cannot be opened.
+bool importInventory(const std::string& path, IngredientBatch& batch, ImportReport& report,
+                     const ImportOptions& options = ImportOptions());
+
+#endif
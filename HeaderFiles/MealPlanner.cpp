@@ -0,0 +1,293 @@
+#include "MealPlanner.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+struct MealPlanner::State {
+    std::vector<double> stock;   // indexed like lots
+    std::vector<std::size_t> meals;
+    double usage = 0.0;
+    double waste = 0.0;
+
+    double score() const { return usage - waste; }
+};
+
+namespace {
+
+// States with the same stock on the same day have the same future; quantities are
+// compared after rounding so that 0.1 + 0.2 and 0.3 meet.
+struct StockKey {
+    std::vector<long long> units;
+
+    bool operator==(const StockKey& other) const { return units == other.units; }
+};
+
+struct StockKeyHash {
+    std::size_t operator()(const StockKey& key) const {
+        std::size_t hash = 14695981039346656037ull;
+        for (long long unit : key.units) {
+            hash = (hash ^ static_cast<std::size_t>(unit)) * 1099511628211ull;
+        }
+        return hash;
+    }
+};
+
+StockKey keyOf(const std::vector<double>& stock) {
+    StockKey key;
+    key.units.reserve(stock.size());
+    for (double quantity : stock) {
+        key.units.push_back(std::llround(quantity * 1e6));
+    }
+    return key;
+}
+
+} // namespace
+
+MealPlanner::MealPlanner(const RecipeCatalog& recipeCatalog, const std::vector<Ingredient>& inventory,
+                         const std::vector<std::pair<std::string, int>>& daysLeft)
+    : catalog(recipeCatalog) {
+    // One lot per catalog ingredient on hand. An item stored more than once is treated
+    // as a single lot that expires with its earliest date.
+    std::unordered_map<IngredientId, std::uint32_t> lotOf;
+    for (const auto& ingredient : inventory) {
+        IngredientId id = catalog.findIngredient(ingredient.getName());
+        if (id == RecipeCatalog::kNoIngredient || ingredient.getAmount() <= 0.0) {
+            continue;
+        }
+        auto inserted = lotOf.emplace(id, static_cast<std::uint32_t>(lots.size()));
+        if (inserted.second) {
+            lots.push_back(Lot{ 0.0, kNeverExpires });
+        }
+        lots[inserted.first->second].initial += ingredient.getAmount();
+    }
+    for (const auto& item : daysLeft) {
+        auto found = lotOf.find(catalog.findIngredient(item.first));
+        if (found != lotOf.end()) {
+            lots[found->second].lastDay = std::min(lots[found->second].lastDay, item.second);
+        }
+    }
+
+    needOffsets.push_back(0);
+    for (std::size_t recipeId = 0; recipeId < catalog.size(); ++recipeId) {
+        const auto& amounts = catalog.getRecipes()[recipeId].getRequiredIngredients();
+        IdRange ingredients = catalog.getRecipeIngredients(recipeId);
+        std::size_t firstNeed = needs.size();
+        bool possible = true;
+        std::size_t k = 0;
+        for (IngredientId id : ingredients) {
+            auto found = lotOf.find(id);
+            if (found == lotOf.end() || lots[found->second].lastDay < 0) {
+                possible = false;
+                break;
+            }
+            double amount = stockNeeded(amounts[k++].second);
+            // An ingredient listed twice needs both amounts.
+            auto same = std::find_if(needs.begin() + firstNeed, needs.end(), [&](const Need& need) { return need.lot == found->second; });
+            if (same != needs.end()) {
+                same->amount += amount;
+            } else {
+                needs.push_back(Need{ found->second, amount });
+            }
+        }
+        for (std::size_t n = firstNeed; possible && n < needs.size(); ++n) {
+            possible = lots[needs[n].lot].initial + 1e-9 >= needs[n].amount;
+        }
+        if (!possible || ingredients.empty()) {
+            needs.resize(firstNeed);
+            continue;
+        }
+        candidates.push_back(recipeId);
+        needOffsets.push_back(static_cast<std::uint32_t>(needs.size()));
+    }
+}
+
+// Scores every meal the state could have today (or none) without building the new states.
+void MealPlanner::expand(const State& state, std::size_t parent, int day, std::vector<Move>& moves) const {
+    // Whatever is left of today's last-day items after the meal is wasted.
+    double wasteToday = wasteAfter(state, day);
+    moves.push_back(Move{ parent, kNoMeal, state.score() - wasteToday });
+
+    for (std::uint32_t c = 0; c < candidates.size(); ++c) {
+        double gain = 0.0;
+        bool possible = true;
+        for (std::uint32_t n = needOffsets[c]; n < needOffsets[c + 1] && possible; ++n) {
+            const Need& need = needs[n];
+            const Lot& lot = lots[need.lot];
+            double left = state.stock[need.lot];
+            possible = day <= lot.lastDay && left > 1e-9 && left + 1e-9 >= need.amount;
+            // Used today counts once as usage and, for a last-day item, once more as waste avoided.
+            gain += std::min(need.amount, left) / lot.initial * (lot.lastDay == day ? 2 : 1);
+        }
+        if (possible) {
+            moves.push_back(Move{ parent, c, state.score() - wasteToday + gain });
+        }
+    }
+}
+
+MealPlanner::State MealPlanner::apply(const State& state, const Move& move, int day) const {
+    State child = state;
+    if (move.candidate == kNoMeal) {
+        child.meals.push_back(RecipeCatalog::npos);
+    } else {
+        for (std::uint32_t n = needOffsets[move.candidate]; n < needOffsets[move.candidate + 1]; ++n) {
+            const Need& need = needs[n];
+            double taken = std::min(need.amount, child.stock[need.lot]);
+            child.stock[need.lot] -= taken;
+            child.usage += taken / lots[need.lot].initial;
+        }
+        child.meals.push_back(candidates[move.candidate]);
+    }
+    child.waste += wasteAfter(child, day);
+    return child;
+}
+
+// What is left of the items whose last usable day was `day`.
+double MealPlanner::wasteAfter(const State& state, int day) const {
+    double waste = 0.0;
+    for (std::size_t lot = 0; lot < lots.size(); ++lot) {
+        if (lots[lot].lastDay == day) {
+            waste += state.stock[lot] / lots[lot].initial;
+        }
+    }
+    return waste;
+}
+
+// Usage is bounded twice: per item (used on every day it is still good by the recipe that
+// needs most of it) and per day (one meal a day, using at most the most any single recipe
+// uses). Waste is likewise at least what those limits leave of the items that expire.
+double MealPlanner::upperBound(int days) const {
+    std::vector<double> largestNeed(lots.size(), 0.0);
+    double bestMeal = 0.0;
+    double bestMealOfExpiring = 0.0;
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        double meal = 0.0;
+        double mealOfExpiring = 0.0;
+        for (std::uint32_t n = needOffsets[c]; n < needOffsets[c + 1]; ++n) {
+            const Need& need = needs[n];
+            largestNeed[need.lot] = std::max(largestNeed[need.lot], need.amount);
+            double share = std::min(1.0, need.amount / lots[need.lot].initial);
+            meal += share;
+            mealOfExpiring += lots[need.lot].lastDay < days ? share : 0.0;
+        }
+        bestMeal = std::max(bestMeal, meal);
+        bestMealOfExpiring = std::max(bestMealOfExpiring, mealOfExpiring);
+    }
+
+    double itemUsage = 0.0;
+    double itemWaste = 0.0;
+    double expiring = 0.0;
+    for (std::size_t lot = 0; lot < lots.size(); ++lot) {
+        if (lots[lot].lastDay < 0) {
+            continue;
+        }
+        bool expires = lots[lot].lastDay < days;
+        int usableDays = expires ? lots[lot].lastDay + 1 : days;
+        double usable = std::min(1.0, usableDays * largestNeed[lot] / lots[lot].initial);
+        itemUsage += usable;
+        if (expires) {
+            itemWaste += 1.0 - usable;
+            expiring += 1.0;
+        }
+    }
+    double usage = std::min(itemUsage, days * bestMeal);
+    double waste = std::max(itemWaste, expiring - days * bestMealOfExpiring);
+    return usage - waste;
+}
+
+MealPlan MealPlanner::plan(const MealPlanOptions& options) const {
+    auto start = std::chrono::steady_clock::now();
+    auto outOfTime = [&]() { return std::chrono::steady_clock::now() - start > options.timeBudget; };
+    MealPlan result;
+    result.completed = true;
+    result.upperBound = upperBound(options.days);
+
+    State initial;
+    for (const Lot& lot : lots) {
+        initial.stock.push_back(lot.initial);
+    }
+    std::vector<State> beam;
+    beam.push_back(std::move(initial));
+
+    unsigned threadCount = options.threadCount ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+    for (int day = 0; day < options.days; ++day) {
+        std::size_t width = std::max<std::size_t>(1, options.beamWidth);
+        if (outOfTime()) {
+            // Out of time: finish the remaining days from the single best state.
+            width = 1;
+            beam.resize(1);
+            result.completed = false;
+        }
+
+        // Score the moves out of every state in parallel. The best state is always expanded;
+        // the others only while there is time left.
+        std::vector<std::vector<Move>> scored(std::min<std::size_t>(threadCount, beam.size()));
+        std::atomic<std::size_t> next(0);
+        std::atomic<bool> stopped(false);
+        auto work = [&](std::size_t worker) {
+            for (std::size_t i = next++; i < beam.size(); i = next++) {
+                if (i > 0 && (stopped || outOfTime())) {
+                    stopped = true;
+                    break;
+                }
+                expand(beam[i], i, day, scored[worker]);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (std::size_t worker = 1; worker < scored.size(); ++worker) {
+            workers.emplace_back(work, worker);
+        }
+        work(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (stopped) {
+            result.completed = false;
+        }
+
+        std::vector<Move> moves;
+        for (auto& part : scored) {
+            moves.insert(moves.end(), part.begin(), part.end());
+        }
+        result.statesExplored += moves.size();
+        auto order = [&](const Move& a, const Move& b) {
+            if (std::fabs(a.score - b.score) > 1e-12) {
+                return a.score > b.score;
+            }
+            if (beam[a.parent].meals != beam[b.parent].meals) {
+                return beam[a.parent].meals < beam[b.parent].meals;
+            }
+            return a.candidate < b.candidate;
+        };
+
+        // Build the best moves' states. Two states with the same stock have the same future,
+        // so only the better (earlier) of them is kept.
+        std::vector<State> layer;
+        std::unordered_set<StockKey, StockKeyHash> seen;
+        std::size_t sorted = 0;
+        for (std::size_t m = 0; m < moves.size() && layer.size() < width; ++m) {
+            if (m == sorted) {
+                std::size_t upTo = std::min(moves.size(), std::max(sorted * 2, width * 2));
+                std::partial_sort(moves.begin() + sorted, moves.begin() + upTo, moves.end(), order);
+                sorted = upTo;
+            }
+            State child = apply(beam[moves[m].parent], moves[m], day);
+            if (seen.insert(keyOf(child.stock)).second) {
+                layer.push_back(std::move(child));
+            } else {
+                ++result.memoHits;
+            }
+        }
+        beam = std::move(layer);
+    }
+
+    const State& best = beam.front();
+    result.recipes = best.meals;
+    result.usage = best.usage;
+    result.waste = best.waste;
+    result.score = best.score();
+    result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,90 @@
+#ifndef MEALPLANNER_H
+#define MEALPLANNER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Ingredient.h"
+#include "RecipeCatalog.h"
+
+struct MealPlanOptions {
+    int days = 7;
+    std::size_t beamWidth = 64;
+    // Once this is used up the search stops widening and finishes the plan greedily.
+    std::chrono::milliseconds timeBudget{ 100 };
+    unsigned threadCount = 0;   // 0 = one per core
+};
+
+// A recipe (or RecipeCatalog::npos for "nothing planned") per day, and how good the plan is.
+//
+// Scores are measured per stock item, so grams of beef and single eggs count alike:
+// using up all of an item is worth 1, and an item that expires during the plan with
+// a fraction f still left costs f.
+struct MealPlan {
+    std::vector<std::size_t> recipes;
+    double usage = 0.0;        // sum over stock items of the fraction used
+    double waste = 0.0;        // sum over items expiring within the plan of the fraction left
+    double score = 0.0;        // usage - waste
+    double upperBound = 0.0;   // no plan over these days can score more than this
+
+    bool completed = false;    // false if the time budget ran out before the last day
+    double elapsedMs = 0.0;
+    std::size_t statesExplored = 0;
+    std::size_t memoHits = 0;  // states dropped because an equal stock was already reached
+};
+
+// Chooses one recipe per day so that the stock on hand is used up before it expires.
+//
+// Quantities come from the recipe amounts by the same rule cooking uses (see stockNeeded:
+// "1/2 cup" needs 0.5 of the stored quantity, "to taste" only needs the item to be present)
+// and are subtracted as the plan goes, so a later day only sees what the earlier days left. Items are usable up to and including
+// their expiry day.
+//
+// The search is a beam search over days. Each day every move out of the current beam is
+// scored in parallel, and the best moves are turned into next day's beam. States that
+// reach the same stock on the same day have the same future, so only the better one is
+// kept (memoHits counts the others).
+class MealPlanner {
+public:
+    // daysLeft: days until expiry of the dated items, as given by Fridge::daysUntilExpiry.
+    MealPlanner(const RecipeCatalog& catalog, const std::vector<Ingredient>& inventory,
+                const std::vector<std::pair<std::string, int>>& daysLeft);
+
+    MealPlan plan(const MealPlanOptions& options = MealPlanOptions()) const;
+
+private:
+    struct Lot {
+        double initial;
+        int lastDay;   // last usable day, or kNeverExpires
+    };
+    struct Need {
+        std::uint32_t lot;
+        double amount;
+    };
+    struct State;
+    // One way to extend a state by a day, and the score the extended state would have.
+    struct Move {
+        std::size_t parent;
+        std::uint32_t candidate;   // index into candidates, or kNoMeal
+        double score;
+    };
+
+    static constexpr int kNeverExpires = 0x7fffffff;
+    static constexpr std::uint32_t kNoMeal = 0xffffffff;
+
+    const RecipeCatalog& catalog;
+    std::vector<Lot> lots;
+    // Recipes that can be made from the starting stock at all, and what each one takes.
+    std::vector<std::size_t> candidates;
+    std::vector<std::uint32_t> needOffsets;
+    std::vector<Need> needs;
+
+    void expand(const State& state, std::size_t parent, int day, std::vector<Move>& moves) const;
+    State apply(const State& state, const Move& move, int day) const;
+    double wasteAfter(const State& state, int day) const;
+    double upperBound(int days) const;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include "MinHashSketch.h"
+#include <algorithm>
+#include <limits>
+
+std::uint64_t MinHashSketch::mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+MinHashSketch::MinHashSketch(std::uint32_t hashCount) {
+    for (std::uint32_t i = 0; i < hashCount; ++i) {
+        multipliers.push_back(mix(i) | 1);   // odd, so multiplying by it loses no bits
+    }
+}
+
+std::size_t MinHashSketch::size() const {
+    return multipliers.size();
+}
+
+void MinHashSketch::reset(std::uint32_t* signature) const {
+    std::fill(signature, signature + multipliers.size(), std::numeric_limits<std::uint32_t>::max());
+}
+
+void MinHashSketch::add(std::uint64_t itemHash, std::uint32_t* signature) const {
+    for (std::size_t h = 0; h < multipliers.size(); ++h) {
+        signature[h] = std::min(signature[h], static_cast<std::uint32_t>((itemHash * multipliers[h]) >> 32));
+    }
+}
+
+std::uint64_t MinHashSketch::bandKey(const std::uint32_t* signature, std::uint32_t band, std::uint32_t rows) {
+    std::uint64_t key = mix(band);
+    for (std::uint32_t r = 0; r < rows; ++r) {
+        key = mix(key ^ signature[band * rows + r]);
+    }
+    return key;
+}
@@ -0,0 +1,27 @@
+#ifndef MINHASHSKETCH_H
+#define MINHASHSKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+// MinHash signatures: for each of several hash functions, the smallest hash of any item of
+// a set. Two sets agree on an entry with probability equal to their Jaccard similarity.
+// Items are given as 64-bit hashes; each hash function is a multiply-shift of that hash.
+class MinHashSketch {
+private:
+    std::vector<std::uint64_t> multipliers;
+
+public:
+    explicit MinHashSketch(std::uint32_t hashCount);
+    std::size_t size() const;
+
+    // `signature` has size() entries. An empty set keeps the initial value in every entry.
+    void reset(std::uint32_t* signature) const;
+    void add(std::uint64_t itemHash, std::uint32_t* signature) const;
+    // A hash of entries [band * rows, (band + 1) * rows), distinct per band.
+    static std::uint64_t bandKey(const std::uint32_t* signature, std::uint32_t band, std::uint32_t rows);
+    // A well-mixed 64-bit hash of a number, for use as an item hash.
+    static std::uint64_t mix(std::uint64_t x);
+};
+
+#endif
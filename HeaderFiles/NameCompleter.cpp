@@ -0,0 +1,267 @@
+#include "NameCompleter.h"
+#include <algorithm>
+#include <utility>
+
+static std::string lowercase(const std::string& text) {
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower;
+}
+
+NameCompleter::NameCompleter() {
+    nodes.emplace_back();
+    nodes[0].parent = 0;
+}
+
+NameCompleter::NameCompleter(const RecipeCatalog& catalog) : NameCompleter() {
+    addCatalog(catalog);
+}
+
+void NameCompleter::addCatalog(const RecipeCatalog& catalog) {
+    // Many names at once: fill in the terms, then rebuild every list in one bottom-up pass
+    // rather than one root path per name.
+    fillCatalog(catalog);
+    refreshAll();
+}
+
+void NameCompleter::setCatalog(const RecipeCatalog& catalog) {
+    std::vector<std::uint32_t> previous;
+    for (std::uint32_t term = 0; term < terms.size(); ++term) {
+        if (terms[term].inCatalog) {
+            terms[term].inCatalog = false;
+            previous.push_back(term);
+        }
+    }
+    fillCatalog(catalog);
+    for (std::uint32_t term : previous) {
+        Term& old = terms[term];
+        if (old.inCatalog) {
+            continue;
+        }
+        if (old.completion.kind == CompletionKind::Recipe || !old.added) {
+            removeTerm(term);
+        } else {
+            old.completion.score = 0.0;
+        }
+    }
+    refreshAll();
+}
+
+// Creates or rescores the catalog's terms without touching the lists.
+void NameCompleter::fillCatalog(const RecipeCatalog& catalog) {
+    bool created;
+    for (IngredientId id = 0; id < catalog.ingredientCount(); ++id) {
+        std::uint32_t term = termFor(catalog.getIngredientName(id), CompletionKind::Ingredient, created);
+        terms[term].completion.score = static_cast<double>(catalog.getRecipesUsing(id).size());
+        terms[term].inCatalog = true;
+    }
+    for (const auto& recipe : catalog.getRecipes()) {
+        terms[termFor(recipe.getRecipeName(), CompletionKind::Recipe, created)].inCatalog = true;
+    }
+}
+
+// Unlinks the term from its node and the name map; its slot in `terms` is not reused, and the
+// lists are left for the caller to refresh.
+void NameCompleter::removeTerm(std::uint32_t term) {
+    Term& old = terms[term];
+    auto& here = nodes[old.node].terms;
+    here.erase(std::find(here.begin(), here.end(), term));
+    termIds.erase(old.key + '\0' + static_cast<char>(old.completion.kind));
+}
+
+bool NameCompleter::ranksBefore(std::uint32_t a, std::uint32_t b) const {
+    const Term& left = terms[a];
+    const Term& right = terms[b];
+    if (left.completion.score != right.completion.score) {
+        return left.completion.score > right.completion.score;
+    }
+    if (left.node != right.node) {
+        return left.key < right.key;
+    }
+    return left.completion.kind < right.completion.kind;
+}
+
+std::uint32_t NameCompleter::findChild(const Node& node, char first) const {
+    auto it = std::lower_bound(node.children.begin(), node.children.end(), first,
+                               [&](std::uint32_t child, char c) { return nodes[child].label[0] < c; });
+    return it != node.children.end() && nodes[*it].label[0] == first ? *it : 0;
+}
+
+// The node for key, creating it (and splitting an edge) if needed.
+std::uint32_t NameCompleter::insertKey(const std::string& key) {
+    std::uint32_t node = 0;
+    std::size_t pos = 0;
+    while (pos < key.size()) {
+        std::uint32_t child = findChild(nodes[node], key[pos]);
+        if (child == 0) {
+            Node leaf;
+            leaf.label = key.substr(pos);
+            leaf.parent = node;
+            std::uint32_t leafId = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back(std::move(leaf));
+            auto& children = nodes[node].children;
+            auto at = std::lower_bound(children.begin(), children.end(), key[pos],
+                                       [&](std::uint32_t other, char c) { return nodes[other].label[0] < c; });
+            children.insert(at, leafId);
+            return leafId;
+        }
+
+        const std::string& label = nodes[child].label;
+        std::size_t common = 0;
+        while (common < label.size() && pos + common < key.size() && label[common] == key[pos + common]) {
+            ++common;
+        }
+        if (common < label.size()) {
+            // Split the edge: a new node takes the shared part and the old child hangs below it.
+            // It covers exactly what the child covered, so it starts with the child's list.
+            Node middle;
+            middle.label = label.substr(0, common);
+            middle.parent = node;
+            middle.children.push_back(child);
+            std::copy(nodes[child].top, nodes[child].top + nodes[child].topCount, middle.top);
+            middle.topCount = nodes[child].topCount;
+            std::uint32_t middleId = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back(std::move(middle));
+            nodes[child].label.erase(0, common);
+            nodes[child].parent = middleId;
+            std::replace(nodes[node].children.begin(), nodes[node].children.end(), child, middleId);
+            child = middleId;
+        }
+        node = child;
+        pos += common;
+    }
+    return node;
+}
+
+// Rebuilds the best-names lists from the term's node towards the root, each from the node's
+// own names and its children's lists, which already hold the best of everything further
+// down. Once a list comes out unchanged and without the term, nothing above can change.
+void NameCompleter::refreshPath(std::uint32_t term) {
+    std::uint32_t node = terms[term].node;
+    while (true) {
+        bool changed = refreshNode(node);
+        const Node& current = nodes[node];
+        if (node == 0 || (!changed && std::find(current.top, current.top + current.topCount, term) == current.top + current.topCount)) {
+            break;
+        }
+        node = current.parent;
+    }
+}
+
+// Returns whether the list changed.
+bool NameCompleter::refreshNode(std::uint32_t node) {
+    Node& current = nodes[node];
+    scratch.assign(current.terms.begin(), current.terms.end());
+    for (std::uint32_t child : current.children) {
+        scratch.insert(scratch.end(), nodes[child].top, nodes[child].top + nodes[child].topCount);
+    }
+    std::size_t keep = std::min(scratch.size(), kTopK);
+    std::partial_sort(scratch.begin(), scratch.begin() + keep, scratch.end(),
+                      [&](std::uint32_t a, std::uint32_t b) { return ranksBefore(a, b); });
+    bool changed = keep != current.topCount || !std::equal(scratch.begin(), scratch.begin() + keep, current.top);
+    std::copy(scratch.begin(), scratch.begin() + keep, current.top);
+    current.topCount = static_cast<std::uint8_t>(keep);
+    return changed;
+}
+
+// Children before parents, so each list is built from finished ones.
+void NameCompleter::refreshAll() {
+    std::vector<std::uint32_t> order(1, 0);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const Node& node = nodes[order[i]];
+        order.insert(order.end(), node.children.begin(), node.children.end());
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        refreshNode(*it);
+    }
+}
+
+std::uint32_t NameCompleter::termFor(const std::string& name, CompletionKind kind, bool& created) {
+    std::string key = lowercase(name);
+    auto inserted = termIds.emplace(key + '\0' + static_cast<char>(kind), static_cast<std::uint32_t>(terms.size()));
+    created = inserted.second;
+    if (created) {
+        std::uint32_t node = insertKey(key);
+        terms.push_back(Term{ std::move(key), Completion{ name, kind, 0.0 }, node });
+        nodes[node].terms.push_back(inserted.first->second);
+    }
+    return inserted.first->second;
+}
+
+void NameCompleter::add(const std::string& name, CompletionKind kind) {
+    if (name.empty()) {
+        return;
+    }
+    bool created;
+    std::uint32_t term = termFor(name, kind, created);
+    terms[term].added = true;
+    if (created) {
+        refreshPath(term);
+    }
+}
+
+void NameCompleter::setScore(const std::string& name, CompletionKind kind, double score) {
+    if (name.empty()) {
+        return;
+    }
+    bool created;
+    std::uint32_t term = termFor(name, kind, created);
+    terms[term].added = true;
+    if (created || terms[term].completion.score != score) {
+        terms[term].completion.score = score;
+        refreshPath(term);
+    }
+}
+
+void NameCompleter::addScore(const std::string& name, CompletionKind kind, double delta) {
+    if (name.empty()) {
+        return;
+    }
+    bool created;
+    std::uint32_t term = termFor(name, kind, created);
+    terms[term].added = true;
+    terms[term].completion.score += delta;
+    refreshPath(term);
+}
+
+std::vector<Completion> NameCompleter::complete(const std::string& prefix, std::size_t limit) const {
+    std::vector<const Completion*> matches;
+    complete(prefix, matches, limit);
+    std::vector<Completion> found;
+    found.reserve(matches.size());
+    for (const Completion* match : matches) {
+        found.push_back(*match);
+    }
+    return found;
+}
+
+void NameCompleter::complete(const std::string& prefix, std::vector<const Completion*>& out, std::size_t limit) const {
+    out.clear();
+    std::uint32_t node = 0;
+    std::size_t pos = 0;
+    while (pos < prefix.size()) {
+        char c = static_cast<char>(::tolower(static_cast<unsigned char>(prefix[pos])));
+        std::uint32_t child = findChild(nodes[node], c);
+        if (child == 0) {
+            return;
+        }
+        // The prefix may end part way along the edge; everything below still matches.
+        const std::string& label = nodes[child].label;
+        for (std::size_t i = 0; i < label.size() && pos < prefix.size(); ++i, ++pos) {
+            if (label[i] != static_cast<char>(::tolower(static_cast<unsigned char>(prefix[pos])))) {
+                return;
+            }
+        }
+        node = child;
+    }
+
+    const Node& match = nodes[node];
+    std::size_t count = std::min<std::size_t>(std::min(limit, kTopK), match.topCount);
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(&terms[match.top[i]].completion);
+    }
+}
+
+std::size_t NameCompleter::size() const {
+    return termIds.size();
+}
@@ -0,0 +1,89 @@
+#ifndef NAMECOMPLETER_H
+#define NAMECOMPLETER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "RecipeCatalog.h"
+
+enum class CompletionKind : std::uint8_t { Ingredient, Recipe };
+
+struct Completion {
+    std::string name;
+    CompletionKind kind;
+    double score;
+};
+
+// Type-ahead over ingredient and recipe names: complete("choc") gives the most popular
+// names starting with "choc", ignoring case.
+//
+// Names are kept in a compressed radix trie (chains of single-child nodes are merged into
+// one edge label), and every node stores the best kTopK names below it, best first. A
+// lookup is therefore a walk down at most prefix-length bytes followed by a copy of that
+// list; nothing below the node is visited. Changing a name's score or adding a name only
+// recomputes the lists on the path from its node to the root, each from the children's
+// lists.
+class NameCompleter {
+public:
+    static constexpr std::size_t kTopK = 8;
+
+private:
+    struct Term {
+        std::string key;    // lowercase name, as spelled along the trie path
+        Completion completion;
+        std::uint32_t node;
+        bool inCatalog = false;   // named by the last catalog added
+        bool added = false;       // added or scored by the caller, not only by a catalog
+    };
+    struct Node {
+        std::string label;                     // the edge from the parent, lowercase
+        std::uint32_t parent;
+        std::vector<std::uint32_t> children;   // ordered by the first byte of their label
+        std::vector<std::uint32_t> terms;      // names ending exactly here
+        std::uint32_t top[kTopK];              // best terms at or below this node
+        std::uint8_t topCount = 0;
+    };
+
+    std::vector<Term> terms;
+    std::vector<Node> nodes;   // nodes[0] is the root, with an empty label
+    std::unordered_map<std::string, std::uint32_t> termIds;   // lowercase name + kind -> term
+    std::vector<std::uint32_t> scratch;
+
+    bool ranksBefore(std::uint32_t a, std::uint32_t b) const;
+    std::uint32_t findChild(const Node& node, char first) const;
+    std::uint32_t insertKey(const std::string& key);
+    bool refreshNode(std::uint32_t node);
+    void refreshPath(std::uint32_t term);
+    void refreshAll();
+    std::uint32_t termFor(const std::string& name, CompletionKind kind, bool& created);
+    void fillCatalog(const RecipeCatalog& catalog);
+    void removeTerm(std::uint32_t term);
+
+public:
+    NameCompleter();
+    // The catalog's recipe names and main ingredients; see addCatalog.
+    explicit NameCompleter(const RecipeCatalog& catalog);
+
+    // Scores each main ingredient by the number of recipes using it and adds the recipe
+    // names, keeping the scores recipes already have (e.g. from the cooking history).
+    void addCatalog(const RecipeCatalog& catalog);
+    // The same for a catalog replacing the one added before: recipes it no longer lists are
+    // dropped, and so are ingredients only the old catalog named. Ingredients added by the
+    // caller stay, scored 0 unless the new catalog uses them.
+    void setCatalog(const RecipeCatalog& catalog);
+    // Adds a name with score 0; a name already known keeps its score.
+    void add(const std::string& name, CompletionKind kind);
+    void setScore(const std::string& name, CompletionKind kind, double score);
+    void addScore(const std::string& name, CompletionKind kind, double delta = 1.0);
+
+    // Up to `limit` (at most kTopK) names starting with the prefix: highest score first,
+    // then alphabetically, with ingredients before recipes of the same name.
+    std::vector<Completion> complete(const std::string& prefix, std::size_t limit = kTopK) const;
+    // The same without copying: `out` points into the completer and is only valid until the
+    // next change. For callers that hold a lock or own the completer.
+    void complete(const std::string& prefix, std::vector<const Completion*>& out, std::size_t limit = kTopK) const;
+    std::size_t size() const;
+};
+
+#endif
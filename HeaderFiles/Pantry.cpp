@@ -1,10 +1,26 @@
 #include "Pantry.h"
+#include <utility>
+
+Pantry::Pantry() : Storage(IngredientLocation::Pantry) {}
 
 void Pantry::addIngredient(const Ingredient& ingredient) {
     Storage::addIngredient(ingredient);
     std::cout << ingredient.getName() << " added to Pantry.\n";
 }
 
+void Pantry::addIngredient(Ingredient&& ingredient) {
+    std::cout << ingredient.getName() << " added to Pantry.\n";
+    Storage::addIngredient(std::move(ingredient));
+}
+
+void Pantry::addIngredients(const Ingredient* items, std::size_t count) {
+    Storage::addIngredients(items, count);
+    if (count == 0) {
+        return;
+    }
+    std::cout << count << (count == 1 ? " ingredient" : " ingredients") << " added to Pantry.\n";
+}
+
 void Pantry::runningLow() const {
     for (const auto& ingredient : ingredients) {
         if (ingredient.getQuantity() < 2) {
@@ -7,7 +7,13 @@
 
 class Pantry : public Storage {
 public:
+    Pantry();
+
     void addIngredient(const Ingredient& ingredient) override;
+    void addIngredient(Ingredient&& ingredient) override;
+    // Prints one line for the whole batch.
+    void addIngredients(const Ingredient* items, std::size_t count) override;
+    using Storage::addIngredients;
 
     void runningLow() const;
 };
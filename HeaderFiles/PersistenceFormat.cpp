@@ -0,0 +1,148 @@
+#include "PersistenceFormat.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// CBOR "self-describe" tag 55799. CBOR decoders ignore it, and it tells CBOR files
+// apart from MessagePack, which has no magic number of its own.
+static const std::uint8_t kCborMagic[] = { 0xd9, 0xd9, 0xf7 };
+
+std::vector<std::uint8_t> encodeDocument(const json& document, PersistenceFormat format) {
+    switch (format) {
+        case PersistenceFormat::Cbor: {
+            std::vector<std::uint8_t> bytes(std::begin(kCborMagic), std::end(kCborMagic));
+            json::to_cbor(document, bytes);
+            return bytes;
+        }
+        case PersistenceFormat::MessagePack:
+            return json::to_msgpack(document);
+        case PersistenceFormat::Json:
+        default: {
+            std::string text = document.dump(4);
+            return std::vector<std::uint8_t>(text.begin(), text.end());
+        }
+    }
+}
+
+PersistenceFormat detectFormat(const std::vector<std::uint8_t>& bytes) {
+    if (bytes.size() >= sizeof(kCborMagic) && std::equal(std::begin(kCborMagic), std::end(kCborMagic), bytes.begin())) {
+        return PersistenceFormat::Cbor;
+    }
+    // Our documents are always a map or an array at the top level.
+    if (!bytes.empty()) {
+        std::uint8_t first = bytes[0];
+        bool fixMapOrArray = first >= 0x80 && first <= 0x9f;
+        bool longMapOrArray = first == 0xdc || first == 0xdd || first == 0xde || first == 0xdf;
+        if (fixMapOrArray || longMapOrArray) {
+            return PersistenceFormat::MessagePack;
+        }
+    }
+    return PersistenceFormat::Json;
+}
+
+json decodeDocument(const std::vector<std::uint8_t>& bytes) {
+    const std::uint8_t* begin = bytes.data();
+    const std::uint8_t* end = bytes.data() + bytes.size();
+    switch (detectFormat(bytes)) {
+        case PersistenceFormat::Cbor:
+            return json::from_cbor(begin + sizeof(kCborMagic), end);
+        case PersistenceFormat::MessagePack:
+            return json::from_msgpack(begin, end);
+        case PersistenceFormat::Json:
+        default:
+            return json::parse(begin, end);
+    }
+}
+
+bool readDocument(const std::string& filename, json& document) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    document = bytes.empty() ? json() : decodeDocument(bytes);
+    return true;
+}
+
+// Flushes a file (or a directory entry) to disk. Without POSIX the OS buffers are the
+// strongest guarantee available, so this does nothing.
+static bool syncPath(const std::string& path, bool directory) {
+#ifdef __unix__
+    int fd = ::open(path.c_str(), directory ? O_RDONLY | O_DIRECTORY : O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#else
+    (void)path;
+    (void)directory;
+    return true;
+#endif
+}
+
+// The document goes to <file>.tmp, which is synced and renamed over the original, so a
+// crash leaves either the old file or the new one and never a truncated one.
+bool writeDocument(const std::string& filename, const json& document, PersistenceFormat format) {
+    std::string tempName = filename + ".tmp";
+    {
+        std::ofstream file(tempName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::vector<std::uint8_t> bytes = encodeDocument(document, format);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.close();
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    if (!syncPath(tempName, false)) {
+        fs::remove(tempName, ec);
+        return false;
+    }
+    fs::rename(tempName, filename, ec);
+    if (ec) {
+        fs::remove(tempName, ec);
+        return false;
+    }
+    fs::path directory = fs::path(filename).parent_path();
+    return syncPath(directory.empty() ? "." : directory.string(), true);
+}
+
+const char* formatName(PersistenceFormat format) {
+    switch (format) {
+        case PersistenceFormat::Cbor: return "cbor";
+        case PersistenceFormat::MessagePack: return "msgpack";
+        case PersistenceFormat::Json:
+        default: return "json";
+    }
+}
+
+bool parseFormatName(const std::string& name, PersistenceFormat& format) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "json") {
+        format = PersistenceFormat::Json;
+    } else if (lower == "cbor") {
+        format = PersistenceFormat::Cbor;
+    } else if (lower == "msgpack" || lower == "messagepack") {
+        format = PersistenceFormat::MessagePack;
+    } else {
+        return false;
+    }
+    return true;
+}
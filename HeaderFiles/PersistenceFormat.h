@@ -0,0 +1,33 @@
+#ifndef PERSISTENCEFORMAT_H
+#define PERSISTENCEFORMAT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../json.hpp"
+
+using json = nlohmann::json;
+
+// On-disk encodings for storage.json and history.json.
+// Json is the original pretty-printed text; the binary formats are smaller and faster
+// to read and write. Loading always detects the format from the file's first bytes.
+enum class PersistenceFormat {
+    Json,
+    Cbor,
+    MessagePack
+};
+
+std::vector<std::uint8_t> encodeDocument(const json& document, PersistenceFormat format);
+PersistenceFormat detectFormat(const std::vector<std::uint8_t>& bytes);
+// Throws json::parse_error if the bytes are not a valid document.
+json decodeDocument(const std::vector<std::uint8_t>& bytes);
+
+// Returns false if the file cannot be opened. An empty file reads as a null document.
+bool readDocument(const std::string& filename, json& document);
+// Replaces the file atomically; returns false, leaving the old file in place, on any failure.
+bool writeDocument(const std::string& filename, const json& document, PersistenceFormat format);
+
+const char* formatName(PersistenceFormat format);
+bool parseFormatName(const std::string& name, PersistenceFormat& format);
+
+#endif
@@ -1,36 +1,44 @@
 #include "Recipe.h"
+#include "IngredientAliases.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 
 Recipe::Recipe(std::string name, 
            std::vector<std::pair<std::string, std::string>> ingredients, 
            std::vector<std::pair<std::string, std::string>> condiments, 
-           std::vector<std::string> steps, std::string type)
-    : recipeName(name), requiredIngredients(ingredients), condiments(condiments), steps(steps), category(type) {}
+           std::vector<std::string> steps, std::string type, int timeMinutes)
+    : recipeName(std::move(name)), requiredIngredients(std::move(ingredients)), condiments(std::move(condiments)), steps(std::move(steps)), category(std::move(type)),
+      timeMinutes(timeMinutes < 0 ? kUnknownTime : static_cast<std::uint16_t>(std::min(timeMinutes, kUnknownTime - 1))) {}
 
-std::string Recipe::getRecipeName() const {
+const std::string& Recipe::getRecipeName() const {
     return recipeName;
 }
 
-std::string Recipe::getType() const {
+const std::string& Recipe::getType() const {
     return category;
 }
 
+int Recipe::getTimeMinutes() const {
+    return timeMinutes == kUnknownTime ? -1 : timeMinutes;
+}
+
 bool Recipe::canMakeRecipe(const std::vector<Ingredient>& userIngredients, std::vector<std::string>& missingIngredients) const {
     bool hasAllMainIngredients = true;
 
+    // Compared by canonical name, so "eggs" matches "egg" and "cheddar cheese" matches "cheese".
+    std::shared_ptr<const IngredientAliases> aliases = IngredientAliases::current();
+    std::vector<std::string> userNames;
+    userNames.reserve(userIngredients.size());
+    for (const auto& userIngredient : userIngredients) {
+        userNames.push_back(aliases->canonical(userIngredient.getName()));
+    }
+
+    std::string recipeIngredientName;
     for (const auto& reqIngredient : requiredIngredients) {
-        bool found = false;
-        for (const auto& userIngredient : userIngredients) {
-            std::string recipeIngredientName = reqIngredient.first;
-            std::string userIngredientName = userIngredient.getName();
-            std::transform(recipeIngredientName.begin(), recipeIngredientName.end(), recipeIngredientName.begin(), ::tolower);
-            std::transform(userIngredientName.begin(), userIngredientName.end(), userIngredientName.begin(), ::tolower);
-
-            if (userIngredientName == recipeIngredientName) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
+        aliases->canonical(reqIngredient.first.data(), reqIngredient.first.size(), recipeIngredientName);
+        if (std::find(userNames.begin(), userNames.end(), recipeIngredientName) == userNames.end()) {
             missingIngredients.push_back(reqIngredient.first);
             hasAllMainIngredients = false;
         }
@@ -39,57 +47,171 @@ bool Recipe::canMakeRecipe(const std::vector<Ingredient>& userIngredients, std::
     return hasAllMainIngredients;
 }
 
-std::vector<std::pair<std::string, std::string>> Recipe::getRequiredIngredients() const {
+const std::vector<std::pair<std::string, std::string>>& Recipe::getRequiredIngredients() const {
     return requiredIngredients;
 }
 
-std::vector<std::pair<std::string, std::string>> Recipe::getCondiments() const {
+const std::vector<std::pair<std::string, std::string>>& Recipe::getCondiments() const {
     return condiments;
 }
 
-std::vector<std::string> Recipe::getSteps() const {
+const std::vector<std::string>& Recipe::getSteps() const {
     return steps;
 }
 
-std::vector<Recipe> loadRecipesFromJSON(const std::string& filename) {
-    std::vector<Recipe> recipes;
+// Builds "<quantity> <unit>" in place, reusing the quantity string's buffer.
+static std::string takeAmount(json& item) {
+    std::string amount = std::move(item["quantity"].get_ref<std::string&>());
+    const std::string& unit = item["unit"].get_ref<const std::string&>();
+    amount.reserve(amount.size() + 1 + unit.size());
+    amount += ' ';
+    amount += unit;
+    return amount;
+}
 
-    std::ifstream inputFile(filename);
-    if (!inputFile.is_open()) {
-        std::cerr << "Could not open the file: " << filename << std::endl;
-        return recipes;
+static std::vector<std::pair<std::string, std::string>> takeAmounts(json& items) {
+    std::vector<std::pair<std::string, std::string>> result;
+    result.reserve(items.size());
+    for (auto& item : items) {
+        result.emplace_back(std::move(item["name"].get_ref<std::string&>()), takeAmount(item));
     }
+    return result;
+}
 
-    json j;
-    inputFile >> j;
-
-    for (const auto& recipeData : j["recipes"]) {
-        std::string recipeName = recipeData["name"];
-        std::string category = recipeData["category"];
-        std::vector<std::pair<std::string, std::string>> ingredients;
-        std::vector<std::pair<std::string, std::string>> condiments;
-        std::vector<std::string> steps;
-
-        for (const auto& ingredient : recipeData["ingredients"]) {
-            std::string name = ingredient["name"];
-            std::string quantity = ingredient["quantity"];
-            std::string unit = ingredient["unit"];
-            ingredients.push_back({ name, quantity + " " + unit });
+// Reads "<integer or decimal>" or "<a>/<b>" starting at i; false if there is no number there.
+static bool readNumber(const std::string& text, std::size_t& i, double& value) {
+    std::size_t start = i;
+    while (i < text.size() && (std::isdigit(static_cast<unsigned char>(text[i])) || text[i] == '.')) {
+        ++i;
+    }
+    if (i == start) {
+        return false;
+    }
+    value = std::atof(text.substr(start, i - start).c_str());
+    if (i + 1 < text.size() && text[i] == '/' && std::isdigit(static_cast<unsigned char>(text[i + 1]))) {
+        std::size_t denominatorStart = ++i;
+        while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]))) {
+            ++i;
         }
+        double denominator = std::atof(text.substr(denominatorStart, i - denominatorStart).c_str());
+        value = denominator > 0 ? value / denominator : 0.0;
+    }
+    return true;
+}
 
-        for (const auto& condiment : recipeData["condiments"]) {
-            std::string name = condiment["name"];
-            std::string quantity = condiment["quantity"];
-            std::string unit = condiment["unit"];
-            condiments.push_back({ name, quantity + " " + unit });
+int parseMinutes(const std::string& text) {
+    double total = 0.0;
+    bool found = false;
+    std::size_t i = 0;
+    while (i < text.size()) {
+        double value = 0.0;
+        if (!std::isdigit(static_cast<unsigned char>(text[i])) || !readNumber(text, i, value)) {
+            ++i;
+            continue;
+        }
+        while (i < text.size() && text[i] == ' ') {
+            ++i;
+        }
+        // A mixed number such as "1 1/2 hours".
+        double fraction = 0.0;
+        std::size_t afterFraction = i;
+        if (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i])) && readNumber(text, afterFraction, fraction) &&
+            text.find('/', i) < afterFraction) {
+            value += fraction;
+            i = afterFraction;
+            while (i < text.size() && text[i] == ' ') {
+                ++i;
+            }
         }
+        bool hours = i < text.size() && std::tolower(static_cast<unsigned char>(text[i])) == 'h';
+        total = std::min(total + (hours ? value * 60.0 : value), 1000000.0);
+        found = true;
+    }
+    return found ? static_cast<int>(std::lround(total)) : -1;
+}
 
-        for (const auto& step : recipeData["steps"]) {
-            steps.push_back(step);
+double parseAmount(const std::string& amount) {
+    std::size_t i = 0;
+    while (i < amount.size() && amount[i] == ' ') {
+        ++i;
+    }
+    double value = 0.0;
+    if (!readNumber(amount, i, value)) {
+        return 0.0;
+    }
+    // A mixed number such as "1 1/2".
+    std::size_t next = i;
+    while (next < amount.size() && amount[next] == ' ') {
+        ++next;
+    }
+    double fraction = 0.0;
+    std::size_t afterFraction = next;
+    if (next > i && readNumber(amount, afterFraction, fraction) && amount.find('/', next) < afterFraction) {
+        value += fraction;
+    }
+    return value;
+}
+
+static const char* const kMeasureUnits[] = { "c", "cup", "cups", "dash", "g", "gram", "grams", "kg", "l", "lb", "lbs",
+                                             "liter", "liters", "litre", "litres", "mg", "ml", "ounce", "ounces", "oz",
+                                             "pinch", "pound", "pounds", "tablespoon", "tablespoons", "tbsp", "teaspoon",
+                                             "teaspoons", "tsp" };
+
+bool isMeasuredAmount(const std::string& amount) {
+    std::size_t i = 0;
+    while (i < amount.size() && !std::isalpha(static_cast<unsigned char>(amount[i]))) {
+        ++i;
+    }
+    // Only a unit after a number counts; "a pinch" has no amount to take.
+    if (parseAmount(amount) <= 0.0) {
+        return false;
+    }
+    std::string unit;
+    while (i < amount.size() && std::isalpha(static_cast<unsigned char>(amount[i]))) {
+        unit += static_cast<char>(std::tolower(static_cast<unsigned char>(amount[i++])));
+    }
+    return std::find_if(std::begin(kMeasureUnits), std::end(kMeasureUnits),
+                        [&](const char* known) { return unit == known; }) != std::end(kMeasureUnits);
+}
+
+double stockNeeded(const std::string& amount) {
+    double value = parseAmount(amount);
+    return isMeasuredAmount(amount) ? value : std::ceil(value - 1e-9);
+}
+
+std::vector<Recipe> parseRecipesFromJSON(json& j) {
+    std::vector<Recipe> recipes;
+
+    // The parsed document is a scratch buffer: every string is moved out of it
+    // and into the Recipe, so nothing is copied after parsing.
+    json& recipeArray = j["recipes"];
+    recipes.reserve(recipeArray.size());
+    for (auto& recipeData : recipeArray) {
+        std::vector<std::string> steps;
+        steps.reserve(recipeData["steps"].size());
+        for (auto& step : recipeData["steps"]) {
+            steps.push_back(std::move(step.get_ref<std::string&>()));
         }
 
-        recipes.emplace_back(recipeName, ingredients, condiments, steps, category);
+        recipes.emplace_back(std::move(recipeData["name"].get_ref<std::string&>()),
+                             takeAmounts(recipeData["ingredients"]),
+                             takeAmounts(recipeData["condiments"]),
+                             std::move(steps),
+                             std::move(recipeData["category"].get_ref<std::string&>()),
+                             parseMinutes(recipeData.value("time", "")));
     }
 
     return recipes;
 }
+
+std::vector<Recipe> loadRecipesFromJSON(const std::string& filename) {
+    std::ifstream inputFile(filename);
+    if (!inputFile.is_open()) {
+        std::cerr << "Could not open the file: " << filename << std::endl;
+        return {};
+    }
+
+    json j;
+    inputFile >> j;
+    return parseRecipesFromJSON(j);
+}
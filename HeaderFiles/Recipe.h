@@ -1,6 +1,7 @@
 #ifndef RECIPE_H
 #define RECIPE_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <utility>
@@ -22,21 +23,43 @@ private:
     std::vector<std::pair<std::string, std::string>> condiments;
     std::vector<std::string> steps;
     std::string category;
+    std::uint16_t timeMinutes;   // kUnknownTime if the recipe file did not give one
+
+    static constexpr std::uint16_t kUnknownTime = 0xffff;
 
 public:
     Recipe(std::string name, 
            std::vector<std::pair<std::string, std::string>> ingredients, 
            std::vector<std::pair<std::string, std::string>> condiments, 
-           std::vector<std::string> steps, std::string type);
+           std::vector<std::string> steps, std::string type, int timeMinutes = -1);
 
-    std::string getRecipeName() const;
-    std::string getType() const;
+    const std::string& getRecipeName() const;
+    const std::string& getType() const;
+    // Preparation time in minutes, or -1 if the recipe file did not give one.
+    // Times are kept to 16 bits; anything longer than about 45 days is clamped.
+    int getTimeMinutes() const;
+    // Ingredient names are compared by their canonical form (see IngredientAliases).
     bool canMakeRecipe(const std::vector<Ingredient>& userIngredients, std::vector<std::string>& missingIngredients) const;
-    std::vector<std::pair<std::string, std::string>> getRequiredIngredients() const;
-    std::vector<std::pair<std::string, std::string>> getCondiments() const;
-    std::vector<std::string> getSteps() const;
+    const std::vector<std::pair<std::string, std::string>>& getRequiredIngredients() const;
+    const std::vector<std::pair<std::string, std::string>>& getCondiments() const;
+    const std::vector<std::string>& getSteps() const;
 };
 
+// Parses durations such as "25 minutes", "1 hour", "1 hour 30 minutes", "1.5 hours" or
+// "1 1/2 hours", rounded to whole minutes; -1 if there is no number.
+int parseMinutes(const std::string& text);
+// The number at the start of a recipe amount: "2 pieces" -> 2, "1/2 cup" -> 0.5, "1 1/2" -> 1.5.
+// Amounts without a number ("to taste", "optional") give 0.
+double parseAmount(const std::string& amount);
+// Whether the amount is a weight or volume ("200 g", "1/2 cup", "2 tablespoons") rather than
+// a count ("3", "2 slices", "1 large").
+bool isMeasuredAmount(const std::string& amount);
+// How much of a stored item the amount takes; cooking and meal planning both go by this.
+// Stock is kept in the units recipes use (storage.json has ground beef as 200 for "200 g"),
+// so a weight or volume takes its number as is and a count is rounded up to whole items
+// ("1 1/2 slices" takes 2). "to taste" takes nothing, though the item must be there.
+double stockNeeded(const std::string& amount);
+std::vector<Recipe> parseRecipesFromJSON(json& j);
 std::vector<Recipe> loadRecipesFromJSON(const std::string& filename);
 
 #endif
@@ -0,0 +1,434 @@
+#include "RecipeCatalog.h"
+#include "RecipeDeduplication.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+RecipeCatalog::RecipeCatalog() : aliases(IngredientAliases::current()) {}
+
+RecipeCatalog::RecipeCatalog(std::vector<Recipe> recipeList, std::shared_ptr<const IngredientAliases> aliasTable)
+    : aliases(std::move(aliasTable)) {
+    recipes.reserve(recipeList.size());
+    growNameSlots(recipeList.size() * 2);
+    for (auto& recipe : recipeList) {
+        addRecipe(std::move(recipe));
+    }
+    partitionByCategory();
+    indexIngredients();
+    indexTimes();
+    searchIndex = RecipeSearchIndex(recipes);
+}
+
+void RecipeCatalog::indexIngredients() {
+    recipeIngredientOffsets.reserve(recipes.size() + 1);
+    recipeIngredientOffsets.push_back(0);
+    std::string key;
+    for (const auto& recipe : recipes) {
+        for (const auto& ingredient : recipe.getRequiredIngredients()) {
+            aliases->canonical(ingredient.first.data(), ingredient.first.size(), key);
+            auto inserted = ingredientIds.emplace(key, static_cast<IngredientId>(ingredientNames.size()));
+            if (inserted.second) {
+                std::string name = ingredient.first;
+                std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+                ingredientNames.push_back(std::move(name));
+            }
+            recipeIngredients.push_back(inserted.first->second);
+        }
+        recipeIngredientOffsets.push_back(static_cast<std::uint32_t>(recipeIngredients.size()));
+    }
+
+    // Counting sort into per-ingredient posting lists; walking recipes in order keeps each list ascending.
+    postingOffsets.assign(ingredientNames.size() + 1, 0);
+    for (IngredientId id : recipeIngredients) {
+        ++postingOffsets[id + 1];
+    }
+    for (std::size_t i = 1; i < postingOffsets.size(); ++i) {
+        postingOffsets[i] += postingOffsets[i - 1];
+    }
+    postings.assign(recipeIngredients.size(), 0);
+    std::vector<std::uint32_t> fill(postingOffsets.begin(), postingOffsets.end() - 1);
+    for (std::uint32_t recipeId = 0; recipeId < recipes.size(); ++recipeId) {
+        for (IngredientId id : getRecipeIngredients(recipeId)) {
+            // A recipe listing the same ingredient twice appears once in its posting list.
+            bool alreadyListed = fill[id] > postingOffsets[id] && postings[fill[id] - 1] == recipeId;
+            if (!alreadyListed) {
+                postings[fill[id]++] = recipeId;
+            }
+        }
+    }
+    // Drop the slots left unused by duplicate listings.
+    std::vector<std::uint32_t> compacted;
+    compacted.reserve(postings.size());
+    std::vector<std::uint32_t> offsets(1, 0);
+    for (std::size_t id = 0; id < ingredientNames.size(); ++id) {
+        compacted.insert(compacted.end(), postings.begin() + postingOffsets[id], postings.begin() + fill[id]);
+        offsets.push_back(static_cast<std::uint32_t>(compacted.size()));
+    }
+    postings = std::move(compacted);
+    postingOffsets = std::move(offsets);
+}
+
+// Category names are parsed once here; queries then only compare small integer ids.
+void RecipeCatalog::partitionByCategory() {
+    std::vector<CategoryId> ids;
+    ids.reserve(recipes.size());
+    for (const auto& recipe : recipes) {
+        ids.push_back(categories.intern(recipe.getType()));
+    }
+
+    std::vector<std::size_t> order(recipes.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return ids[a] < ids[b]; });
+
+    std::vector<Recipe> sorted;
+    sorted.reserve(recipes.size());
+    recipeCategories.clear();
+    recipeCategories.reserve(recipes.size());
+    partitions.assign(categories.size(), Partition{ 0, 0 });
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        CategoryId category = ids[order[i]];
+        if (i == 0 || category != recipeCategories.back()) {
+            partitions[category].begin = i;
+        }
+        partitions[category].end = i + 1;
+        recipeCategories.push_back(category);
+        sorted.push_back(std::move(recipes[order[i]]));
+    }
+    recipes = std::move(sorted);
+
+    // Ids changed, so rebuild the name table.
+    std::fill(nameSlots.begin(), nameSlots.end(), 0);
+    for (std::size_t id = 0; id < recipes.size(); ++id) {
+        nameSlots[slotFor(recipes[id].getRecipeName())] = static_cast<std::uint32_t>(id + 1);
+    }
+}
+
+void RecipeCatalog::indexTimes() {
+    recipesByTime.clear();
+    for (std::uint32_t id = 0; id < recipes.size(); ++id) {
+        if (recipes[id].getTimeMinutes() >= 0) {
+            recipesByTime.push_back(id);
+        }
+    }
+    std::stable_sort(recipesByTime.begin(), recipesByTime.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return recipes[a].getTimeMinutes() < recipes[b].getTimeMinutes();
+    });
+    sortedTimes.clear();
+    sortedTimes.reserve(recipesByTime.size());
+    for (std::uint32_t id : recipesByTime) {
+        sortedTimes.push_back(static_cast<std::uint16_t>(recipes[id].getTimeMinutes()));
+    }
+}
+
+// Linear probing; the table is kept at most half full, so probe runs stay short.
+std::size_t RecipeCatalog::slotFor(const std::string& name) const {
+    std::size_t mask = nameSlots.size() - 1;
+    for (std::size_t slot = std::hash<std::string>{}(name) & mask; ; slot = (slot + 1) & mask) {
+        std::uint32_t entry = nameSlots[slot];
+        if (entry == 0 || recipes[entry - 1].getRecipeName() == name) {
+            return slot;
+        }
+    }
+}
+
+void RecipeCatalog::growNameSlots(std::size_t minimumSlots) {
+    std::size_t slots = 16;
+    while (slots < minimumSlots) {
+        slots *= 2;
+    }
+    if (slots <= nameSlots.size()) {
+        return;
+    }
+
+    nameSlots.assign(slots, 0);
+    for (std::size_t id = 0; id < recipes.size(); ++id) {
+        nameSlots[slotFor(recipes[id].getRecipeName())] = static_cast<std::uint32_t>(id + 1);
+    }
+}
+
+bool RecipeCatalog::addRecipe(Recipe&& recipe) {
+    growNameSlots((recipes.size() + 1) * 2);
+    std::size_t slot = slotFor(recipe.getRecipeName());
+    if (nameSlots[slot] != 0) {
+        return false;
+    }
+    recipes.push_back(std::move(recipe));
+    nameSlots[slot] = static_cast<std::uint32_t>(recipes.size());
+    return true;
+}
+
+std::size_t RecipeCatalog::idOf(const std::string& name) const {
+    if (nameSlots.empty()) {
+        return npos;
+    }
+    std::uint32_t entry = nameSlots[slotFor(name)];
+    return entry == 0 ? npos : entry - 1;
+}
+
+const Recipe* RecipeCatalog::findByName(const std::string& name) const {
+    return findById(idOf(name));
+}
+
+const Recipe* RecipeCatalog::findById(std::size_t id) const {
+    return id < recipes.size() ? &recipes[id] : nullptr;
+}
+
+const std::vector<Recipe>& RecipeCatalog::getRecipes() const {
+    return recipes;
+}
+
+std::vector<const Recipe*> RecipeCatalog::findMakeable(const std::vector<Ingredient>& userIngredients, const std::string& category) const {
+    if (category.empty()) {
+        std::vector<const Recipe*> makeable;
+        for (CategoryId id = 0; id < partitions.size(); ++id) {
+            std::vector<const Recipe*> found = findMakeable(userIngredients, id);
+            makeable.insert(makeable.end(), found.begin(), found.end());
+        }
+        return makeable;
+    }
+    return findMakeable(userIngredients, categories.find(category));
+}
+
+std::vector<const Recipe*> RecipeCatalog::findMakeable(const std::vector<Ingredient>& userIngredients, CategoryId category) const {
+    // Names are canonicalized once per inventory item here rather than once per recipe.
+    std::vector<char> inStock(ingredientNames.size(), 0);
+    for (const auto& ingredient : userIngredients) {
+        IngredientId id = findIngredient(ingredient.getName());
+        if (id != kNoIngredient) {
+            inStock[id] = 1;
+        }
+    }
+    return findMakeable(inStock, category);
+}
+
+std::vector<const Recipe*> RecipeCatalog::findMakeable(const std::vector<char>& available, CategoryId category) const {
+    std::vector<const Recipe*> makeable;
+    Partition partition = getPartition(category);
+    for (std::size_t id = partition.begin; id < partition.end; ++id) {
+        IdRange needed = getRecipeIngredients(id);
+        if (std::all_of(needed.begin(), needed.end(), [&](IngredientId need) { return need < available.size() && available[need] != 0; })) {
+            makeable.push_back(&recipes[id]);
+        }
+    }
+    return makeable;
+}
+
+std::vector<const Recipe*> RecipeCatalog::findMakeableWithin(const std::vector<Ingredient>& userIngredients, int maxMinutes) const {
+    std::vector<char> inStock(ingredientNames.size(), 0);
+    for (const auto& ingredient : userIngredients) {
+        IngredientId id = findIngredient(ingredient.getName());
+        if (id != kNoIngredient) {
+            inStock[id] = 1;
+        }
+    }
+
+    // Only the recipes inside the time range are checked against the inventory.
+    std::vector<const Recipe*> makeable;
+    for (std::uint32_t recipeId : getRecipesByTime(0, maxMinutes)) {
+        IdRange needed = getRecipeIngredients(recipeId);
+        if (std::all_of(needed.begin(), needed.end(), [&](IngredientId id) { return inStock[id] != 0; })) {
+            makeable.push_back(&recipes[recipeId]);
+        }
+    }
+    return makeable;
+}
+
+IdRange RecipeCatalog::getRecipesByTime(int minMinutes, int maxMinutes) const {
+    if (maxMinutes < 0 || maxMinutes < minMinutes) {
+        return IdRange{ nullptr, nullptr };
+    }
+    auto first = std::lower_bound(sortedTimes.begin(), sortedTimes.end(), std::max(minMinutes, 0));
+    auto last = std::upper_bound(first, sortedTimes.end(), maxMinutes);
+    const std::uint32_t* base = recipesByTime.data();
+    return IdRange{ base + (first - sortedTimes.begin()), base + (last - sortedTimes.begin()) };
+}
+
+const CategoryRegistry& RecipeCatalog::getCategories() const {
+    return categories;
+}
+
+CategoryId RecipeCatalog::getCategoryId(std::size_t recipeId) const {
+    return recipeCategories.at(recipeId);
+}
+
+RecipeCatalog::Partition RecipeCatalog::getPartition(CategoryId category) const {
+    return category < partitions.size() ? partitions[category] : Partition{ 0, 0 };
+}
+
+std::vector<const Recipe*> RecipeCatalog::search(const std::string& query, std::size_t limit) const {
+    std::vector<const Recipe*> found;
+    for (const auto& result : searchIndex.search(query, limit)) {
+        found.push_back(&recipes[result.recipeId]);
+    }
+    return found;
+}
+
+const RecipeSearchIndex& RecipeCatalog::getSearchIndex() const {
+    return searchIndex;
+}
+
+IngredientId RecipeCatalog::findIngredient(const std::string& name) const {
+    thread_local std::string key;
+    aliases->canonical(name.data(), name.size(), key);
+    auto it = ingredientIds.find(key);
+    return it == ingredientIds.end() ? kNoIngredient : it->second;
+}
+
+const IngredientAliases& RecipeCatalog::getAliases() const {
+    return *aliases;
+}
+
+std::shared_ptr<const IngredientAliases> RecipeCatalog::getAliasTable() const {
+    return aliases;
+}
+
+const std::string& RecipeCatalog::getIngredientName(IngredientId id) const {
+    return ingredientNames.at(id);
+}
+
+std::size_t RecipeCatalog::ingredientCount() const {
+    return ingredientNames.size();
+}
+
+IdRange RecipeCatalog::getRecipeIngredients(std::size_t recipeId) const {
+    const std::uint32_t* base = recipeIngredients.data();
+    return IdRange{ base + recipeIngredientOffsets[recipeId], base + recipeIngredientOffsets[recipeId + 1] };
+}
+
+IdRange RecipeCatalog::getRecipesUsing(IngredientId id) const {
+    if (id >= ingredientNames.size()) {
+        return IdRange{ nullptr, nullptr };
+    }
+    const std::uint32_t* base = postings.data();
+    return IdRange{ base + postingOffsets[id], base + postingOffsets[id + 1] };
+}
+
+std::size_t RecipeCatalog::size() const {
+    return recipes.size();
+}
+
+bool RecipeCatalog::empty() const {
+    return recipes.empty();
+}
+
+// Matches '*' and '?' wildcards against a file name.
+static bool wildcardMatch(const char* pattern, const char* text) {
+    const char* starPattern = nullptr;
+    const char* starText = nullptr;
+    while (*text) {
+        if (*pattern == '*') {
+            starPattern = pattern++;
+            starText = text;
+        } else if (*pattern == '?' || *pattern == *text) {
+            ++pattern;
+            ++text;
+        } else if (starPattern) {
+            pattern = starPattern + 1;
+            text = ++starText;
+        } else {
+            return false;
+        }
+    }
+    while (*pattern == '*') {
+        ++pattern;
+    }
+    return *pattern == '\0';
+}
+
+std::vector<std::string> findRecipeShards(const std::string& source) {
+    std::vector<std::string> shards;
+    std::error_code ec;
+
+    fs::path directory;
+    std::string pattern;
+    if (source.find_first_of("*?") != std::string::npos) {
+        fs::path sourcePath(source);
+        directory = sourcePath.has_parent_path() ? sourcePath.parent_path() : fs::path(".");
+        pattern = sourcePath.filename().string();
+    } else if (fs::is_directory(source, ec)) {
+        directory = source;
+        pattern = "*.json";
+    } else {
+        shards.push_back(source);
+        return shards;
+    }
+
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec) && wildcardMatch(pattern.c_str(), it->path().filename().string().c_str())) {
+            shards.push_back(it->path().string());
+        }
+    }
+    if (ec) {
+        std::cerr << "Could not read recipe directory: " << directory.string() << "\n";
+    }
+
+    std::sort(shards.begin(), shards.end());
+    return shards;
+}
+
+static std::vector<Recipe> loadShard(const std::string& filename) {
+    std::ifstream inputFile(filename);
+    if (!inputFile.is_open()) {
+        std::cerr << "Could not open the file: " << filename << "\n";
+        return {};
+    }
+
+    try {
+        json j;
+        inputFile >> j;
+        return parseRecipesFromJSON(j);
+    } catch (json::exception& e) {
+        std::cerr << "Skipping malformed recipe shard " << filename << ": " << e.what() << "\n";
+        return {};
+    }
+}
+
+RecipeCatalog loadRecipeCatalog(const std::string& source, unsigned threadCount, DedupReport* report,
+                                std::shared_ptr<const IngredientAliases> aliases) {
+    std::vector<std::string> shards = findRecipeShards(source);
+    std::vector<std::vector<Recipe>> parsed(shards.size());
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, shards.size()));
+
+    // Each worker claims the next unparsed shard, so a few large shards don't leave the other threads idle.
+    std::atomic<std::size_t> nextShard{0};
+    auto worker = [&]() {
+        for (std::size_t i = nextShard++; i < shards.size(); i = nextShard++) {
+            parsed[i] = loadShard(shards[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    // One pass in shard order, so the recipe kept from a group of duplicates does not depend
+    // on the thread count.
+    RecipeDeduplicator deduplicator(DedupOptions(), aliases);
+    for (auto& shard : parsed) {
+        for (auto& recipe : shard) {
+            deduplicator.add(std::move(recipe));
+        }
+        std::vector<Recipe>().swap(shard);
+    }
+    if (report) {
+        *report = deduplicator.getReport();
+    }
+    return RecipeCatalog(deduplicator.release(), std::move(aliases));
+}
@@ -0,0 +1,138 @@
+#ifndef RECIPECATALOG_H
+#define RECIPECATALOG_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Recipe.h"
+#include "Ingredient.h"
+#include "RecipeSearchIndex.h"
+#include "RecipeCategory.h"
+#include "IngredientAliases.h"
+
+using IngredientId = std::uint32_t;
+
+struct DedupReport;
+
+// A read-only view of a run of ids stored inside the catalog.
+struct IdRange {
+    const std::uint32_t* first;
+    const std::uint32_t* last;
+
+    const std::uint32_t* begin() const { return first; }
+    const std::uint32_t* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// The full set of recipes known to the program, indexed by recipe name.
+// A catalog can be built from one recipes.json or from many shard files.
+class RecipeCatalog {
+public:
+    // A half-open range of recipe ids.
+    struct Partition {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+private:
+    // Stored grouped by category, so each category is one contiguous Partition.
+    std::vector<Recipe> recipes;
+    std::vector<CategoryId> recipeCategories;
+    std::vector<Partition> partitions;   // indexed by CategoryId
+    CategoryRegistry categories;
+
+    // Main-ingredient vocabulary and the two directions of the recipe <-> ingredient
+    // relation, each stored as offsets into one flat array. Ingredients are told apart by
+    // their canonical name under `aliases` (the table the catalog was built with);
+    // ingredientNames keeps the first spelling seen, lower-cased, for display.
+    std::shared_ptr<const IngredientAliases> aliases;
+    std::vector<std::string> ingredientNames;
+    std::unordered_map<std::string, IngredientId> ingredientIds;   // canonical name -> id
+    std::vector<std::uint32_t> recipeIngredientOffsets;
+    std::vector<IngredientId> recipeIngredients;
+    std::vector<std::uint32_t> postingOffsets;
+    std::vector<std::uint32_t> postings;        // recipe ids per ingredient, ascending
+    // Recipes with a known preparation time, quickest first, and their times in the same order.
+    std::vector<std::uint32_t> recipesByTime;
+    std::vector<std::uint16_t> sortedTimes;
+    // Open-addressing name -> id table holding id + 1 (0 = empty slot). Names are compared
+    // against the recipes themselves, so no second copy of every name is kept.
+    std::vector<std::uint32_t> nameSlots;
+    RecipeSearchIndex searchIndex;
+
+    std::size_t slotFor(const std::string& name) const;
+    void growNameSlots(std::size_t minimumSlots);
+    void partitionByCategory();
+    void indexIngredients();
+    void indexTimes();
+
+    // Returns false (and drops the recipe) if one with the same name is already present.
+    bool addRecipe(Recipe&& recipe);
+
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr IngredientId kNoIngredient = 0xffffffff;
+
+    RecipeCatalog();
+    // Indexes are built here, once; a catalog never changes after construction.
+    // Ingredient names are compared under `aliases`.
+    explicit RecipeCatalog(std::vector<Recipe> recipes,
+                           std::shared_ptr<const IngredientAliases> aliases = IngredientAliases::current());
+
+    const std::vector<Recipe>& getRecipes() const;
+    // A recipe's id is its position in getRecipes(). Ids are only stable for one catalog
+    // version, so anything stored across reloads should also keep the name.
+    std::size_t idOf(const std::string& name) const;
+    const Recipe* findByName(const std::string& name) const;
+    const Recipe* findById(std::size_t id) const;
+
+    const CategoryRegistry& getCategories() const;
+    CategoryId getCategoryId(std::size_t recipeId) const;
+    // The recipes of one category; empty for categories with no recipes.
+    Partition getPartition(CategoryId category) const;
+
+    // Matches any spelling with the same canonical name ("Eggs" finds "egg"); kNoIngredient
+    // if no recipe uses the ingredient.
+    IngredientId findIngredient(const std::string& name) const;
+    const IngredientAliases& getAliases() const;
+    // The same table, for indexes built over the catalog to keep.
+    std::shared_ptr<const IngredientAliases> getAliasTable() const;
+    const std::string& getIngredientName(IngredientId id) const;
+    std::size_t ingredientCount() const;
+    // The main ingredients of a recipe, in recipe order.
+    IdRange getRecipeIngredients(std::size_t recipeId) const;
+    // The recipes that use an ingredient, ascending by id.
+    IdRange getRecipesUsing(IngredientId id) const;
+    // Recipes taking between minMinutes and maxMinutes (inclusive), quickest first.
+    // Recipes without a time are never included.
+    IdRange getRecipesByTime(int minMinutes, int maxMinutes) const;
+    // Recipes whose main ingredients are all in userIngredients. An empty category matches every recipe.
+    std::vector<const Recipe*> findMakeable(const std::vector<Ingredient>& userIngredients, const std::string& category = "") const;
+    std::vector<const Recipe*> findMakeable(const std::vector<Ingredient>& userIngredients, CategoryId category) const;
+    // The same, from a bitset indexed by IngredientId (e.g. SubstitutionClosure::getAvailable()).
+    std::vector<const Recipe*> findMakeable(const std::vector<char>& available, CategoryId category) const;
+    // Makeable recipes that take at most maxMinutes, quickest first.
+    std::vector<const Recipe*> findMakeableWithin(const std::vector<Ingredient>& userIngredients, int maxMinutes) const;
+    // Full-text search over names, steps and condiments, best match first.
+    std::vector<const Recipe*> search(const std::string& query, std::size_t limit = 10) const;
+    const RecipeSearchIndex& getSearchIndex() const;
+
+    std::size_t size() const;
+    bool empty() const;
+};
+
+// Expands a recipes.json path, a directory of shards, or a "dir/*.json" style pattern
+// into the list of shard files, sorted by path.
+std::vector<std::string> findRecipeShards(const std::string& source);
+
+// Parses every shard on a pool of threadCount workers (0 = one per core) and merges them.
+// When two shards define the same recipe name, the shard that sorts first wins. Duplicate
+// recipes are merged (see RecipeDeduplicator); `report`, if given, lists them. Ingredient
+// names are compared under `aliases`, both when merging and in the catalog.
+RecipeCatalog loadRecipeCatalog(const std::string& source, unsigned threadCount = 0, DedupReport* report = nullptr,
+                                std::shared_ptr<const IngredientAliases> aliases = IngredientAliases::current());
+
+#endif
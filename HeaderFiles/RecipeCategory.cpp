@@ -0,0 +1,35 @@
+#include "RecipeCategory.h"
+#include <algorithm>
+#include <cctype>
+
+static std::string lowerCase(const std::string& text) {
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower;
+}
+
+CategoryRegistry::CategoryRegistry() {
+    intern("Sweet");
+    intern("Savory");
+}
+
+CategoryId CategoryRegistry::intern(const std::string& name) {
+    auto inserted = ids.emplace(lowerCase(name), static_cast<CategoryId>(names.size()));
+    if (inserted.second) {
+        names.push_back(name);
+    }
+    return inserted.first->second;
+}
+
+CategoryId CategoryRegistry::find(const std::string& name) const {
+    auto it = ids.find(lowerCase(name));
+    return it == ids.end() ? kUnknown : it->second;
+}
+
+const std::string& CategoryRegistry::getName(CategoryId id) const {
+    return names.at(id);
+}
+
+std::size_t CategoryRegistry::size() const {
+    return names.size();
+}
@@ -0,0 +1,40 @@
+#ifndef RECIPECATEGORY_H
+#define RECIPECATEGORY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using CategoryId = std::uint16_t;
+
+// The categories the menu asks about have fixed ids, so code can name them at compile time.
+// Any other category found in the recipe files (e.g. a cuisine) is given the next free id.
+enum class Category : CategoryId {
+    Sweet = 0,
+    Savory = 1,
+    FirstCustom = 2
+};
+
+constexpr CategoryId toId(Category category) {
+    return static_cast<CategoryId>(category);
+}
+
+// Maps category names (case-insensitively) to small integer ids.
+class CategoryRegistry {
+private:
+    std::vector<std::string> names;                 // id -> name as first spelled
+    std::unordered_map<std::string, CategoryId> ids; // lower-cased name -> id
+
+public:
+    static constexpr CategoryId kUnknown = 0xffff;
+
+    CategoryRegistry();
+
+    CategoryId intern(const std::string& name);
+    CategoryId find(const std::string& name) const;  // kUnknown if never interned
+    const std::string& getName(CategoryId id) const;
+    std::size_t size() const;
+};
+
+#endif
@@ -0,0 +1,240 @@
+#include "RecipeDeduplication.h"
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RECIPEDEDUPLICATION_SSE2 1
+#endif
+
+static const char* const kFillerWords[] = { "a", "an", "and", "best", "classic", "easy", "homemade", "my",
+                                            "of", "perfect", "quick", "recipe", "simple", "the", "with" };
+
+static std::uint64_t hashOf(const std::string& text) {
+    return MinHashSketch::mix(std::hash<std::string>{}(text));
+}
+
+static std::string lowercase(const std::string& text) {
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower;
+}
+
+std::string RecipeDeduplicator::normalizedName(const std::string& name) {
+    std::string letters = name;
+    for (char& c : letters) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) {
+            c = ' ';
+        }
+    }
+    // wordForm leaves single spaces between the words.
+    std::string form = IngredientAliases::wordForm(letters);
+    std::vector<std::string> words;
+    for (std::size_t begin = 0, end; begin < form.size(); begin = end + 1) {
+        end = std::min(form.find(' ', begin), form.size());
+        std::string word = form.substr(begin, end - begin);
+        if (!word.empty() && std::find(std::begin(kFillerWords), std::end(kFillerWords), word) == std::end(kFillerWords)) {
+            words.push_back(std::move(word));
+        }
+    }
+    std::sort(words.begin(), words.end());
+    std::string normalized;
+    for (const auto& word : words) {
+        if (!normalized.empty()) {
+            normalized += ' ';
+        }
+        normalized += word;
+    }
+    return normalized;
+}
+
+RecipeDeduplicator::RecipeDeduplicator(const DedupOptions& dedupOptions, std::shared_ptr<const IngredientAliases> aliasTable)
+    : aliases(std::move(aliasTable)), options(dedupOptions),
+      sketch(std::max(dedupOptions.bands, 1u) * std::max(dedupOptions.rows, 1u)) {
+    options.bands = std::max(options.bands, 1u);
+    options.rows = std::max(options.rows, 1u);
+    itemOffsets.push_back(0);
+    signature.resize(sketch.size());
+    bandKeys.resize(options.bands);
+}
+
+void RecipeDeduplicator::reserve(HashTable& table, std::size_t extra) {
+    if ((table.used + extra) * 2 > table.slots.size()) {
+        std::vector<Slot> old = std::move(table.slots);
+        std::size_t size = std::max<std::size_t>(64, old.size());
+        while ((table.used + extra) * 2 > size) {
+            size *= 2;
+        }
+        table.slots.assign(size, Slot{ 0, kNone });
+        std::size_t mask = table.slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.recipe != kNone) {
+                std::size_t at = slot.hash & mask;
+                while (table.slots[at].recipe != kNone) {
+                    at = (at + 1) & mask;
+                }
+                table.slots[at] = slot;
+            }
+        }
+    }
+}
+
+// The table must have room; see reserve.
+std::uint32_t RecipeDeduplicator::findOrInsert(HashTable& table, std::uint64_t hash, std::uint32_t recipe) {
+    std::size_t mask = table.slots.size() - 1;
+    for (std::size_t at = hash & mask; ; at = (at + 1) & mask) {
+        Slot& slot = table.slots[at];
+        if (slot.recipe == kNone) {
+            slot = Slot{ hash, recipe };
+            ++table.used;
+            return kNone;
+        }
+        if (slot.hash == hash) {
+            return slot.recipe;
+        }
+    }
+}
+
+std::uint64_t RecipeDeduplicator::ingredientHash(const std::string& spelling) {
+    auto found = ingredientHashes.find(spelling);
+    if (found != ingredientHashes.end()) {
+        return found->second;
+    }
+    std::uint64_t hash = hashOf(aliases->canonical(spelling));
+    ingredientHashes.emplace(spelling, hash);
+    return hash;
+}
+
+// Category, sorted distinct canonical ingredients and normalized name, separated by bytes
+// that none of them contain.
+std::string RecipeDeduplicator::fingerprintKey(const Recipe& recipe) const {
+    std::vector<std::string> ingredients;
+    for (const auto& ingredient : recipe.getRequiredIngredients()) {
+        ingredients.push_back(aliases->canonical(ingredient.first));
+    }
+    std::sort(ingredients.begin(), ingredients.end());
+    ingredients.erase(std::unique(ingredients.begin(), ingredients.end()), ingredients.end());
+
+    std::string key = lowercase(recipe.getType());
+    key += '\n';
+    for (const auto& ingredient : ingredients) {
+        key += ingredient;
+        key += '\0';
+    }
+    key += '\n';
+    key += normalizedName(recipe.getRecipeName());
+    return key;
+}
+
+// Of recipeItems and a kept recipe's items.
+float RecipeDeduplicator::similarity(std::uint32_t keptId) const {
+    auto it = items.begin() + itemOffsets[keptId];
+    auto end = items.begin() + itemOffsets[keptId + 1];
+    std::size_t total = recipeItems.size() + static_cast<std::size_t>(end - it);
+    std::size_t shared = 0;
+    for (std::size_t i = 0; i < recipeItems.size() && it != end;) {
+        if (recipeItems[i] < *it) {
+            ++i;
+        } else if (*it < recipeItems[i]) {
+            ++it;
+        } else {
+            ++shared;
+            ++i;
+            ++it;
+        }
+    }
+    return total == shared ? 0.0f : static_cast<float>(shared) / static_cast<float>(total - shared);
+}
+
+bool RecipeDeduplicator::add(Recipe recipe) {
+    ++report.recipes;
+    std::uint32_t id = static_cast<std::uint32_t>(kept.size());
+    std::uint64_t categoryHash = hashOf(lowercase(recipe.getType()));
+    std::string name = normalizedName(recipe.getRecipeName());
+    recipeItems.clear();
+    for (const auto& ingredient : recipe.getRequiredIngredients()) {
+        recipeItems.push_back(ingredientHash(ingredient.first));
+    }
+    std::sort(recipeItems.begin(), recipeItems.end());
+    recipeItems.erase(std::unique(recipeItems.begin(), recipeItems.end()), recipeItems.end());
+
+    std::uint64_t fingerprint = categoryHash;
+    for (std::uint64_t item : recipeItems) {
+        fingerprint = MinHashSketch::mix(fingerprint ^ item);
+    }
+    fingerprint = MinHashSketch::mix(fingerprint ^ hashOf(name));
+    // A recipe colliding with a different one is kept without a fingerprint of its own.
+    reserve(fingerprints, 1);
+    std::uint32_t original = findOrInsert(fingerprints, fingerprint, id);
+    if (original != kNone && fingerprintKey(kept[original]) == fingerprintKey(recipe)) {
+        Recipe& first = kept[original];
+        report.merged.push_back(DuplicateRecipe{ recipe.getRecipeName(), first.getRecipeName(), 1.0f });
+        if (first.getTimeMinutes() < 0 && recipe.getTimeMinutes() >= 0) {
+            first = Recipe(first.getRecipeName(), first.getRequiredIngredients(), first.getCondiments(), first.getSteps(),
+                           first.getType(), recipe.getTimeMinutes());
+        }
+        return false;
+    }
+
+    // The sketch also covers the name words, tagged so they never equal an ingredient.
+    for (std::size_t begin = 0, end; begin < name.size(); begin = end + 1) {
+        end = std::min(name.find(' ', begin), name.size());
+        recipeItems.push_back(hashOf("#" + name.substr(begin, end - begin)));
+    }
+    std::sort(recipeItems.begin(), recipeItems.end());
+    recipeItems.erase(std::unique(recipeItems.begin(), recipeItems.end()), recipeItems.end());
+
+    if (!recipeItems.empty()) {
+        sketch.reset(signature.data());
+        for (std::uint64_t item : recipeItems) {
+            sketch.add(item, signature.data());
+        }
+        // Each band is a random access into a large table; start all the loads before using any.
+        reserve(buckets, options.bands);
+        for (std::uint32_t band = 0; band < options.bands; ++band) {
+            bandKeys[band] = MinHashSketch::bandKey(signature.data(), band, options.rows);
+#ifdef RECIPEDEDUPLICATION_SSE2
+            _mm_prefetch(reinterpret_cast<const char*>(&buckets.slots[bandKeys[band] & (buckets.slots.size() - 1)]), _MM_HINT_T0);
+#endif
+        }
+        std::uint32_t best = kNone;
+        float bestSimilarity = 0.0f;
+        for (std::uint32_t band = 0; band < options.bands; ++band) {
+            std::uint32_t candidate = findOrInsert(buckets, bandKeys[band], id);
+            if (candidate != kNone && categoryHashes[candidate] == categoryHash) {
+                float candidateSimilarity = similarity(candidate);
+                if (candidateSimilarity > bestSimilarity) {
+                    best = candidate;
+                    bestSimilarity = candidateSimilarity;
+                }
+            }
+        }
+        if (best != kNone && bestSimilarity >= options.nearThreshold) {
+            report.nearDuplicates.push_back(DuplicateRecipe{ recipe.getRecipeName(), kept[best].getRecipeName(), bestSimilarity });
+        }
+    }
+
+    categoryHashes.push_back(categoryHash);
+    items.insert(items.end(), recipeItems.begin(), recipeItems.end());
+    itemOffsets.push_back(static_cast<std::uint32_t>(items.size()));
+    kept.push_back(std::move(recipe));
+    return true;
+}
+
+const DedupReport& RecipeDeduplicator::getReport() const {
+    return report;
+}
+
+std::vector<Recipe> RecipeDeduplicator::release() {
+    std::vector<Recipe> recipes = std::move(kept);
+    kept.clear();
+    fingerprints = HashTable();
+    buckets = HashTable();
+    ingredientHashes.clear();
+    categoryHashes.clear();
+    items.clear();
+    itemOffsets.assign(1, 0);
+    return recipes;
+}
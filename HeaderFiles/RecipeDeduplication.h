@@ -0,0 +1,98 @@
+#ifndef RECIPEDEDUPLICATION_H
+#define RECIPEDEDUPLICATION_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "IngredientAliases.h"
+#include "MinHashSketch.h"
+#include "Recipe.h"
+
+struct DuplicateRecipe {
+    std::string name;
+    std::string duplicateOf;   // the earlier recipe it matches
+    float similarity;          // 1 for exact duplicates
+};
+
+struct DedupReport {
+    std::size_t recipes = 0;                     // recipes offered
+    std::vector<DuplicateRecipe> merged;         // dropped in favour of an earlier recipe
+    std::vector<DuplicateRecipe> nearDuplicates; // kept, but probably the same dish
+};
+
+struct DedupOptions {
+    float nearThreshold = 0.7f;   // Jaccard similarity at which a recipe is flagged
+    std::uint32_t bands = 10;
+    std::uint32_t rows = 3;
+};
+
+// Drops recipes that repeat an earlier one, in one pass over a stream of recipes, as partner
+// feeds list the same dish many times under slightly different names.
+//
+// Exact duplicates share a fingerprint of their category, their set of canonical main
+// ingredients and their normalized name (see normalizedName), and are merged into the first
+// one seen; the full keys are compared before merging, so a hash collision merges nothing.
+// Near-duplicates are only flagged: each kept recipe gets a MinHash sketch of its
+// ingredients and name words, filed in one bucket per band, and a new recipe is compared
+// exactly with the first recipe of each bucket it lands in. That is at most `bands`
+// comparisons per recipe, whatever the number of recipes. With the defaults a pair with
+// similarity 0.7 is checked with probability about 0.99, and one with 0.5 about 0.74.
+class RecipeDeduplicator {
+private:
+    // Open-addressing table from a 64-bit hash to a kept recipe, kept at most half full.
+    struct Slot {
+        std::uint64_t hash;
+        std::uint32_t recipe;   // kNone when the slot is empty
+    };
+    struct HashTable {
+        std::vector<Slot> slots;
+        std::size_t used = 0;
+    };
+
+    static constexpr std::uint32_t kNone = 0xffffffff;
+
+    std::shared_ptr<const IngredientAliases> aliases;
+    DedupOptions options;
+    MinHashSketch sketch;
+    std::vector<Recipe> kept;
+    HashTable fingerprints;
+    HashTable buckets;   // band key -> first kept recipe in the bucket
+    // Each kept recipe's category hash and sorted item hashes (ingredients and name words).
+    std::vector<std::uint64_t> categoryHashes;
+    std::vector<std::uint32_t> itemOffsets;
+    std::vector<std::uint64_t> items;
+    // Spelling -> hash of its canonical name; feeds repeat the same few thousand spellings.
+    std::unordered_map<std::string, std::uint64_t> ingredientHashes;
+    // Per-recipe scratch, reused across add() calls.
+    std::vector<std::uint64_t> recipeItems;
+    std::vector<std::uint32_t> signature;
+    std::vector<std::uint64_t> bandKeys;
+    DedupReport report;
+
+    // Grows the table so that `extra` more inserts keep it at most half full.
+    static void reserve(HashTable& table, std::size_t extra);
+    // The recipe already stored under hash, or kNone after storing `recipe` under it.
+    static std::uint32_t findOrInsert(HashTable& table, std::uint64_t hash, std::uint32_t recipe);
+    std::uint64_t ingredientHash(const std::string& spelling);
+    std::string fingerprintKey(const Recipe& recipe) const;
+    float similarity(std::uint32_t keptId) const;
+
+public:
+    // Ingredient names are compared under `aliases`.
+    explicit RecipeDeduplicator(const DedupOptions& options = DedupOptions(),
+                                std::shared_ptr<const IngredientAliases> aliases = IngredientAliases::current());
+
+    // Keeps the recipe unless it is an exact duplicate of one already kept; returns whether it was kept.
+    bool add(Recipe recipe);
+    const DedupReport& getReport() const;
+    // The kept recipes in the order they were added; the deduplicator is empty afterwards.
+    std::vector<Recipe> release();
+
+    // Lowercase, singular words without punctuation or filler words ("easy", "the", ...),
+    // sorted: "The Best Pancakes!" and "pancake" both give "pancake".
+    static std::string normalizedName(const std::string& name);
+};
+
+#endif
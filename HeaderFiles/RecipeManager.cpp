@@ -1,63 +1,207 @@
 #include "RecipeManager.h"
+#include <filesystem>
+#include <unordered_map>
 
-RecipeManager::RecipeManager(const std::string& recipeFilename) {
-    recipes = loadRecipesFromJSON(recipeFilename);
-    loadIngredientsFromFile("storage.json");
+namespace fs = std::filesystem;
+
+// A file kept beside the recipes: in the recipe directory, or next to recipes.json or the pattern.
+static std::string besideRecipes(const std::string& recipeSource, const std::string& fileName) {
+    std::error_code ec;
+    fs::path source(recipeSource);
+    fs::path directory = fs::is_directory(source, ec) ? source : source.parent_path();
+    return (directory / fileName).string();
 }
 
-void RecipeManager::saveHistory(const Recipe& recipe) {
-    std::ifstream infile("history.json");
-    json history;
+// Duplicates are expected in merged partner feeds, so this is a summary rather than a list.
+static void reportDuplicates(const DedupReport& report) {
+    if (!report.merged.empty()) {
+        std::cout << "Merged " << report.merged.size() << " duplicate recipe(s) out of " << report.recipes << ".\n";
+    }
+    if (!report.nearDuplicates.empty()) {
+        const DuplicateRecipe& first = report.nearDuplicates.front();
+        std::cout << report.nearDuplicates.size() << " recipe(s) look like near-duplicates, e.g. \"" << first.name
+                  << "\" and \"" << first.duplicateOf << "\".\n";
+    }
+}
 
-    if (infile.is_open() && infile.peek() != std::ifstream::traits_type::eof()) {
-        infile >> history;
+RecipeManager::RecipeManager(const std::string& recipeFilename, const std::string& storageFilename, const std::string& historyFilename)
+    : recipeSource(recipeFilename), storageFile(storageFilename), historyFile(historyFilename) {
+    aliases = std::make_shared<const IngredientAliases>(
+        IngredientAliases::fromFile(besideRecipes(recipeSource, "ingredient_aliases.json")));
+    DedupReport duplicates;
+    catalog = std::make_shared<const RecipeCatalog>(loadRecipeCatalog(recipeSource, 0, &duplicates, aliases));
+    reportDuplicates(duplicates);
+    spelling = std::make_shared<const FuzzyIngredientIndex>(*catalog);
+    similarity = std::make_shared<const RecipeSimilarityIndex>(catalog);
+    substitutes = std::make_shared<const SubstitutionGraph>(
+        SubstitutionGraph::fromFile(besideRecipes(recipeSource, "ingredient_substitutes.json"), aliases));
+    loadIngredientsFromFile(storageFile);
+    recoverCooks();
+    buildCompleter();
+}
+
+RecipeManager::~RecipeManager() {
+    checkpoint();
+}
+
+void RecipeManager::setPersistenceFormat(PersistenceFormat format) {
+    persistenceFormat = format;
+}
+
+void RecipeManager::reloadRecipes() {
+    DedupReport duplicates;
+    auto updated = std::make_shared<const RecipeCatalog>(loadRecipeCatalog(recipeSource, 0, &duplicates, aliases));
+    // An empty result usually means the file was caught half-written; keep serving the old catalog.
+    if (updated->empty()) {
+        std::cerr << "Reloaded recipe catalog is empty, keeping the previous one.\n";
+        return;
     }
-    infile.close();
+    reportDuplicates(duplicates);
+    auto updatedSpelling = std::make_shared<const FuzzyIngredientIndex>(*updated);
+    auto updatedSimilarity = std::make_shared<const RecipeSimilarityIndex>(updated);
+    auto updatedSubstitutes = std::make_shared<const SubstitutionGraph>(
+        SubstitutionGraph::fromFile(besideRecipes(recipeSource, "ingredient_substitutes.json"), aliases));
+    std::atomic_store(&catalog, std::shared_ptr<const RecipeCatalog>(std::move(updated)));
+    std::atomic_store(&spelling, std::shared_ptr<const FuzzyIngredientIndex>(std::move(updatedSpelling)));
+    std::atomic_store(&similarity, std::shared_ptr<const RecipeSimilarityIndex>(std::move(updatedSimilarity)));
+    std::atomic_store(&substitutes, std::shared_ptr<const SubstitutionGraph>(std::move(updatedSubstitutes)));
+    std::unique_lock<std::shared_mutex> guard(completerLock);
+    completer.setCatalog(*getCatalog());
+}
 
-    if (!history.is_array()) {
-        history = json::array();
+void RecipeManager::watchRecipes() {
+    if (!watcher) {
+        watcher = std::make_unique<CatalogWatcher>(recipeSource, [this]() { reloadRecipes(); });
+    }
+    watcher->start();
+}
+
+// The history entries; a missing or malformed file counts as an empty history.
+static json readHistory(const std::string& filename) {
+    json history;
+    try {
+        if (readDocument(filename, history) && history.is_array()) {
+            return history;
+        }
+    } catch (json::exception& e) {
+        std::cerr << "Error parsing history file " << filename << ": " << e.what() << "\n";
     }
+    return json::array();
+}
 
+void appendRecipeHistory(const std::string& filename, const std::string& recipeName, std::size_t recipeId, PersistenceFormat format) {
+    json history = readHistory(filename);
 
     json j;
-    j["name"] = recipe.getRecipeName();
-    time_t now = time(0);
-    char buffer[80];
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d", localtime(&now));
-    j["date"] = std::string(buffer);
+    j["name"] = recipeName;
+    if (recipeId != RecipeCatalog::npos) {
+        j["id"] = recipeId;
+    }
+    j["date"] = formatDate(today());
     
     history.push_back(j);
 
-    std::ofstream outfile("history.json");
-    if (outfile.is_open()) {
-        outfile << history.dump(4);
-        outfile.close();
+    writeDocument(filename, history, format);
+}
+
+const Recipe* findHistoryRecipe(const RecipeCatalog& catalog, const json& entry) {
+    if (!entry.contains("name") || !entry["name"].is_string()) {
+        return nullptr;
     }
+    const std::string& name = entry["name"].get_ref<const std::string&>();
+
+    // The stored id is a fast path; it may point elsewhere if the catalog changed since.
+    if (entry.contains("id") && entry["id"].is_number_unsigned()) {
+        const Recipe* recipe = catalog.findById(entry["id"].get<std::size_t>());
+        if (recipe && recipe->getRecipeName() == name) {
+            return recipe;
+        }
+    }
+    return catalog.findByName(name);
+}
+
+// Queued behind the cooks still waiting for a checkpoint, so the history file keeps the
+// order things were made in. The entry has no log sequence: nothing was deducted to replay.
+void RecipeManager::saveHistory(const Recipe& recipe) {
+    json entry;
+    entry["name"] = recipe.getRecipeName();
+    std::size_t recipeId = getCatalog()->idOf(recipe.getRecipeName());
+    if (recipeId != RecipeCatalog::npos) {
+        entry["id"] = recipeId;
+    }
+    entry["date"] = formatDate(today());
+    std::unique_lock<std::shared_mutex> guard(completerLock);
+    pendingHistory.push_back(std::move(entry));
+    completer.addScore(recipe.getRecipeName(), CompletionKind::Recipe);
 }
 
 void RecipeManager::loadIngredientsFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    json j;
+    if (!readDocument(filename, j)) {
         std::cerr << "Could not open file: " << filename << "\n";
         return;
     }
 
-    json j;
-    file >> j;
-
     if (j.contains("Fridge")) {
-        fridge.fromJSON(j["Fridge"]);
+        fridge.fromJSON(std::move(j["Fridge"]));
     }
 
     if (j.contains("Pantry")) {
-        pantry.fromJSON(j["Pantry"]);
+        pantry.fromJSON(std::move(j["Pantry"]));
+    }
+
+    if (filename == storageFile) {
+        checkpointSequence = j.value("walSequence", std::uint64_t(0));
     }
 
-    file.close();
     std::cout << "Ingredients loaded from " << filename << "\n";
 }
 
+IngredientBatch RecipeManager::beginIngredientBatch() {
+    return IngredientBatch(fridge, pantry, [this]() {
+        saveIngredientsToFile(storageFile);
+        // Names already known cost one hash lookup each; new ones become completions.
+        std::unique_lock<std::shared_mutex> guard(completerLock);
+        for (const Storage* storage : { static_cast<const Storage*>(&fridge), static_cast<const Storage*>(&pantry) }) {
+            for (const auto& ingredient : storage->getIngredients()) {
+                completer.add(ingredient.getName(), CompletionKind::Ingredient);
+            }
+        }
+    });
+}
+
+void RecipeManager::buildCompleter() {
+    json history = readHistory(historyFile);
+    std::unordered_map<std::string, double> cooked;
+    for (const json* entries : { &history, &pendingHistory }) {
+        for (const auto& entry : *entries) {
+            if (entry.is_object() && entry.contains("name") && entry["name"].is_string()) {
+                cooked[entry["name"].get<std::string>()] += 1.0;
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> guard(completerLock);
+    completer = NameCompleter(*getCatalog());
+    for (const auto& recipe : cooked) {
+        completer.setScore(recipe.first, CompletionKind::Recipe, recipe.second);
+    }
+    for (const Storage* storage : { static_cast<const Storage*>(&fridge), static_cast<const Storage*>(&pantry) }) {
+        for (const auto& ingredient : storage->getIngredients()) {
+            completer.add(ingredient.getName(), CompletionKind::Ingredient);
+        }
+    }
+}
+
+std::vector<Completion> RecipeManager::completeName(const std::string& prefix, std::size_t limit) const {
+    std::shared_lock<std::shared_mutex> guard(completerLock);
+    return completer.complete(prefix, limit);
+}
+
 void RecipeManager::collectIngredients() {
+    // Everything entered is added and saved once, when the user is done.
+    IngredientBatch batch = beginIngredientBatch();
+    std::shared_ptr<const FuzzyIngredientIndex> names = getSpellingIndex();
     while (true) {
         std::string name;
         int quantity;
@@ -66,9 +210,18 @@ void RecipeManager::collectIngredients() {
         std::getline(std::cin, name);
         if (name == "done") break;
 
+        std::string suggestion = names->correction(name);
+        if (!suggestion.empty()) {
+            std::string answer;
+            std::cout << "Did you mean \"" << suggestion << "\"? (y/n) ";
+            std::cin >> answer;
+            if (answer == "y" || answer == "Y") {
+                name = suggestion;
+            }
+        }
+
         std::cout << "Enter the quantity of " << name << ": ";
         std::cin >> quantity;
-        Ingredient newIngredient(name, quantity, "");
 
         std::string storageLocation;
         std::cout << "Is the ingredient stored in the (F)ridge or (P)antry? ";
@@ -76,19 +229,34 @@ void RecipeManager::collectIngredients() {
 
         if (storageLocation == "F" || storageLocation == "f") {
             std::string expirationDate;
+            int expiryDay;
             std::cout << "Enter the expiration date (YYYY-MM-DD): ";
             std::cin >> expirationDate;
-            newIngredient = Ingredient(name, quantity, expirationDate);
-            fridge.addIngredient(newIngredient);
+            while (std::cin && !parseDate(expirationDate, expiryDay)) {
+                std::cout << "Please enter a date such as 2024-10-15: ";
+                std::cin >> expirationDate;
+            }
+            batch.addToFridge(Ingredient(std::move(name), quantity, std::move(expirationDate)));
         } else if (storageLocation == "P" || storageLocation == "p") {
-            pantry.addIngredient(newIngredient);
+            batch.addToPantry(Ingredient(std::move(name), quantity, ""));
         } else {
             std::cout << "Invalid option. Please choose (F)ridge or (P)antry.\n";
             continue;
         }
+    }
+    batch.commit();
+}
 
-        saveIngredientsToFile("storage.json");
+bool RecipeManager::importIngredients(const std::string& path, ImportReport& report, bool correctSpelling) {
+    IngredientBatch batch = beginIngredientBatch();
+    std::shared_ptr<const FuzzyIngredientIndex> names = correctSpelling ? getSpellingIndex() : nullptr;
+    ImportOptions options;
+    options.spelling = names.get();
+    if (!importInventory(path, batch, report, options)) {
+        return false;
     }
+    batch.commit();
+    return true;
 }
 
 void RecipeManager::matchRecipes() {
@@ -136,23 +304,45 @@ void RecipeManager::matchRecipes() {
 
     std::vector<std::string> possibleRecipes;
     std::vector<const Recipe*> matchingRecipes;
-
-    for (const auto& recipe : recipes) {
-        std::string category = recipe.getType();
-        std::transform(category.begin(), category.end(), category.begin(), ::tolower);
-
-        if ((recipeType == "s" && category == "sweet") || (recipeType == "sa" && category == "savory")) {
-            std::vector<std::string> missingIngredients;
-            if (recipe.canMakeRecipe(selectedIngredients, missingIngredients)) {
-                possibleRecipes.push_back(recipe.getRecipeName());
-                matchingRecipes.push_back(&recipe);
-            } else if (!missingIngredients.empty()) {
-                std::cout << "You are missing the following ingredients for " << recipe.getRecipeName() << ": ";
-                for (const auto& ingredient : missingIngredients) {
-                    std::cout << ingredient << " ";
-                }
-                std::cout << "\n";
+    std::vector<Substitutions> matchingSwaps;
+    std::shared_ptr<const RecipeCatalog> snapshot = getCatalog();
+
+    // Besides the two shortcuts, any category name from the recipe files (e.g. a cuisine) works.
+    CategoryId category = recipeType == "s" ? toId(Category::Sweet)
+                        : recipeType == "sa" ? toId(Category::Savory)
+                        : snapshot->getCategories().find(recipeType);
+    RecipeCatalog::Partition partition = snapshot->getPartition(category);
+
+    // What the selection covers, substitutes included, is worked out once; each recipe is
+    // then one lookup per ingredient.
+    SubstitutionClosure closure(*snapshot, *getSubstitutes(), selectedIngredients);
+    const IngredientAliases& names = snapshot->getAliases();
+    for (std::size_t id = partition.begin; id < partition.end; ++id) {
+        const Recipe& recipe = snapshot->getRecipes()[id];
+        const auto& required = recipe.getRequiredIngredients();
+        IdRange needed = snapshot->getRecipeIngredients(id);
+        std::vector<std::string> missingIngredients;
+        std::string swaps;
+        Substitutions substitutions;
+        for (std::size_t i = 0; i < needed.size(); ++i) {
+            IngredientId ingredient = needed.begin()[i];
+            if (!closure.isAvailable(ingredient)) {
+                missingIngredients.push_back(required[i].first);
+            } else if (const SubstitutionClosure::Substitute* substitute = closure.substituteFor(ingredient)) {
+                swaps += (swaps.empty() ? " (using " : ", ") + substitute->name + " for " + required[i].first;
+                substitutions.emplace(names.canonical(required[i].first), substitute->name);
+            }
+        }
+        if (missingIngredients.empty()) {
+            possibleRecipes.push_back(recipe.getRecipeName() + (swaps.empty() ? "" : swaps + ")"));
+            matchingRecipes.push_back(&recipe);
+            matchingSwaps.push_back(std::move(substitutions));
+        } else {
+            std::cout << "You are missing the following ingredients for " << recipe.getRecipeName() << ": ";
+            for (const auto& ingredient : missingIngredients) {
+                std::cout << ingredient << " ";
             }
+            std::cout << "\n";
         }
     }
 
@@ -170,15 +360,133 @@ void RecipeManager::matchRecipes() {
 
         if (choice > 0 && choice <= matchingRecipes.size()) {
             displayFullRecipe(*matchingRecipes[choice - 1]);
-            saveHistory(*matchingRecipes[choice - 1]);
+            if (!cook(matchingRecipes[choice - 1]->getRecipeName(), matchingSwaps[choice - 1])) {
+                // Still remember that it was made, even though the stock could not cover it.
+                saveHistory(*matchingRecipes[choice - 1]);
+            }
         } else {
             std::cout << "Invalid choice.\n";
         }
     }
 }
 
+std::vector<std::string> RecipeManager::findRecipes(const RecipeQuery& query) const {
+    QueryContext context;
+    context.inventory = fridge.getIngredients();
+    context.inventory.insert(context.inventory.end(), pantry.getIngredients().begin(), pantry.getIngredients().end());
+    for (const auto& ingredient : fridge.getExpiringSoon(5)) {
+        context.expiringItems.push_back(ingredient.getName());
+    }
+
+    std::shared_ptr<const RecipeCatalog> snapshot = getCatalog();
+    std::vector<std::string> names;
+    for (std::size_t id : RecipeQueryEngine(*snapshot).execute(query, context)) {
+        names.push_back(snapshot->getRecipes()[id].getRecipeName());
+    }
+    return names;
+}
+
+std::vector<std::string> RecipeManager::suggestForExpiring(std::size_t maxMissing, std::size_t limit) const {
+    std::vector<Ingredient> inventory = fridge.getIngredients();
+    inventory.insert(inventory.end(), pantry.getIngredients().begin(), pantry.getIngredients().end());
+    std::vector<std::pair<std::string, int>> daysLeft;
+    for (const auto& ingredient : fridge.getIngredients()) {
+        int days;
+        if (Fridge::daysUntilExpiry(ingredient, days)) {
+            daysLeft.emplace_back(ingredient.getName(), days);
+        }
+    }
+
+    std::shared_ptr<const RecipeCatalog> snapshot = getCatalog();
+    std::vector<std::string> names;
+    for (const auto& ranked : ExpiryRanker(*snapshot, inventory, daysLeft).rank(maxMissing, limit)) {
+        names.push_back(snapshot->getRecipes()[ranked.recipeId].getRecipeName());
+    }
+    return names;
+}
+
+ShoppingList RecipeManager::suggestShopping(std::size_t maxItems) const {
+    std::vector<Ingredient> inventory = fridge.getIngredients();
+    inventory.insert(inventory.end(), pantry.getIngredients().begin(), pantry.getIngredients().end());
+    return ShoppingListPlanner(*getCatalog(), inventory).enableMost(maxItems);
+}
+
+std::vector<std::string> RecipeManager::similarRecipes(const std::string& recipeName, std::size_t limit) const {
+    std::shared_ptr<const RecipeSimilarityIndex> index = getSimilarityIndex();
+    const RecipeCatalog& snapshot = index->getCatalog();
+    std::vector<std::string> names;
+    std::size_t recipeId = snapshot.idOf(recipeName);
+    if (recipeId == RecipeCatalog::npos) {
+        return names;
+    }
+    for (const auto& similar : index->similarTo(recipeId, limit)) {
+        names.push_back(snapshot.getRecipes()[similar.recipeId].getRecipeName());
+    }
+    return names;
+}
+
+std::vector<std::string> RecipeManager::suggestFromHistory(std::size_t recent, std::size_t limit) const {
+    json history = readHistory(historyFile);
+    std::shared_ptr<const RecipeSimilarityIndex> index = getSimilarityIndex();
+    const RecipeCatalog& snapshot = index->getCatalog();
+
+    // Newest first, pending cooks being newer than anything in the file.
+    std::vector<std::size_t> recipeIds;
+    for (const json* entries : { &pendingHistory, static_cast<const json*>(&history) }) {
+        for (auto it = entries->rbegin(); it != entries->rend() && recipeIds.size() < recent; ++it) {
+            const Recipe* recipe = findHistoryRecipe(snapshot, *it);
+            if (recipe) {
+                std::size_t recipeId = snapshot.idOf(recipe->getRecipeName());
+                if (std::find(recipeIds.begin(), recipeIds.end(), recipeId) == recipeIds.end()) {
+                    recipeIds.push_back(recipeId);
+                }
+            }
+        }
+    }
+
+    std::vector<std::string> names;
+    for (const auto& similar : index->similarToAny(recipeIds, limit)) {
+        names.push_back(snapshot.getRecipes()[similar.recipeId].getRecipeName());
+    }
+    return names;
+}
+
+void RecipeManager::planMeals(int days) {
+    std::vector<Ingredient> inventory = fridge.getIngredients();
+    inventory.insert(inventory.end(), pantry.getIngredients().begin(), pantry.getIngredients().end());
+    std::vector<std::pair<std::string, int>> daysLeft;
+    for (const auto& ingredient : fridge.getIngredients()) {
+        int left;
+        if (Fridge::daysUntilExpiry(ingredient, left)) {
+            daysLeft.emplace_back(ingredient.getName(), left);
+        }
+    }
+
+    std::shared_ptr<const RecipeCatalog> snapshot = getCatalog();
+    MealPlanOptions options;
+    options.days = days;
+    MealPlan plan = MealPlanner(*snapshot, inventory, daysLeft).plan(options);
+
+    for (std::size_t day = 0; day < plan.recipes.size(); ++day) {
+        std::cout << "Day " << day + 1 << ": ";
+        if (plan.recipes[day] == RecipeCatalog::npos) {
+            std::cout << "(nothing planned)\n";
+        } else {
+            std::cout << snapshot->getRecipes()[plan.recipes[day]].getRecipeName() << "\n";
+        }
+    }
+    std::cout << "Stock used: " << plan.usage << " items' worth, wasted: " << plan.waste
+              << " (best possible: " << plan.upperBound << ")\n";
+    if (!plan.completed) {
+        std::cout << "The plan was finished early to stay within the time limit.\n";
+    }
+}
+
 void RecipeManager::displayFullRecipe(const Recipe& recipe) {
     std::cout << "Recipe: " << recipe.getRecipeName() << "\n";
+    if (recipe.getTimeMinutes() >= 0) {
+        std::cout << "Time: " << recipe.getTimeMinutes() << " minutes\n";
+    }
     std::cout << "Ingredients:\n";
     for (const auto& ingredient : recipe.getRequiredIngredients()) {
         std::cout << "- " << ingredient.first << ": " << ingredient.second << "\n";
@@ -188,41 +496,170 @@ void RecipeManager::displayFullRecipe(const Recipe& recipe) {
     for (const auto& step : recipe.getSteps()) {
         std::cout << "- " << step << "\n";
     }
+
+    std::vector<std::string> similar = similarRecipes(recipe.getRecipeName(), 3);
+    if (!similar.empty()) {
+        std::cout << "Similar recipes:";
+        for (std::size_t i = 0; i < similar.size(); ++i) {
+            std::cout << (i == 0 ? " " : ", ") << similar[i];
+        }
+        std::cout << "\n";
+    }
+}
+
+std::string RecipeManager::cookLogPath() const {
+    return storageFile + ".wal";
+}
+
+// Re-applies cooks that were logged but had not reached the storage or history file when
+// the program last stopped. Sequence numbers make this safe to repeat.
+void RecipeManager::recoverCooks() {
+    std::vector<json> records = WriteAheadLog::readEntries(cookLogPath());
+    if (records.empty()) {
+        return;
+    }
+
+    std::uint64_t historySequence = 0;
+    for (const auto& entry : readHistory(historyFile)) {
+        if (entry.is_object()) {
+            historySequence = std::max(historySequence, entry.value("seq", std::uint64_t(0)));
+        }
+    }
+
+    std::size_t recovered = 0;
+    for (const auto& record : records) {
+        std::uint64_t sequence = record.value("seq", std::uint64_t(0));
+        if (sequence > checkpointSequence) {
+            replayCookRecord(record, fridge, pantry);
+            ++recovered;
+        }
+        if (sequence > historySequence) {
+            pendingHistory.push_back(historyEntry(record));
+        }
+    }
+    cookLog = std::make_unique<WriteAheadLog>(cookLogPath(), checkpointSequence);
+    std::cout << "Recovered " << recovered << " cooked recipe(s) from " << cookLogPath() << "\n";
+    checkpoint();
+}
+
+bool RecipeManager::cook(const std::string& recipeName, const Substitutions& substitutions) {
+    return cookAll({ recipeName }, substitutions) == 1;
+}
+
+std::size_t RecipeManager::cookAll(const std::vector<std::string>& recipeNames, const Substitutions& substitutions) {
+    if (!cookLog) {
+        cookLog = std::make_unique<WriteAheadLog>(cookLogPath(), checkpointSequence);
+    }
+
+    std::shared_ptr<const RecipeCatalog> snapshot = getCatalog();
+    std::vector<std::vector<Deduction>> applied;
+    std::vector<json> records;
+    std::vector<Deduction> deductions;
+    std::vector<std::string> missing;
+    for (const auto& name : recipeNames) {
+        const Recipe* recipe = snapshot->findByName(name);
+        if (!recipe) {
+            std::cout << "Unknown recipe: " << name << "\n";
+            continue;
+        }
+        if (!planDeductions(*recipe, fridge, pantry, deductions, missing, substitutions, &snapshot->getAliases())) {
+            std::cout << "Not enough stock to cook " << name << ", short of:";
+            for (const auto& ingredient : missing) {
+                std::cout << " " << ingredient;
+            }
+            std::cout << "\n";
+            continue;
+        }
+        applyDeductions(fridge, pantry, deductions);
+        records.push_back(cookRecord(name, snapshot->idOf(name), deductions));
+        applied.push_back(std::move(deductions));
+    }
+
+    if (records.empty()) {
+        return 0;
+    }
+    // Queued together so one batch holds them all; other threads' cooks do not count.
+    std::uint64_t last = cookLog->addAll(records);
+    if (!cookLog->commit(last - records.size() + 1, last)) {
+        // Nothing was made durable, so nothing happened.
+        for (auto it = applied.rbegin(); it != applied.rend(); ++it) {
+            undoDeductions(fridge, pantry, *it);
+        }
+        std::cerr << "Could not record cooked recipes; inventory left unchanged.\n";
+        return 0;
+    }
+    std::unique_lock<std::shared_mutex> guard(completerLock);
+    for (const auto& record : records) {
+        pendingHistory.push_back(historyEntry(record));
+        completer.addScore(record.value("name", ""), CompletionKind::Recipe);
+    }
+    guard.unlock();
+    if (cookLog->lastSequence() - checkpointSequence >= kCheckpointInterval) {
+        checkpoint();
+    }
+    return records.size();
 }
 
-void RecipeManager::saveIngredientsToFile(const std::string& filename) {
+void RecipeManager::checkpoint() {
+    if (pendingHistory.empty() && (!cookLog || cookLog->lastSequence() == checkpointSequence)) {
+        return;
+    }
+    if (!pendingHistory.empty()) {
+        json history = readHistory(historyFile);
+        for (auto& entry : pendingHistory) {
+            history.push_back(std::move(entry));
+        }
+        if (!writeDocument(historyFile, history, persistenceFormat)) {
+            std::cerr << "Unable to write history file " << historyFile << "\n";
+            return;
+        }
+        pendingHistory = json::array();
+    }
+
+    // Both files have been replaced and synced by now; only then can the log go.
+    if (saveIngredientsToFile(storageFile) && cookLog && checkpointSequence == cookLog->lastSequence()) {
+        cookLog->reset();
+    }
+}
+
+bool RecipeManager::saveIngredientsToFile(const std::string& filename) {
     json j;
     j["Fridge"] = fridge.toJSON();
     j["Pantry"] = pantry.toJSON();
+    // The in-memory stock already includes every logged cook.
+    std::uint64_t sequence = cookLog ? cookLog->lastSequence() : checkpointSequence;
+    if (sequence > 0) {
+        j["walSequence"] = sequence;
+    }
 
-    std::ofstream file(filename);
-    if (file.is_open()) {
-        file << j.dump(4);
-        file.close();
+    if (writeDocument(filename, j, persistenceFormat)) {
+        if (filename == storageFile) {
+            checkpointSequence = sequence;
+        }
         std::cout << "Ingredients saved to " << filename << "\n";
-    } else {
-        std::cerr << "Unable to open file " << filename << "\n";
+        return true;
     }
+    std::cerr << "Unable to open file " << filename << "\n";
+    return false;
 }
 
 void RecipeManager::viewRecipeHistory() {
-    std::ifstream file("history.json");
-
-    if (!file.is_open()) {
-        std::cerr << "History file does not exist. Initializing history.\n";
-        std::ofstream outfile("history.json");
-        outfile << "[]";  // Empty array
-        outfile.close();
-        return;
+    if (!pendingHistory.empty()) {
+        checkpoint();
     }
-
     json history;
     try {
-        file >> history;
+        if (!readDocument(historyFile, history)) {
+            std::cerr << "History file does not exist. Initializing history.\n";
+            std::ofstream outfile(historyFile);
+            outfile << "[]";  // Empty array
+            outfile.close();
+            return;
+        }
     } catch (json::parse_error& e) {
         std::cerr << "Error parsing history file: " << e.what() << "\n";
         std::cerr << "Resetting history to an empty array.\n";
-        std::ofstream outfile("history.json");
+        std::ofstream outfile(historyFile);
         outfile << "[]";
         outfile.close();
         return;
@@ -230,7 +667,7 @@ void RecipeManager::viewRecipeHistory() {
 
     if (!history.is_array()) {
         std::cerr << "History format is incorrect, resetting history to an empty array.\n";
-        std::ofstream outfile("history.json");
+        std::ofstream outfile(historyFile);
         outfile << "[]";
         outfile.close();
         return;
@@ -249,33 +686,40 @@ void RecipeManager::viewRecipeHistory() {
             std::cout << i + 1 << ". Invalid entry in history.\n";
         }
     }
+    std::vector<std::string> suggested = suggestFromHistory();
+    if (!suggested.empty()) {
+        std::cout << "Based on what you cooked recently, you might like:";
+        for (std::size_t i = 0; i < suggested.size(); ++i) {
+            std::cout << (i == 0 ? " " : ", ") << suggested[i];
+        }
+        std::cout << "\n";
+    }
 
     int choice;
     std::cout << "Enter the number of the recipe to view details or 0 to go back to the main menu: ";
     std::cin >> choice;
 
     if (choice > 0 && choice <= history.size()) {
-        std::string selectedRecipeName = history[choice - 1]["name"];
-        for (const auto& recipe : recipes) {
-            if (recipe.getRecipeName() == selectedRecipeName) {
-                displayFullRecipe(recipe);
-                break;
-            }
+        std::shared_ptr<const RecipeCatalog> snapshot = getCatalog();
+        const Recipe* recipe = findHistoryRecipe(*snapshot, history[choice - 1]);
+        if (recipe) {
+            displayFullRecipe(*recipe);
+        } else {
+            std::cout << "That recipe is no longer in the recipe list.\n";
         }
     } else if (choice == 0) {
         std::cout << "Returning to the main menu.\n";
     } else {
         std::cout << "Invalid choice. Returning to the main menu.\n";
     }
-
-    file.close();
 }
 
 void RecipeManager::menu() {
+    watchRecipes();
     int option;
     do {
         std::cout << "What would you like to do?\n";
-        std::cout << "1. Add ingredients\n2. Generate recipes\n3. View recipe history\n4. Check notifications (expiring soon and running low)\n5. Exit\n";
+        std::cout << "1. Add ingredients\n2. Generate recipes\n3. View recipe history\n4. Check notifications (expiring soon and running low)\n5. Plan meals for the next days\n6. Import ingredients from a CSV/TSV file\n7. Exit\n";
         std::cin >> option;
 
         switch (option) {
@@ -291,13 +735,62 @@ void RecipeManager::menu() {
             case 4:
                 fridge.expiringSoon();
                 pantry.runningLow();
+                for (const auto& name : suggestForExpiring()) {
+                    std::cout << "Suggested to use up expiring items: " << name << "\n";
+                }
+                {
+                    ShoppingList shopping = suggestShopping();
+                    if (!shopping.enabledRecipes.empty()) {
+                        std::cout << "Buying";
+                        for (std::size_t i = 0; i < shopping.items.size(); ++i) {
+                            std::cout << (i == 0 ? " " : ", ") << shopping.items[i];
+                        }
+                        std::cout << " would let you make " << shopping.enabledRecipes.size() << " more recipe(s).\n";
+                    }
+                }
+                break;
+            case 5: {
+                int days;
+                std::cout << "How many days do you want to plan? ";
+                std::cin >> days;
+                if (days > 0) {
+                    planMeals(days);
+                } else {
+                    std::cout << "Invalid number of days.\n";
+                }
+                break;
+            }
+            case 6: {
+                std::string path;
+                std::cout << "Path of the file to import: ";
+                std::cin >> path;
+                std::string answer;
+                std::cout << "Correct likely typos to known ingredient names? (y/n) ";
+                std::cin >> answer;
+                ImportReport report;
+                if (!importIngredients(path, report, answer == "y" || answer == "Y")) {
+                    std::cout << "Unable to open " << path << "\n";
+                    break;
+                }
+                std::cout << "Imported " << report.imported << " of " << report.lines << " line(s).\n";
+                if (report.corrected > 0) {
+                    std::cout << report.corrected << " item name(s) were corrected to a known ingredient:\n";
+                    for (const auto& correction : report.corrections) {
+                        std::cout << "  " << correction.first << " -> " << correction.second << "\n";
+                    }
+                }
+                if (report.skipped > 0) {
+                    std::cout << report.skipped << " line(s) could not be read, starting with line " << report.badLines.front() << ".\n";
+                }
                 break;
-            case 5:
+            }
+            case 7:
+                checkpoint();
                 std::cout << "Goodbye!\n";
                 break;
             default:
                 std::cout << "Invalid option. Please try again.\n";
                 break;
         }
-    } while (option != 5);
+    } while (option != 7);
 }
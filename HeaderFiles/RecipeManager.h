@@ -6,9 +6,29 @@
 #include <vector>
 #include <ctime>
 #include <algorithm>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
 #include "Fridge.h"
 #include "Pantry.h"
 #include "Recipe.h"
+#include "RecipeCatalog.h"
+#include "RecipeDeduplication.h"
+#include "CatalogWatcher.h"
+#include "FuzzyIngredientIndex.h"
+#include "PersistenceFormat.h"
+#include "RecipeQuery.h"
+#include "RecipeSimilarity.h"
+#include "ExpiryRanking.h"
+#include "IngredientBatch.h"
+#include "InventoryImport.h"
+#include "MealPlanner.h"
+#include "NameCompleter.h"
+#include "CivilDate.h"
+#include "Cooking.h"
+#include "ShoppingList.h"
+#include "SubstitutionGraph.h"
+#include "WriteAheadLog.h"
 #include "json.hpp"
 #include "Ingredient.h"
 
@@ -18,11 +38,45 @@ class RecipeManager {
 private:
     Fridge fridge;
     Pantry pantry;
-    std::vector<Recipe> recipes;
+    std::string recipeSource;
+    std::string storageFile;
+    std::string historyFile;
+    // Format used when writing storage and history; reads detect the format themselves.
+    PersistenceFormat persistenceFormat = PersistenceFormat::Json;
+    // Read from ingredient_aliases.json beside the recipes when the manager is built. Every
+    // catalog, index and substitution graph the manager builds uses it, so managers with
+    // different recipe directories do not share one table.
+    std::shared_ptr<const IngredientAliases> aliases;
+    // Published with std::atomic_store; readers take a snapshot with getCatalog() and keep
+    // using it even if a reload swaps in a newer catalog meanwhile.
+    std::shared_ptr<const RecipeCatalog> catalog;
+    // The catalog's ingredient names for typo correction; rebuilt and published with it.
+    std::shared_ptr<const FuzzyIngredientIndex> spelling;
+    // Read from ingredient_substitutes.json beside the recipes; used when matching recipes,
+    // and reread and published with the catalog.
+    std::shared_ptr<const SubstitutionGraph> substitutes;
+    // MinHash buckets over the catalog's ingredient sets; rebuilt and published with it.
+    std::shared_ptr<const RecipeSimilarityIndex> similarity;
+    // Cooked recipes are made durable in <storage file>.wal; storage and history are only
+    // rewritten at checkpoints. checkpointSequence is the last log entry the storage file
+    // already reflects, and pendingHistory the cooks not yet appended to the history file.
+    std::unique_ptr<WriteAheadLog> cookLog;
+    std::uint64_t checkpointSequence = 0;
+    json pendingHistory = json::array();
+    // Type-ahead over recipe and ingredient names. Recipes are ranked by how often they were
+    // cooked and ingredients by how many recipes use them. Updated as stock is added, recipes
+    // are cooked and the catalog is reloaded, which can happen on the watcher thread.
+    NameCompleter completer;
+    mutable std::shared_mutex completerLock;
+    // Declared last so the watcher thread is stopped before the catalog goes away.
+    std::unique_ptr<CatalogWatcher> watcher;
 
     void saveHistory(const Recipe& recipe);
     void displayFullRecipe(const Recipe& recipe);
-    void saveIngredientsToFile(const std::string& filename);
+    bool saveIngredientsToFile(const std::string& filename);
+    std::string cookLogPath() const;
+    void recoverCooks();
+    void buildCompleter();
 
 public:
     // Getter functions for accessing fridge and pantry
@@ -34,14 +88,80 @@ public:
         return pantry;
     }
 
-    // Constructor
-    RecipeManager(const std::string& recipeFilename);
+    std::shared_ptr<const RecipeCatalog> getCatalog() const {
+        return std::atomic_load(&catalog);
+    }
+
+    std::shared_ptr<const FuzzyIngredientIndex> getSpellingIndex() const {
+        return std::atomic_load(&spelling);
+    }
+
+    std::shared_ptr<const SubstitutionGraph> getSubstitutes() const {
+        return std::atomic_load(&substitutes);
+    }
+
+    // Holds the catalog it was built from, so ids in its results resolve against getCatalog() of the index.
+    std::shared_ptr<const RecipeSimilarityIndex> getSimilarityIndex() const {
+        return std::atomic_load(&similarity);
+    }
+
+    // Constructor: recipeFilename may be a recipes.json, a directory of shards, or a "dir/*.json" pattern
+    RecipeManager(const std::string& recipeFilename, const std::string& storageFilename = "storage.json",
+                  const std::string& historyFilename = "history.json");
+    ~RecipeManager();
     // Member functions
     void loadIngredientsFromFile(const std::string& filename);
+    void setPersistenceFormat(PersistenceFormat format);
+    void reloadRecipes();
+    void watchRecipes();
     void collectIngredients();
+    // Adds to the fridge and pantry in bulk: one merge pass, one message and one save of
+    // the storage file when the batch is committed.
+    IngredientBatch beginIngredientBatch();
+    // Adds the items of a CSV/TSV delivery manifest and saves once. With correctSpelling,
+    // likely typos of ingredient names the catalog knows are corrected, each listed in the
+    // report. Returns false if the file cannot be read.
+    bool importIngredients(const std::string& path, ImportReport& report, bool correctSpelling = false);
     void matchRecipes();
+    // Recipe and ingredient names starting with prefix (any case), most popular first.
+    std::vector<Completion> completeName(const std::string& prefix, std::size_t limit = NameCompleter::kTopK) const;
+    // Recipes sharing the most main ingredients with the named one, most similar first.
+    std::vector<std::string> similarRecipes(const std::string& recipeName, std::size_t limit = 5) const;
+    // Recipes most like any of the last `recent` distinct recipes in the history.
+    std::vector<std::string> suggestFromHistory(std::size_t recent = 5, std::size_t limit = 5) const;
+    // Runs a query against the current catalog, with the fridge and pantry as its inventory
+    // and the fridge's items expiring within five days as its expiring items.
+    std::vector<std::string> findRecipes(const RecipeQuery& query) const;
+    // Recipes that use up fridge items expiring within a week, most urgent first.
+    // Recipes missing at most maxMissing main ingredients are included.
+    std::vector<std::string> suggestForExpiring(std::size_t maxMissing = 1, std::size_t limit = 5) const;
+    // The few ingredients whose purchase would let the most additional recipes be made.
+    ShoppingList suggestShopping(std::size_t maxItems = 5) const;
+    // Prints a plan of one recipe per day for the next `days` days that uses up the
+    // fridge and pantry stock before it expires. The stored stock is not changed.
+    void planMeals(int days);
+    // Cooks a recipe: takes its ingredients out of the fridge and pantry, records it in the
+    // history and logs both as one entry. False (and nothing changes) if the stock is short.
+    // Ingredients with a substitute are taken as that item instead.
+    bool cook(const std::string& recipeName, const Substitutions& substitutions = Substitutions());
+    // Cooks several recipes in order as one batch with a single disk sync; returns how many
+    // were cooked. Recipes the remaining stock cannot cover are skipped.
+    std::size_t cookAll(const std::vector<std::string>& recipeNames, const Substitutions& substitutions = Substitutions());
+    // Writes storage and history and empties the cook log. Runs on its own every
+    // kCheckpointInterval cooks, before history is shown, on exit and on destruction.
+    void checkpoint();
+    static const std::size_t kCheckpointInterval = 1000;
     void viewRecipeHistory();
     void menu();
 };
 
+// Appends a {"name", "id", "date"} entry for today to a history file, creating it if needed.
+// The id is left out when it is RecipeCatalog::npos.
+void appendRecipeHistory(const std::string& filename, const std::string& recipeName,
+                         std::size_t recipeId = RecipeCatalog::npos, PersistenceFormat format = PersistenceFormat::Json);
+
+// Resolves a history entry to a recipe in O(1): by its stored id when that still names the
+// same recipe, otherwise by name. Returns nullptr if the recipe is no longer in the catalog.
+const Recipe* findHistoryRecipe(const RecipeCatalog& catalog, const json& entry);
+
 #endif
@@ -0,0 +1,306 @@
+#include "RecipeQuery.h"
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+// Selectivity used when the catalog keeps no statistics for a condition.
+static const double kUnknownSelectivity = 0.5;
+
+RecipeQuery::RecipeQuery(Kind k, std::string n, int m, std::vector<RecipeQuery> c)
+    : kind(k), name(std::move(n)), minutes(m), children(std::move(c)) {}
+
+RecipeQuery RecipeQuery::allOf(std::vector<RecipeQuery> terms) { return RecipeQuery(Kind::AllOf, "", 0, std::move(terms)); }
+RecipeQuery RecipeQuery::anyOf(std::vector<RecipeQuery> terms) { return RecipeQuery(Kind::AnyOf, "", 0, std::move(terms)); }
+RecipeQuery RecipeQuery::negate(RecipeQuery term) { return RecipeQuery(Kind::Not, "", 0, { std::move(term) }); }
+RecipeQuery RecipeQuery::inCategory(const std::string& category) { return RecipeQuery(Kind::InCategory, category); }
+RecipeQuery RecipeQuery::readyWithin(int limit) { return RecipeQuery(Kind::ReadyWithin, "", limit); }
+RecipeQuery RecipeQuery::withIngredient(const std::string& ingredient) { return RecipeQuery(Kind::WithIngredient, ingredient); }
+RecipeQuery RecipeQuery::withoutIngredient(const std::string& ingredient) { return RecipeQuery(Kind::WithoutIngredient, ingredient); }
+RecipeQuery RecipeQuery::usesExpiringItems() { return RecipeQuery(Kind::UsesExpiringItems); }
+RecipeQuery RecipeQuery::makeable() { return RecipeQuery(Kind::Makeable); }
+
+RecipeQuery::Kind RecipeQuery::getKind() const { return kind; }
+const std::string& RecipeQuery::getName() const { return name; }
+int RecipeQuery::getMinutes() const { return minutes; }
+const std::vector<RecipeQuery>& RecipeQuery::getChildren() const { return children; }
+
+// A query with its names resolved to catalog ids.
+struct RecipeQueryEngine::Compiled {
+    RecipeQuery::Kind kind;
+    std::string name;   // as written in the query, for plan descriptions
+    CategoryId category = CategoryRegistry::kUnknown;
+    IngredientId ingredient = RecipeCatalog::kNoIngredient;
+    int minutes = 0;
+    std::vector<IngredientId> expiringIds;
+    std::vector<Compiled> children;
+};
+
+RecipeQueryEngine::RecipeQueryEngine(const RecipeCatalog& recipeCatalog) : catalog(recipeCatalog) {}
+
+RecipeQueryEngine::Compiled RecipeQueryEngine::compile(const RecipeQuery& query, const QueryContext& context) const {
+    Compiled node;
+    node.kind = query.getKind();
+    node.minutes = query.getMinutes();
+    node.name = query.getName();
+    switch (node.kind) {
+        case RecipeQuery::Kind::InCategory:
+            node.category = catalog.getCategories().find(query.getName());
+            break;
+        case RecipeQuery::Kind::WithIngredient:
+        case RecipeQuery::Kind::WithoutIngredient:
+            node.ingredient = catalog.findIngredient(query.getName());
+            break;
+        case RecipeQuery::Kind::UsesExpiringItems:
+            for (const auto& item : context.expiringItems) {
+                IngredientId id = catalog.findIngredient(item);
+                if (id != RecipeCatalog::kNoIngredient) {
+                    node.expiringIds.push_back(id);
+                }
+            }
+            std::sort(node.expiringIds.begin(), node.expiringIds.end());
+            node.expiringIds.erase(std::unique(node.expiringIds.begin(), node.expiringIds.end()), node.expiringIds.end());
+            break;
+        default:
+            break;
+    }
+    for (const auto& child : query.getChildren()) {
+        node.children.push_back(compile(child, context));
+    }
+    return node;
+}
+
+double RecipeQueryEngine::selectivity(const Compiled& node) const {
+    double total = std::max<std::size_t>(1, catalog.size());
+    switch (node.kind) {
+        case RecipeQuery::Kind::AllOf: {
+            double s = 1.0;
+            for (const auto& child : node.children) {
+                s *= selectivity(child);
+            }
+            return s;
+        }
+        case RecipeQuery::Kind::AnyOf: {
+            double none = 1.0;
+            for (const auto& child : node.children) {
+                none *= 1.0 - selectivity(child);
+            }
+            return 1.0 - none;
+        }
+        case RecipeQuery::Kind::Not:
+            return 1.0 - selectivity(node.children.at(0));
+        case RecipeQuery::Kind::InCategory: {
+            RecipeCatalog::Partition p = catalog.getPartition(node.category);
+            return (p.end - p.begin) / total;
+        }
+        case RecipeQuery::Kind::ReadyWithin:
+            return catalog.getRecipesByTime(0, node.minutes).size() / total;
+        case RecipeQuery::Kind::WithIngredient:
+            return catalog.getRecipesUsing(node.ingredient).size() / total;
+        case RecipeQuery::Kind::WithoutIngredient:
+            return 1.0 - catalog.getRecipesUsing(node.ingredient).size() / total;
+        case RecipeQuery::Kind::UsesExpiringItems: {
+            std::size_t uses = 0;
+            for (IngredientId id : node.expiringIds) {
+                uses += catalog.getRecipesUsing(id).size();
+            }
+            return std::min(1.0, uses / total);
+        }
+        default:
+            return kUnknownSelectivity;
+    }
+}
+
+bool RecipeQueryEngine::matches(const Compiled& node, std::size_t recipeId, const std::vector<char>& inStock, const std::vector<char>& expiring) const {
+    switch (node.kind) {
+        case RecipeQuery::Kind::AllOf:
+            for (const auto& child : node.children) {
+                if (!matches(child, recipeId, inStock, expiring)) {
+                    return false;
+                }
+            }
+            return true;
+        case RecipeQuery::Kind::AnyOf:
+            for (const auto& child : node.children) {
+                if (matches(child, recipeId, inStock, expiring)) {
+                    return true;
+                }
+            }
+            return false;
+        case RecipeQuery::Kind::Not:
+            return !matches(node.children.at(0), recipeId, inStock, expiring);
+        case RecipeQuery::Kind::InCategory:
+            return catalog.getCategoryId(recipeId) == node.category;
+        case RecipeQuery::Kind::ReadyWithin: {
+            int time = catalog.getRecipes()[recipeId].getTimeMinutes();
+            return time >= 0 && time <= node.minutes;
+        }
+        case RecipeQuery::Kind::WithIngredient:
+        case RecipeQuery::Kind::WithoutIngredient: {
+            IdRange ingredients = catalog.getRecipeIngredients(recipeId);
+            bool uses = std::find(ingredients.begin(), ingredients.end(), node.ingredient) != ingredients.end();
+            return node.kind == RecipeQuery::Kind::WithIngredient ? uses : !uses;
+        }
+        case RecipeQuery::Kind::UsesExpiringItems:
+            for (IngredientId id : catalog.getRecipeIngredients(recipeId)) {
+                if (expiring[id]) {
+                    return true;
+                }
+            }
+            return false;
+        case RecipeQuery::Kind::Makeable:
+            for (IngredientId id : catalog.getRecipeIngredients(recipeId)) {
+                if (!inStock[id]) {
+                    return false;
+                }
+            }
+            return true;
+    }
+    return false;
+}
+
+// Whether a condition can produce its own candidate list, and how long that list is.
+bool RecipeQueryEngine::accessCost(const Compiled& node, std::size_t& cost) const {
+    switch (node.kind) {
+        case RecipeQuery::Kind::InCategory: {
+            RecipeCatalog::Partition p = catalog.getPartition(node.category);
+            cost = p.end - p.begin;
+            return true;
+        }
+        case RecipeQuery::Kind::ReadyWithin:
+            cost = catalog.getRecipesByTime(0, node.minutes).size();
+            return true;
+        case RecipeQuery::Kind::WithIngredient:
+            cost = catalog.getRecipesUsing(node.ingredient).size();
+            return true;
+        case RecipeQuery::Kind::UsesExpiringItems:
+            cost = 0;
+            for (IngredientId id : node.expiringIds) {
+                cost += catalog.getRecipesUsing(id).size();
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+RecipeQueryEngine::Plan RecipeQueryEngine::choosePlan(const Compiled& root, const Compiled*& accessNode) const {
+    // Only conditions that every match must satisfy can narrow the candidates: the root
+    // itself, or the direct children of a top-level allOf.
+    std::vector<const Compiled*> required;
+    if (root.kind == RecipeQuery::Kind::AllOf) {
+        for (const auto& child : root.children) {
+            required.push_back(&child);
+        }
+    } else {
+        required.push_back(&root);
+    }
+
+    accessNode = nullptr;
+    std::size_t best = catalog.size();
+    for (const Compiled* node : required) {
+        std::size_t cost;
+        if (accessCost(*node, cost) && cost < best) {
+            best = cost;
+            accessNode = node;
+        }
+    }
+
+    Plan plan;
+    plan.candidates = best;
+    plan.estimatedMatches = selectivity(root) * catalog.size();
+
+    std::ostringstream description;
+    if (!accessNode) {
+        plan.path = AccessPath::FullScan;
+        description << "full scan";
+    } else if (accessNode->kind == RecipeQuery::Kind::InCategory) {
+        plan.path = AccessPath::CategoryPartition;
+        description << "category partition '" << accessNode->name << "'";
+    } else if (accessNode->kind == RecipeQuery::Kind::WithIngredient) {
+        plan.path = AccessPath::IngredientPostings;
+        description << "recipes using '" << accessNode->name << "'";
+    } else if (accessNode->kind == RecipeQuery::Kind::ReadyWithin) {
+        plan.path = AccessPath::TimeRange;
+        description << "recipes ready within " << accessNode->minutes << " minutes";
+    } else {
+        plan.path = AccessPath::ExpiringPostings;
+        description << "recipes using " << accessNode->expiringIds.size() << " expiring ingredients";
+    }
+    description << " (" << best << " of " << catalog.size() << " recipes), about " << static_cast<std::size_t>(plan.estimatedMatches + 0.5) << " expected matches";
+    plan.description = description.str();
+    return plan;
+}
+
+RecipeQueryEngine::Plan RecipeQueryEngine::plan(const RecipeQuery& query, const QueryContext& context) const {
+    const Compiled* accessNode;
+    return choosePlan(compile(query, context), accessNode);
+}
+
+std::vector<std::size_t> RecipeQueryEngine::execute(const RecipeQuery& query, const QueryContext& context, Plan* usedPlan) const {
+    Compiled root = compile(query, context);
+    const Compiled* accessNode;
+    Plan chosen = choosePlan(root, accessNode);
+    if (usedPlan) {
+        *usedPlan = chosen;
+    }
+
+    std::vector<char> inStock(catalog.ingredientCount(), 0);
+    for (const auto& ingredient : context.inventory) {
+        IngredientId id = catalog.findIngredient(ingredient.getName());
+        if (id != RecipeCatalog::kNoIngredient) {
+            inStock[id] = 1;
+        }
+    }
+    std::vector<char> expiring(catalog.ingredientCount(), 0);
+    for (const auto& item : context.expiringItems) {
+        IngredientId id = catalog.findIngredient(item);
+        if (id != RecipeCatalog::kNoIngredient) {
+            expiring[id] = 1;
+        }
+    }
+
+    std::vector<std::size_t> candidates;
+    switch (chosen.path) {
+        case AccessPath::FullScan:
+            for (std::size_t id = 0; id < catalog.size(); ++id) {
+                candidates.push_back(id);
+            }
+            break;
+        case AccessPath::CategoryPartition: {
+            RecipeCatalog::Partition p = catalog.getPartition(accessNode->category);
+            for (std::size_t id = p.begin; id < p.end; ++id) {
+                candidates.push_back(id);
+            }
+            break;
+        }
+        case AccessPath::IngredientPostings:
+            for (std::uint32_t id : catalog.getRecipesUsing(accessNode->ingredient)) {
+                candidates.push_back(id);
+            }
+            break;
+        case AccessPath::ExpiringPostings:
+            for (IngredientId ingredient : accessNode->expiringIds) {
+                for (std::uint32_t id : catalog.getRecipesUsing(ingredient)) {
+                    candidates.push_back(id);
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            break;
+        case AccessPath::TimeRange:
+            for (std::uint32_t id : catalog.getRecipesByTime(0, accessNode->minutes)) {
+                candidates.push_back(id);
+            }
+            // The time index is ordered by time; results are returned in catalog order.
+            std::sort(candidates.begin(), candidates.end());
+            break;
+    }
+
+    std::vector<std::size_t> result;
+    for (std::size_t id : candidates) {
+        if (matches(root, id, inStock, expiring)) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
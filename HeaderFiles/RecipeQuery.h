@@ -0,0 +1,97 @@
+#ifndef RECIPEQUERY_H
+#define RECIPEQUERY_H
+
+#include <string>
+#include <vector>
+#include "Ingredient.h"
+#include "RecipeCatalog.h"
+
+// A predicate over recipes, built from the static constructors below and combined
+// with allOf / anyOf / negate, e.g.
+//   RecipeQuery::allOf({ RecipeQuery::inCategory("Savory"), RecipeQuery::readyWithin(30),
+//                        RecipeQuery::withoutIngredient("beef"), RecipeQuery::makeable() })
+class RecipeQuery {
+public:
+    enum class Kind {
+        AllOf,
+        AnyOf,
+        Not,
+        InCategory,
+        ReadyWithin,        // preparation time known and at most `minutes`
+        WithIngredient,
+        WithoutIngredient,
+        UsesExpiringItems,  // uses at least one of QueryContext::expiringItems
+        Makeable            // every main ingredient is in QueryContext::inventory
+    };
+
+private:
+    Kind kind;
+    std::string name;
+    int minutes;
+    std::vector<RecipeQuery> children;
+
+    RecipeQuery(Kind kind, std::string name = "", int minutes = 0, std::vector<RecipeQuery> children = {});
+
+public:
+    static RecipeQuery allOf(std::vector<RecipeQuery> terms);
+    static RecipeQuery anyOf(std::vector<RecipeQuery> terms);
+    static RecipeQuery negate(RecipeQuery term);
+    static RecipeQuery inCategory(const std::string& category);
+    static RecipeQuery readyWithin(int minutes);
+    static RecipeQuery withIngredient(const std::string& ingredient);
+    static RecipeQuery withoutIngredient(const std::string& ingredient);
+    static RecipeQuery usesExpiringItems();
+    static RecipeQuery makeable();
+
+    Kind getKind() const;
+    const std::string& getName() const;
+    int getMinutes() const;
+    const std::vector<RecipeQuery>& getChildren() const;
+};
+
+// The household state some predicates refer to.
+struct QueryContext {
+    std::vector<Ingredient> inventory;
+    std::vector<std::string> expiringItems;
+};
+
+// Runs RecipeQuery predicates against one catalog.
+// The planner estimates how selective each top-level condition is from the catalog's
+// statistics (partition sizes, ingredient posting-list lengths and the time index), fetches candidates
+// through the cheapest access path, and checks the whole predicate on those candidates only.
+class RecipeQueryEngine {
+public:
+    enum class AccessPath {
+        FullScan,
+        CategoryPartition,
+        IngredientPostings,
+        ExpiringPostings,
+        TimeRange
+    };
+
+    struct Plan {
+        AccessPath path;
+        std::size_t candidates;     // recipes the access path will produce
+        double estimatedMatches;    // expected result size from the selectivity estimates
+        std::string description;
+    };
+
+private:
+    const RecipeCatalog& catalog;
+
+    struct Compiled;
+    Compiled compile(const RecipeQuery& query, const QueryContext& context) const;
+    double selectivity(const Compiled& node) const;
+    bool accessCost(const Compiled& node, std::size_t& cost) const;
+    bool matches(const Compiled& node, std::size_t recipeId, const std::vector<char>& inStock, const std::vector<char>& expiring) const;
+    Plan choosePlan(const Compiled& root, const Compiled*& accessNode) const;
+
+public:
+    explicit RecipeQueryEngine(const RecipeCatalog& catalog);
+
+    Plan plan(const RecipeQuery& query, const QueryContext& context) const;
+    // Matching recipe ids in catalog order.
+    std::vector<std::size_t> execute(const RecipeQuery& query, const QueryContext& context, Plan* usedPlan = nullptr) const;
+};
+
+#endif
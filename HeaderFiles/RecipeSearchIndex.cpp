@@ -0,0 +1,261 @@
+#include "RecipeSearchIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <unordered_map>
+
+// Standard BM25 parameters.
+static const double kK1 = 1.2;
+static const double kB = 0.75;
+// A word in the recipe name counts as much as this many words in the steps.
+static const std::uint32_t kNameWeight = 3;
+// Caps how many vocabulary terms one prefix or misspelling can expand into.
+static const std::size_t kMaxExpansions = 64;
+
+static void putVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+static std::uint32_t getVarint(const std::uint8_t*& p) {
+    std::uint32_t value = 0;
+    for (int shift = 0; ; shift += 7) {
+        std::uint8_t byte = *p++;
+        value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+}
+
+// Deletions are filed under 32 bits of their hash, next to the term id.
+static std::uint32_t shortHash(std::uint64_t hash) {
+    return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+}
+
+std::vector<std::string> RecipeSearchIndex::tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (char c : text) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (u < 0x80 && std::isalnum(u)) {
+            current += static_cast<char>(std::tolower(u));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(std::move(current));
+    }
+    return tokens;
+}
+
+RecipeSearchIndex::RecipeSearchIndex() : averageLength(0) {
+    postingOffsets.push_back(0);
+}
+
+RecipeSearchIndex::RecipeSearchIndex(const std::vector<Recipe>& recipes) : averageLength(0) {
+    // term -> (docId, frequency) in increasing docId order
+    std::unordered_map<std::string, std::vector<std::pair<std::uint32_t, std::uint32_t>>> inverted;
+    documentLengths.reserve(recipes.size());
+
+    std::uint64_t totalLength = 0;
+    for (std::uint32_t docId = 0; docId < recipes.size(); ++docId) {
+        const Recipe& recipe = recipes[docId];
+        std::unordered_map<std::string, std::uint32_t> frequencies;
+        std::uint32_t length = 0;
+        auto addText = [&](const std::string& text, std::uint32_t weight) {
+            for (auto& token : tokenize(text)) {
+                frequencies[std::move(token)] += weight;
+                length += weight;
+            }
+        };
+
+        addText(recipe.getRecipeName(), kNameWeight);
+        for (const auto& step : recipe.getSteps()) {
+            addText(step, 1);
+        }
+        for (const auto& condiment : recipe.getCondiments()) {
+            addText(condiment.first, 1);
+        }
+
+        for (auto& entry : frequencies) {
+            inverted[entry.first].emplace_back(docId, entry.second);
+        }
+        documentLengths.push_back(length);
+        totalLength += length;
+    }
+    averageLength = recipes.empty() ? 0 : static_cast<double>(totalLength) / recipes.size();
+
+    terms.reserve(inverted.size());
+    for (const auto& entry : inverted) {
+        terms.push_back(entry.first);
+    }
+    std::sort(terms.begin(), terms.end());
+
+    postingOffsets.reserve(terms.size() + 1);
+    documentFrequency.reserve(terms.size());
+    for (const auto& term : terms) {
+        const auto& list = inverted[term];
+        postingOffsets.push_back(static_cast<std::uint32_t>(postings.size()));
+        documentFrequency.push_back(static_cast<std::uint32_t>(list.size()));
+        std::uint32_t previousDoc = 0;
+        for (const auto& posting : list) {
+            putVarint(postings, posting.first - previousDoc);
+            putVarint(postings, posting.second);
+            previousDoc = posting.first;
+        }
+    }
+    postingOffsets.push_back(static_cast<std::uint32_t>(postings.size()));
+    postings.shrink_to_fit();
+
+    std::vector<std::uint64_t> hashes;
+    for (std::uint32_t termId = 0; termId < terms.size(); ++termId) {
+        deletionHashes(terms[termId], kIndexedDistance, hashes);
+        for (std::uint64_t hash : hashes) {
+            deletions.push_back(static_cast<std::uint64_t>(shortHash(hash)) << 32 | termId);
+        }
+    }
+    std::sort(deletions.begin(), deletions.end());
+    deletions.shrink_to_fit();
+}
+
+std::size_t RecipeSearchIndex::findTerm(const std::string& term) const {
+    auto it = std::lower_bound(terms.begin(), terms.end(), term);
+    return (it != terms.end() && *it == term) ? static_cast<std::size_t>(it - terms.begin()) : terms.size();
+}
+
+void RecipeSearchIndex::scoreTerm(std::size_t termId, double weight, std::vector<double>& scores) const {
+    double documents = static_cast<double>(documentLengths.size());
+    double df = documentFrequency[termId];
+    double idf = std::log((documents - df + 0.5) / (df + 0.5) + 1.0);
+
+    const std::uint8_t* p = postings.data() + postingOffsets[termId];
+    const std::uint8_t* end = postings.data() + postingOffsets[termId + 1];
+    std::uint32_t docId = 0;
+    while (p < end) {
+        docId += getVarint(p);
+        double tf = getVarint(p);
+        double norm = kK1 * (1 - kB + kB * documentLengths[docId] / averageLength);
+        scores[docId] += weight * idf * tf * (kK1 + 1) / (tf + norm);
+    }
+}
+
+std::vector<RecipeSearchIndex::Result> RecipeSearchIndex::search(const std::string& query, std::size_t limit) const {
+    std::vector<Result> results;
+    std::vector<std::string> words = tokenize(query);
+    if (words.empty() || terms.empty()) {
+        return results;
+    }
+
+    // Unless the query ends in a separator, the last word may still be incomplete.
+    bool lastIsPrefix = std::isalnum(static_cast<unsigned char>(query.back())) != 0;
+
+    std::vector<double> scores(documentLengths.size(), 0.0);
+    for (std::size_t w = 0; w < words.size(); ++w) {
+        const std::string& word = words[w];
+        std::size_t exact = findTerm(word);
+        if (exact != terms.size()) {
+            scoreTerm(exact, 1.0, scores);
+        }
+
+        if (w + 1 == words.size() && lastIsPrefix) {
+            auto it = std::lower_bound(terms.begin(), terms.end(), word);
+            for (std::size_t n = 0; it != terms.end() && n < kMaxExpansions && it->compare(0, word.size(), word) == 0; ++it, ++n) {
+                if (*it != word) {
+                    scoreTerm(static_cast<std::size_t>(it - terms.begin()), 0.8, scores);
+                }
+            }
+        } else if (exact == terms.size()) {
+            std::size_t maxDistance = word.size() >= 5 ? 2 : 1;
+            for (const auto& similar : similarTerms(word, maxDistance)) {
+                double distance = static_cast<double>(boundedEditDistance(word, similar, maxDistance));
+                scoreTerm(findTerm(similar), 1.0 / (1.0 + distance), scores);
+            }
+        }
+    }
+
+    for (std::size_t docId = 0; docId < scores.size(); ++docId) {
+        if (scores[docId] > 0) {
+            results.push_back({ docId, scores[docId] });
+        }
+    }
+    auto byScore = [](const Result& a, const Result& b) {
+        return a.score != b.score ? a.score > b.score : a.recipeId < b.recipeId;
+    };
+    if (results.size() > limit) {
+        std::partial_sort(results.begin(), results.begin() + limit, results.end(), byScore);
+        results.resize(limit);
+    } else {
+        std::sort(results.begin(), results.end(), byScore);
+    }
+    return results;
+}
+
+std::vector<std::string> RecipeSearchIndex::completeTerm(const std::string& prefix, std::size_t limit) const {
+    std::vector<std::string> completions;
+    std::string lower = prefix;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    for (auto it = std::lower_bound(terms.begin(), terms.end(), lower);
+         it != terms.end() && completions.size() < limit && it->compare(0, lower.size(), lower) == 0; ++it) {
+        completions.push_back(*it);
+    }
+    return completions;
+}
+
+std::vector<std::string> RecipeSearchIndex::similarTerms(const std::string& term, std::size_t maxDistance) const {
+    // A term within k edits shares a string with the query once each has had at most k
+    // characters deleted (a substitution is one deletion on each side).
+    std::vector<std::uint32_t> candidates;
+    if (maxDistance > kIndexedDistance) {
+        for (std::uint32_t termId = 0; termId < terms.size(); ++termId) {
+            candidates.push_back(termId);
+        }
+    } else {
+        std::vector<std::uint64_t> hashes;
+        deletionHashes(term, maxDistance, hashes);
+        for (std::uint64_t hash : hashes) {
+            std::uint64_t first = static_cast<std::uint64_t>(shortHash(hash)) << 32;
+            for (auto it = std::lower_bound(deletions.begin(), deletions.end(), first); it != deletions.end() && (*it >> 32) == (first >> 32); ++it) {
+                candidates.push_back(static_cast<std::uint32_t>(*it));
+            }
+        }
+        // In term order, so equally close terms come out alphabetically.
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    std::vector<std::pair<std::size_t, const std::string*>> matches;
+    EditDistancePattern pattern(term);
+    for (std::uint32_t candidate : candidates) {
+        const std::string& other = terms[candidate];
+        std::size_t gap = other.size() > term.size() ? other.size() - term.size() : term.size() - other.size();
+        if (gap > maxDistance) {
+            continue;
+        }
+        std::size_t distance = pattern.distance(other);
+        if (distance <= maxDistance) {
+            matches.emplace_back(distance, &terms[candidate]);
+        }
+    }
+    std::stable_sort(matches.begin(), matches.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<std::string> similar;
+    for (std::size_t i = 0; i < matches.size() && i < kMaxExpansions; ++i) {
+        similar.push_back(*matches[i].second);
+    }
+    return similar;
+}
+
+std::size_t RecipeSearchIndex::termCount() const {
+    return terms.size();
+}
+
+std::size_t RecipeSearchIndex::postingBytes() const {
+    return postings.size();
+}
@@ -0,0 +1,58 @@
+#ifndef RECIPESEARCHINDEX_H
+#define RECIPESEARCHINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "EditDistance.h"
+#include "Recipe.h"
+
+// Inverted text index over recipe names, steps and condiments, ranked with BM25.
+// Posting lists are stored as delta + varint encoded bytes in a single buffer.
+// The last word of a query is treated as a prefix (the user is still typing it), and
+// words that are not in the vocabulary are matched against close misspellings. Those are
+// found through a deletion dictionary (see deletionHashes), so only the terms that
+// share a deletion with the word are compared, not the whole vocabulary.
+class RecipeSearchIndex {
+public:
+    struct Result {
+        std::size_t recipeId;   // position in the vector the index was built from
+        double score;
+    };
+
+private:
+    std::vector<std::string> terms;              // sorted, so prefixes are a contiguous range
+    std::vector<std::uint32_t> postingOffsets;   // terms.size() + 1 offsets into postings
+    std::vector<std::uint32_t> documentFrequency;
+    std::vector<std::uint8_t> postings;          // per term: (docId delta, term frequency) varint pairs
+    std::vector<std::uint32_t> documentLengths;
+    double averageLength;
+    // Sorted (hash << 32 | term id) for the term and each string left after deleting up to
+    // kIndexedDistance of its characters. A hash collision only adds a candidate.
+    std::vector<std::uint64_t> deletions;
+
+    void scoreTerm(std::size_t termId, double weight, std::vector<double>& scores) const;
+    std::size_t findTerm(const std::string& term) const;
+
+public:
+    RecipeSearchIndex();
+    explicit RecipeSearchIndex(const std::vector<Recipe>& recipes);
+
+    std::vector<Result> search(const std::string& query, std::size_t limit = 10) const;
+
+    // Vocabulary terms starting with prefix, in alphabetical order.
+    std::vector<std::string> completeTerm(const std::string& prefix, std::size_t limit = 10) const;
+    // The most edits the deletion dictionary covers; similarTerms scans every term beyond it.
+    static constexpr std::size_t kIndexedDistance = 2;
+
+    // Vocabulary terms within maxDistance edits of term, closest first.
+    std::vector<std::string> similarTerms(const std::string& term, std::size_t maxDistance = 2) const;
+
+    std::size_t termCount() const;
+    std::size_t postingBytes() const;
+
+    // Lower-cased runs of ASCII letters and digits.
+    static std::vector<std::string> tokenize(const std::string& text);
+};
+
+#endif
@@ -0,0 +1,212 @@
+#include "RecipeSimilarity.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+// Recipes (or bands) handed to a worker at a time while building.
+static const std::size_t kBuildChunk = 512;
+
+// Runs work(begin, end) over [0, count) in chunks on threadCount threads, the calling
+// thread being one of them.
+template <typename Work>
+static void forChunks(std::size_t count, std::size_t chunk, unsigned threadCount, Work work) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t workerCount = std::max<std::size_t>(1, std::min<std::size_t>(threadCount, (count + chunk - 1) / chunk));
+    std::atomic<std::size_t> next(0);
+    auto run = [&]() {
+        for (std::size_t begin = next.fetch_add(chunk); begin < count; begin = next.fetch_add(chunk)) {
+            work(begin, std::min(begin + chunk, count));
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 1; worker < workerCount; ++worker) {
+        workers.emplace_back(run);
+    }
+    run();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+RecipeSimilarityIndex::RecipeSimilarityIndex(std::shared_ptr<const RecipeCatalog> recipeCatalog, const SimilarityOptions& indexOptions)
+    : catalog(std::move(recipeCatalog)), options(indexOptions),
+      sketch(std::max(options.bands, 1u) * std::max(options.rows, 1u)) {
+    options.bands = std::max(options.bands, 1u);
+    options.rows = std::max(options.rows, 1u);
+    const std::size_t hashCount = sketch.size();
+
+    const std::size_t recipeCount = catalog->size();
+    setOffsets.reserve(recipeCount + 1);
+    setOffsets.push_back(0);
+    std::vector<std::uint32_t> indexed;   // recipes with at least one ingredient
+    for (std::size_t recipeId = 0; recipeId < recipeCount; ++recipeId) {
+        IdRange ingredients = catalog->getRecipeIngredients(recipeId);
+        std::size_t start = sets.size();
+        sets.insert(sets.end(), ingredients.begin(), ingredients.end());
+        std::sort(sets.begin() + start, sets.end());
+        sets.erase(std::unique(sets.begin() + start, sets.end()), sets.end());
+        setOffsets.push_back(static_cast<std::uint32_t>(sets.size()));
+        if (sets.size() > start) {
+            indexed.push_back(static_cast<std::uint32_t>(recipeId));
+        }
+    }
+    indexedCount = indexed.size();
+
+    // Signatures are only needed to file the recipes into buckets, so they are not kept.
+    std::vector<std::uint32_t> signatures(indexedCount * hashCount);
+    forChunks(indexedCount, kBuildChunk, options.threadCount, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            std::uint32_t recipeId = indexed[i];
+            signatureOf(sets.data() + setOffsets[recipeId], sets.data() + setOffsets[recipeId + 1], &signatures[i * hashCount]);
+        }
+    });
+
+    bucketKeys.resize(indexedCount * options.bands);
+    bucketRecipes.resize(indexedCount * options.bands);
+    forChunks(options.bands, 1, options.threadCount, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> band(indexedCount);
+        for (std::size_t b = begin; b < end; ++b) {
+            for (std::size_t i = 0; i < indexedCount; ++i) {
+                std::uint64_t key = MinHashSketch::bandKey(&signatures[i * hashCount], static_cast<std::uint32_t>(b), options.rows);
+                band[i] = std::make_pair(key, indexed[i]);
+            }
+            std::sort(band.begin(), band.end());
+            for (std::size_t i = 0; i < indexedCount; ++i) {
+                bucketKeys[b * indexedCount + i] = band[i].first;
+                bucketRecipes[b * indexedCount + i] = band[i].second;
+            }
+        }
+    });
+}
+
+void RecipeSimilarityIndex::signatureOf(const IngredientId* first, const IngredientId* last, std::uint32_t* signature) const {
+    sketch.reset(signature);
+    for (const IngredientId* it = first; it != last; ++it) {
+        sketch.add(MinHashSketch::mix(*it), signature);
+    }
+}
+
+const RecipeCatalog& RecipeSimilarityIndex::getCatalog() const {
+    return *catalog;
+}
+
+float RecipeSimilarityIndex::jaccard(std::size_t a, std::size_t b) const {
+    const IngredientId* first = sets.data() + setOffsets[a];
+    const IngredientId* firstEnd = sets.data() + setOffsets[a + 1];
+    const IngredientId* second = sets.data() + setOffsets[b];
+    const IngredientId* secondEnd = sets.data() + setOffsets[b + 1];
+    std::size_t total = static_cast<std::size_t>((firstEnd - first) + (secondEnd - second));
+    std::size_t shared = 0;
+    while (first != firstEnd && second != secondEnd) {
+        if (*first < *second) {
+            ++first;
+        } else if (*second < *first) {
+            ++second;
+        } else {
+            ++shared;
+            ++first;
+            ++second;
+        }
+    }
+    return total == shared ? 0.0f : static_cast<float>(shared) / static_cast<float>(total - shared);
+}
+
+std::vector<RecipeSimilarityIndex::Similar> RecipeSimilarityIndex::query(const std::vector<IngredientId>& ingredients,
+                                                                          const std::vector<std::size_t>& exclude, std::size_t limit) const {
+    std::vector<Similar> found;
+    if (ingredients.empty() || indexedCount == 0) {
+        return found;
+    }
+    std::vector<std::uint32_t> signature(sketch.size());
+    signatureOf(ingredients.data(), ingredients.data() + ingredients.size(), signature.data());
+
+    std::vector<std::uint32_t> candidates;
+    for (std::uint32_t b = 0; b < options.bands; ++b) {
+        auto first = bucketKeys.begin() + b * indexedCount;
+        auto last = first + indexedCount;
+        auto bucket = std::equal_range(first, last, MinHashSketch::bandKey(signature.data(), b, options.rows));
+        candidates.insert(candidates.end(), bucketRecipes.begin() + (bucket.first - bucketKeys.begin()),
+                          bucketRecipes.begin() + (bucket.second - bucketKeys.begin()));
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (std::uint32_t candidate : candidates) {
+        if (std::binary_search(exclude.begin(), exclude.end(), candidate)) {
+            continue;
+        }
+        // Exact similarity against the query set, by merging the two sorted lists.
+        const IngredientId* it = sets.data() + setOffsets[candidate];
+        const IngredientId* end = sets.data() + setOffsets[candidate + 1];
+        std::size_t total = ingredients.size() + static_cast<std::size_t>(end - it);
+        std::size_t shared = 0;
+        for (std::size_t q = 0; q < ingredients.size() && it != end;) {
+            if (ingredients[q] < *it) {
+                ++q;
+            } else if (*it < ingredients[q]) {
+                ++it;
+            } else {
+                ++shared;
+                ++q;
+                ++it;
+            }
+        }
+        if (shared > 0) {
+            found.push_back(Similar{ candidate, static_cast<float>(shared) / static_cast<float>(total - shared) });
+        }
+    }
+
+    auto better = [](const Similar& a, const Similar& b) {
+        return a.similarity != b.similarity ? a.similarity > b.similarity : a.recipeId < b.recipeId;
+    };
+    std::size_t keep = std::min(limit, found.size());
+    std::partial_sort(found.begin(), found.begin() + keep, found.end(), better);
+    found.resize(keep);
+    return found;
+}
+
+std::vector<RecipeSimilarityIndex::Similar> RecipeSimilarityIndex::similarTo(std::size_t recipeId, std::size_t limit) const {
+    return similarToAny({ recipeId }, limit);
+}
+
+std::vector<RecipeSimilarityIndex::Similar> RecipeSimilarityIndex::similarToAny(const std::vector<std::size_t>& recipeIds, std::size_t limit) const {
+    std::vector<std::size_t> exclude(recipeIds);
+    std::sort(exclude.begin(), exclude.end());
+    exclude.erase(std::unique(exclude.begin(), exclude.end()), exclude.end());
+
+    // A recipe in the overall top `limit` is also in the top `limit` for the recipe it is
+    // closest to, so merging the per-recipe lists loses nothing.
+    std::vector<Similar> merged;
+    for (std::size_t recipeId : exclude) {
+        if (recipeId >= catalog->size()) {
+            continue;
+        }
+        std::vector<IngredientId> ingredients(sets.begin() + setOffsets[recipeId], sets.begin() + setOffsets[recipeId + 1]);
+        std::vector<Similar> found = query(ingredients, exclude, limit);
+        merged.insert(merged.end(), found.begin(), found.end());
+    }
+    std::sort(merged.begin(), merged.end(), [](const Similar& a, const Similar& b) {
+        return a.recipeId != b.recipeId ? a.recipeId < b.recipeId : a.similarity > b.similarity;
+    });
+    merged.erase(std::unique(merged.begin(), merged.end(), [](const Similar& a, const Similar& b) { return a.recipeId == b.recipeId; }),
+                 merged.end());
+    std::sort(merged.begin(), merged.end(), [](const Similar& a, const Similar& b) {
+        return a.similarity != b.similarity ? a.similarity > b.similarity : a.recipeId < b.recipeId;
+    });
+    if (merged.size() > limit) {
+        merged.resize(limit);
+    }
+    return merged;
+}
+
+std::vector<RecipeSimilarityIndex::Similar> RecipeSimilarityIndex::similarToIngredients(std::vector<IngredientId> ingredients, std::size_t limit) const {
+    std::sort(ingredients.begin(), ingredients.end());
+    ingredients.erase(std::unique(ingredients.begin(), ingredients.end()), ingredients.end());
+    while (!ingredients.empty() && ingredients.back() == RecipeCatalog::kNoIngredient) {
+        ingredients.pop_back();   // names the catalog does not know
+    }
+    return query(ingredients, {}, limit);
+}
@@ -0,0 +1,67 @@
+#ifndef RECIPESIMILARITY_H
+#define RECIPESIMILARITY_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "MinHashSketch.h"
+#include "RecipeCatalog.h"
+
+struct SimilarityOptions {
+    std::uint32_t bands = 24;
+    std::uint32_t rows = 2;
+    unsigned threadCount = 0;   // for building; 0 = one per core
+};
+
+// Finds recipes with similar main ingredients, by Jaccard similarity of the ingredient sets
+// (shared ingredients / ingredients in either), without comparing against every recipe.
+//
+// Each recipe gets a MinHash signature of bands * rows entries when the index is built, and
+// recipes that agree on all `rows` entries of some band are likely to be similar. A query
+// looks up the recipes that share a band with it (locality-sensitive hashing) and ranks
+// only those by their exact similarity. More bands or fewer rows find more of the similar recipes at the cost of
+// more candidates: a pair with similarity s becomes a candidate with probability
+// 1 - (1 - s^rows)^bands, about 0.9 at s = 0.3 for the defaults.
+class RecipeSimilarityIndex {
+public:
+    struct Similar {
+        std::size_t recipeId;
+        float similarity;
+    };
+
+private:
+    std::shared_ptr<const RecipeCatalog> catalog;
+    SimilarityOptions options;
+    MinHashSketch sketch;
+    // Each recipe's distinct ingredient ids, ascending, stored as offsets into one array.
+    std::vector<std::uint32_t> setOffsets;
+    std::vector<IngredientId> sets;
+    // Per band, (bucket key, recipe id) sorted by key; band b occupies [b * n, (b + 1) * n)
+    // of both arrays, n being the number of recipes with at least one ingredient.
+    std::vector<std::uint64_t> bucketKeys;
+    std::vector<std::uint32_t> bucketRecipes;
+    std::size_t indexedCount = 0;
+
+    void signatureOf(const IngredientId* first, const IngredientId* last, std::uint32_t* signature) const;
+    std::vector<Similar> query(const std::vector<IngredientId>& ingredients, const std::vector<std::size_t>& exclude, std::size_t limit) const;
+
+public:
+    explicit RecipeSimilarityIndex(std::shared_ptr<const RecipeCatalog> catalog, const SimilarityOptions& options = SimilarityOptions());
+
+    // The catalog the recipe ids refer to.
+    const RecipeCatalog& getCatalog() const;
+
+    // Recipes most similar to the given one (not including it), best first; ties go to the
+    // lower id. Recipes sharing no ingredient are never returned.
+    std::vector<Similar> similarTo(std::size_t recipeId, std::size_t limit = 5) const;
+    // Recipes most similar to any of the given ones, by their best similarity to one of
+    // them, not including the given recipes. For "more like what I cooked recently".
+    std::vector<Similar> similarToAny(const std::vector<std::size_t>& recipeIds, std::size_t limit = 5) const;
+    // Recipes whose ingredients are most similar to the given catalog ingredient ids.
+    std::vector<Similar> similarToIngredients(std::vector<IngredientId> ingredients, std::size_t limit = 5) const;
+
+    // Exact similarity of two recipes' ingredient sets.
+    float jaccard(std::size_t a, std::size_t b) const;
+};
+
+#endif
@@ -0,0 +1,152 @@
+#include "ShoppingList.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+// Candidates handed to a worker at a time when scoring; small enough to balance, big enough
+// to amortize the shared counter.
+static const std::size_t kCandidateChunk = 256;
+
+ShoppingListPlanner::ShoppingListPlanner(const RecipeCatalog& recipeCatalog, const std::vector<Ingredient>& inventory)
+    : catalog(recipeCatalog), inStock(recipeCatalog.ingredientCount(), 0) {
+    for (const auto& ingredient : inventory) {
+        IngredientId id = catalog.findIngredient(ingredient.getName());
+        if (id != RecipeCatalog::kNoIngredient) {
+            inStock[id] = 1;
+        }
+    }
+}
+
+void ShoppingListPlanner::setCost(const std::string& ingredient, double cost) {
+    IngredientId id = catalog.findIngredient(ingredient);
+    if (id != RecipeCatalog::kNoIngredient) {
+        costs[id] = std::max(cost, 1e-9);   // free items would make every ratio infinite
+    }
+}
+
+double ShoppingListPlanner::costOf(IngredientId id) const {
+    auto found = costs.find(id);
+    return found == costs.end() ? 1.0 : found->second;
+}
+
+// Distinct ingredients of the recipe that are not in stock.
+std::uint32_t ShoppingListPlanner::missingCount(std::size_t recipeId) const {
+    IdRange ingredients = catalog.getRecipeIngredients(recipeId);
+    std::uint32_t missing = 0;
+    for (const std::uint32_t* it = ingredients.begin(); it != ingredients.end(); ++it) {
+        if (!inStock[*it] && std::find(ingredients.begin(), it, *it) == it) {
+            ++missing;
+        }
+    }
+    return missing;
+}
+
+ShoppingList ShoppingListPlanner::forRecipes(const std::vector<std::string>& recipeNames) const {
+    ShoppingList list;
+    std::vector<char> listed(inStock.size(), 0);
+    for (const auto& name : recipeNames) {
+        std::size_t recipeId = catalog.idOf(name);
+        if (recipeId == RecipeCatalog::npos) {
+            continue;
+        }
+        for (IngredientId id : catalog.getRecipeIngredients(recipeId)) {
+            if (!inStock[id] && !listed[id]) {
+                listed[id] = 1;
+                list.items.push_back(catalog.getIngredientName(id));
+                list.cost += costOf(id);
+            }
+        }
+        list.enabledRecipes.push_back(recipeId);
+    }
+    std::sort(list.enabledRecipes.begin(), list.enabledRecipes.end());
+    list.enabledRecipes.erase(std::unique(list.enabledRecipes.begin(), list.enabledRecipes.end()), list.enabledRecipes.end());
+    return list;
+}
+
+ShoppingList ShoppingListPlanner::enableMost(std::size_t maxItems, unsigned threadCount) const {
+    ShoppingList list;
+    std::vector<std::uint32_t> remaining(catalog.size());
+    for (std::size_t recipeId = 0; recipeId < catalog.size(); ++recipeId) {
+        remaining[recipeId] = missingCount(recipeId);
+    }
+
+    std::vector<IngredientId> candidates;
+    for (IngredientId id = 0; id < inStock.size(); ++id) {
+        if (!inStock[id]) {
+            candidates.push_back(id);
+        }
+    }
+    std::vector<char> bought(inStock.size(), 0);
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t workerCount = std::min<std::size_t>(threadCount, (candidates.size() + kCandidateChunk - 1) / kCandidateChunk);
+    workerCount = std::max<std::size_t>(workerCount, 1);
+
+    // How much buying each ingredient would move the recipes that need it. Scored once
+    // here in parallel; afterwards each purchase only changes the ingredients that share
+    // a recipe with it, and those are updated in place.
+    std::vector<double> progress(inStock.size(), 0.0);
+    std::atomic<std::size_t> next(0);
+    auto work = [&]() {
+        for (std::size_t begin = next.fetch_add(kCandidateChunk); begin < candidates.size(); begin = next.fetch_add(kCandidateChunk)) {
+            std::size_t end = std::min(begin + kCandidateChunk, candidates.size());
+            for (std::size_t c = begin; c < end; ++c) {
+                double sum = 0.0;
+                for (std::uint32_t recipeId : catalog.getRecipesUsing(candidates[c])) {
+                    if (remaining[recipeId] > 0) {
+                        sum += 1.0 / remaining[recipeId];
+                    }
+                }
+                progress[candidates[c]] = sum;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 1; worker < workerCount; ++worker) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    while (list.items.size() < maxItems) {
+        IngredientId best = RecipeCatalog::kNoIngredient;
+        double bestRatio = 0.0;
+        for (IngredientId id : candidates) {
+            double ratio = progress[id] / costOf(id);
+            if (!bought[id] && ratio > bestRatio + 1e-12) {
+                best = id;
+                bestRatio = ratio;
+            }
+        }
+        if (best == RecipeCatalog::kNoIngredient) {
+            break;   // no purchase brings any recipe closer
+        }
+
+        bought[best] = 1;
+        list.items.push_back(catalog.getIngredientName(best));
+        list.cost += costOf(best);
+        for (std::uint32_t recipeId : catalog.getRecipesUsing(best)) {
+            if (remaining[recipeId] == 0) {
+                continue;
+            }
+            double before = 1.0 / remaining[recipeId];
+            double after = --remaining[recipeId] == 0 ? 0.0 : 1.0 / remaining[recipeId];
+            if (remaining[recipeId] == 0) {
+                list.enabledRecipes.push_back(recipeId);
+            }
+            IdRange ingredients = catalog.getRecipeIngredients(recipeId);
+            for (const std::uint32_t* it = ingredients.begin(); it != ingredients.end(); ++it) {
+                if (!inStock[*it] && !bought[*it] && std::find(ingredients.begin(), it, *it) == it) {
+                    progress[*it] += after - before;
+                }
+            }
+        }
+    }
+
+    std::sort(list.enabledRecipes.begin(), list.enabledRecipes.end());
+    return list;
+}
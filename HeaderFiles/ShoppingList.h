@@ -0,0 +1,44 @@
+#ifndef SHOPPINGLIST_H
+#define SHOPPINGLIST_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Ingredient.h"
+#include "RecipeCatalog.h"
+
+struct ShoppingList {
+    std::vector<std::string> items;            // ingredients to buy, in the order chosen
+    std::vector<std::size_t> enabledRecipes;   // recipes that become makeable, ascending by id
+    double cost = 0.0;
+};
+
+// Works out what to buy, from the catalog's ingredient -> recipe posting lists.
+class ShoppingListPlanner {
+private:
+    const RecipeCatalog& catalog;
+    std::vector<char> inStock;                        // indexed by IngredientId
+    std::unordered_map<IngredientId, double> costs;   // anything not listed costs 1
+
+    double costOf(IngredientId id) const;
+    std::uint32_t missingCount(std::size_t recipeId) const;
+
+public:
+    ShoppingListPlanner(const RecipeCatalog& catalog, const std::vector<Ingredient>& inventory);
+
+    // Ingredients with a price other than 1, e.g. to steer the list away from expensive items.
+    void setCost(const std::string& ingredient, double cost);
+
+    // Everything missing for the given recipes. Unknown names are ignored.
+    ShoppingList forRecipes(const std::vector<std::string>& recipeNames) const;
+
+    // Greedy weighted set cover: repeatedly buys the ingredient with the best ratio of
+    // progress to cost, where buying an ingredient moves each recipe that still needs it
+    // by 1 / (ingredients that recipe still needs). Stops after maxItems purchases or when
+    // no purchase helps any recipe. Ties go to the lower ingredient id. Candidate
+    // ingredients are first scored on threadCount threads (0 = one per core); after that
+    // each purchase only rescores the ingredients that share a recipe with it.
+    ShoppingList enableMost(std::size_t maxItems, unsigned threadCount = 0) const;
+};
+
+#endif
@@ -1,16 +1,101 @@
 #include "Storage.h"
+#include <unordered_map>
+#include <utility>
+
+Storage::Storage(IngredientLocation where) : location(where) {}
+
+// Adds `from` to an item with the same stock key, taking its expiration date if it has one.
+static void mergeFrom(Ingredient& into, const Ingredient& from) {
+    into.setAmount(into.getAmount() + from.getAmount());
+    if (from.getExpiryDay() != kNoDate) {
+        into.setExpiryDay(from.getExpiryDay());
+    }
+}
+
+static bool mergeInto(std::vector<Ingredient>& ingredients, const Ingredient& ingredient) {
+    std::uint32_t key = ingredient.getStockKey();
+    for (auto& ing : ingredients) {
+        if (ing.getStockKey() == key) {
+            mergeFrom(ing, ingredient);
+            return true;
+        }
+    }
+    return false;
+}
 
 void Storage::addIngredient(const Ingredient& ingredient) {
+    if (!mergeInto(ingredients, ingredient)) {
+        ingredients.push_back(ingredient);
+        ingredients.back().setLocation(location);
+    }
+}
+
+void Storage::addIngredient(Ingredient&& ingredient) {
+    if (!mergeInto(ingredients, ingredient)) {
+        ingredients.push_back(std::move(ingredient));
+        ingredients.back().setLocation(location);
+    }
+}
+
+void Storage::addIngredients(const Ingredient* items, std::size_t count) {
+    // Where each name already is, so every item is merged or appended without a scan.
+    std::unordered_map<std::uint32_t, std::size_t> position;
+    position.reserve(ingredients.size() + count);
+    for (std::size_t i = 0; i < ingredients.size(); ++i) {
+        position.emplace(ingredients[i].getStockKey(), i);
+    }
+    ingredients.reserve(ingredients.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto inserted = position.emplace(items[i].getStockKey(), ingredients.size());
+        if (inserted.second) {
+            ingredients.push_back(items[i]);
+            ingredients.back().setLocation(location);
+        } else {
+            mergeFrom(ingredients[inserted.first->second], items[i]);
+        }
+    }
+}
+
+void Storage::addIngredients(const std::vector<Ingredient>& items) {
+    addIngredients(items.data(), items.size());
+}
+
+// Items are found under the same key addIngredient merges them by.
+static std::uint32_t stockKeyFor(const std::string& name) {
+    return Ingredient::stockKeyOf(Ingredient::internName(name));
+}
+
+bool Storage::setQuantity(const std::string& name, int quantity) {
+    std::uint32_t key = stockKeyFor(name);
+    for (auto& ing : ingredients) {
+        if (ing.getStockKey() == key) {
+            ing.setQuantity(quantity);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Storage::setAmount(const std::string& name, double amount) {
+    std::uint32_t key = stockKeyFor(name);
     for (auto& ing : ingredients) {
-        if (ing.getName() == ingredient.getName()) {
-            ing.setQuantity(ing.getQuantity() + ingredient.getQuantity());
-            if (!ingredient.getExpirationDate().empty()) {
-                ing.setExpirationDate(ingredient.getExpirationDate());
-            }
-            return;
+        if (ing.getStockKey() == key) {
+            ing.setAmount(amount);
+            return true;
         }
     }
-    ingredients.push_back(ingredient);
+    return false;
+}
+
+bool Storage::removeIngredient(const std::string& name) {
+    std::uint32_t key = stockKeyFor(name);
+    for (auto it = ingredients.begin(); it != ingredients.end(); ++it) {
+        if (it->getStockKey() == key) {
+            ingredients.erase(it);
+            return true;
+        }
+    }
+    return false;
 }
 
 const std::vector<Ingredient>& Storage::getIngredients() const {
@@ -26,7 +111,17 @@ json Storage::toJSON() const {
 }
 
 void Storage::fromJSON(const json& j) {
+    ingredients.reserve(ingredients.size() + j.size());
     for (const auto& item : j) {
         ingredients.push_back(Ingredient::fromJSON(item));
+        ingredients.back().setLocation(location);
+    }
+}
+
+void Storage::fromJSON(json&& j) {
+    ingredients.reserve(ingredients.size() + j.size());
+    for (auto& item : j) {
+        ingredients.push_back(Ingredient::fromJSON(std::move(item)));
+        ingredients.back().setLocation(location);
     }
 }
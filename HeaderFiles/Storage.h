@@ -10,15 +10,32 @@ using json = nlohmann::json;
 class Storage {
 protected:
     std::vector<Ingredient> ingredients;
+    IngredientLocation location;   // stamped on everything added
 
 public:
+    explicit Storage(IngredientLocation location = IngredientLocation::None);
+
+    // An item whose name differs from a stored one only in case, spacing or plurals is added
+    // to it (see Ingredient::stockKeyOf), and the stored spelling stays.
     virtual void addIngredient(const Ingredient& ingredient);
+    virtual void addIngredient(Ingredient&& ingredient);
+    // Adds a batch in one pass, merging duplicates the same way addIngredient does.
+    // Subclasses announce a batch once rather than once per item.
+    virtual void addIngredients(const Ingredient* items, std::size_t count);
+    void addIngredients(const std::vector<Ingredient>& items);
+
+    // Names are matched the way addIngredient merges them ("Eggs" finds "egg"). Each
+    // returns false if no ingredient matches.
+    bool setQuantity(const std::string& name, int quantity);
+    bool setAmount(const std::string& name, double amount);
+    bool removeIngredient(const std::string& name);
 
     const std::vector<Ingredient>& getIngredients() const;
 
     json toJSON() const;
 
     void fromJSON(const json& j);
+    void fromJSON(json&& j);
 };
 
 #endif
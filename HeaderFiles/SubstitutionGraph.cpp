@@ -0,0 +1,191 @@
+#include "SubstitutionGraph.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <utility>
+
+SubstitutionGraph::SubstitutionGraph() : aliases(IngredientAliases::current()), substituteOffsets(1, 0), replaceableOffsets(1, 0) {}
+
+SubstitutionGraph::SubstitutionGraph(const json& graph, std::shared_ptr<const IngredientAliases> aliasTable)
+    : aliases(std::move(aliasTable)) {
+    struct Link {
+        std::uint32_t from;   // the ingredient a recipe asks for
+        std::uint32_t to;     // what can be used instead
+        float cost;
+    };
+    std::vector<Link> links;
+    if (graph.is_object()) {
+        for (auto entry = graph.begin(); entry != graph.end(); ++entry) {
+            std::uint32_t from = intern(entry.key());
+            const json& options = entry.value();
+            if (options.is_object()) {
+                for (auto option = options.begin(); option != options.end(); ++option) {
+                    float cost = option.value().is_number() ? option.value().get<float>() : 1.0f;
+                    links.push_back(Link{ from, intern(option.key()), std::max(cost, 0.0f) });
+                }
+            } else if (options.is_array()) {
+                for (const auto& option : options) {
+                    if (option.is_string()) {
+                        links.push_back(Link{ from, intern(option.get<std::string>()), 1.0f });
+                    }
+                }
+            }
+        }
+    }
+    // Names that are aliases of each other do not substitute for themselves.
+    links.erase(std::remove_if(links.begin(), links.end(), [](const Link& link) { return link.from == link.to || link.from == kNoNode || link.to == kNoNode; }),
+                links.end());
+
+    // Counting sort of the links into both directions.
+    auto build = [&](std::vector<std::uint32_t>& offsets, std::vector<Edge>& edges, bool forward) {
+        offsets.assign(nodeNames.size() + 1, 0);
+        for (const auto& link : links) {
+            ++offsets[(forward ? link.from : link.to) + 1];
+        }
+        for (std::size_t i = 1; i < offsets.size(); ++i) {
+            offsets[i] += offsets[i - 1];
+        }
+        edges.resize(links.size());
+        std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& link : links) {
+            std::uint32_t node = forward ? link.from : link.to;
+            edges[fill[node]++] = Edge{ forward ? link.to : link.from, link.cost };
+        }
+        for (std::size_t node = 0; node < nodeNames.size(); ++node) {
+            std::sort(edges.begin() + offsets[node], edges.begin() + offsets[node + 1],
+                      [](const Edge& a, const Edge& b) { return a.cost < b.cost || (a.cost == b.cost && a.node < b.node); });
+        }
+    };
+    build(substituteOffsets, substitutes, true);
+    build(replaceableOffsets, replaceable, false);
+}
+
+SubstitutionGraph SubstitutionGraph::fromFile(const std::string& path, std::shared_ptr<const IngredientAliases> aliases) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return SubstitutionGraph(json::object(), std::move(aliases));
+    }
+    json graph = json::parse(file, nullptr, false);
+    if (graph.is_discarded() || !graph.is_object()) {
+        std::cerr << "Unable to read ingredient substitutes from " << path << "\n";
+        return SubstitutionGraph(json::object(), std::move(aliases));
+    }
+    return SubstitutionGraph(graph, std::move(aliases));
+}
+
+std::uint32_t SubstitutionGraph::intern(const std::string& name) {
+    std::string key = aliases->canonical(name);
+    if (key.empty()) {
+        return kNoNode;
+    }
+    auto inserted = nodeIds.emplace(std::move(key), static_cast<std::uint32_t>(nodeNames.size()));
+    if (inserted.second) {
+        std::string display = name;
+        std::transform(display.begin(), display.end(), display.begin(), ::tolower);
+        nodeNames.push_back(std::move(display));
+    }
+    return inserted.first->second;
+}
+
+std::uint32_t SubstitutionGraph::findNode(const std::string& name) const {
+    if (nodeIds.empty()) {
+        return kNoNode;
+    }
+    thread_local std::string key;
+    aliases->canonical(name.data(), name.size(), key);
+    auto it = nodeIds.find(key);
+    return it == nodeIds.end() ? kNoNode : it->second;
+}
+
+const std::string& SubstitutionGraph::getNodeName(std::uint32_t node) const {
+    return nodeNames.at(node);
+}
+
+std::size_t SubstitutionGraph::nodeCount() const {
+    return nodeNames.size();
+}
+
+std::size_t SubstitutionGraph::edgeCount() const {
+    return substitutes.size();
+}
+
+std::vector<SubstitutionGraph::Edge> SubstitutionGraph::getSubstitutes(std::uint32_t node) const {
+    if (node >= nodeNames.size()) {
+        return {};
+    }
+    return std::vector<Edge>(substitutes.begin() + substituteOffsets[node], substitutes.begin() + substituteOffsets[node + 1]);
+}
+
+std::vector<SubstitutionGraph::Edge> SubstitutionGraph::getReplaceable(std::uint32_t node) const {
+    if (node >= nodeNames.size()) {
+        return {};
+    }
+    return std::vector<Edge>(replaceable.begin() + replaceableOffsets[node], replaceable.begin() + replaceableOffsets[node + 1]);
+}
+
+SubstitutionClosure::SubstitutionClosure(const RecipeCatalog& catalog, const SubstitutionGraph& graph,
+                                         const std::vector<Ingredient>& inventory, float maxCost)
+    : available(catalog.ingredientCount(), 0) {
+    const float kUnreached = 1e38f;
+    std::vector<float> distance(graph.nodeCount(), kUnreached);
+    std::vector<std::uint32_t> source(graph.nodeCount(), SubstitutionGraph::kNoNode);   // the stocked node reached from
+
+    using Entry = std::pair<float, std::uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+    for (const auto& ingredient : inventory) {
+        IngredientId id = catalog.findIngredient(ingredient.getName());
+        if (id != RecipeCatalog::kNoIngredient) {
+            available[id] = 1;
+        }
+        std::uint32_t node = graph.findNode(ingredient.getName());
+        if (node != SubstitutionGraph::kNoNode && distance[node] > 0.0f) {
+            distance[node] = 0.0f;
+            source[node] = node;
+            frontier.push(Entry{ 0.0f, node });
+        }
+    }
+
+    // Dijkstra from every stocked item at once, along "can be used instead of" edges.
+    while (!frontier.empty()) {
+        Entry top = frontier.top();
+        frontier.pop();
+        if (top.first > distance[top.second]) {
+            continue;   // a cheaper route was found after this one was queued
+        }
+        for (const auto& edge : graph.getReplaceable(top.second)) {
+            float cost = top.first + edge.cost;
+            if (cost <= maxCost && cost < distance[edge.node]) {
+                distance[edge.node] = cost;
+                source[edge.node] = source[top.second];
+                frontier.push(Entry{ cost, edge.node });
+            }
+        }
+    }
+
+    // Only nodes that are catalog ingredients matter to recipes.
+    for (std::uint32_t node = 0; node < graph.nodeCount(); ++node) {
+        if (distance[node] <= 0.0f || distance[node] == kUnreached) {
+            continue;
+        }
+        IngredientId id = catalog.findIngredient(graph.getNodeName(node));
+        if (id != RecipeCatalog::kNoIngredient && !available[id]) {
+            available[id] = 1;
+            substitutes.emplace(id, Substitute{ graph.getNodeName(source[node]), distance[node] });
+        }
+    }
+}
+
+bool SubstitutionClosure::isAvailable(IngredientId id) const {
+    return id < available.size() && available[id] != 0;
+}
+
+const SubstitutionClosure::Substitute* SubstitutionClosure::substituteFor(IngredientId id) const {
+    auto found = substitutes.find(id);
+    return found == substitutes.end() ? nullptr : &found->second;
+}
+
+const std::vector<char>& SubstitutionClosure::getAvailable() const {
+    return available;
+}
@@ -0,0 +1,94 @@
+#ifndef SUBSTITUTIONGRAPH_H
+#define SUBSTITUTIONGRAPH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Ingredient.h"
+#include "IngredientAliases.h"
+#include "RecipeCatalog.h"
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+// Which ingredients can stand in for which, and at what cost: margarine for butter at 1,
+// olive oil for butter at 2. Read from ingredient_substitutes.json next to recipes.json:
+//
+//     {"butter": {"margarine": 1, "olive oil": 2}, "buttermilk": ["milk"]}
+//
+// A list instead of an object gives every substitute a cost of 1. Names are compared by
+// their canonical form, and substitutes of substitutes count, with the costs added up.
+class SubstitutionGraph {
+public:
+    static constexpr std::uint32_t kNoNode = 0xffffffff;
+
+    struct Edge {
+        std::uint32_t node;
+        float cost;
+    };
+
+private:
+    std::shared_ptr<const IngredientAliases> aliases;
+    std::vector<std::string> nodeNames;                     // first spelling seen, lowercased
+    std::unordered_map<std::string, std::uint32_t> nodeIds;   // canonical name -> node
+    // Edges both ways, each stored as offsets into one flat array: what can replace a node,
+    // and what a node can replace. The closure walks the second direction.
+    std::vector<std::uint32_t> substituteOffsets;
+    std::vector<Edge> substitutes;
+    std::vector<std::uint32_t> replaceableOffsets;
+    std::vector<Edge> replaceable;
+
+    std::uint32_t intern(const std::string& name);
+
+public:
+    // No substitutions.
+    SubstitutionGraph();
+    // Names are compared under `aliases`.
+    explicit SubstitutionGraph(const json& graph, std::shared_ptr<const IngredientAliases> aliases = IngredientAliases::current());
+    // A missing file gives an empty graph; an unreadable one is reported and also empty.
+    static SubstitutionGraph fromFile(const std::string& path,
+                                      std::shared_ptr<const IngredientAliases> aliases = IngredientAliases::current());
+
+    std::uint32_t findNode(const std::string& name) const;
+    const std::string& getNodeName(std::uint32_t node) const;
+    std::size_t nodeCount() const;
+    std::size_t edgeCount() const;
+    // What can be used instead of node, cheapest first.
+    std::vector<Edge> getSubstitutes(std::uint32_t node) const;
+    // What node can be used instead of.
+    std::vector<Edge> getReplaceable(std::uint32_t node) const;
+};
+
+// Which of a catalog's ingredients an inventory covers, either directly or through a
+// substitute, worked out once per inventory snapshot. Building it runs one multi-source
+// shortest-path search over the substitution graph from everything in stock, so its cost
+// depends on the inventory and the graph, not on the number of recipes; matching a recipe
+// afterwards is a lookup per ingredient.
+class SubstitutionClosure {
+public:
+    struct Substitute {
+        std::string name;   // the stocked item to use instead
+        float cost;         // summed along the chain of substitutions
+    };
+
+private:
+    std::vector<char> available;   // indexed by IngredientId
+    std::unordered_map<IngredientId, Substitute> substitutes;
+
+public:
+    // Substitutions costing more than maxCost in total are not used.
+    SubstitutionClosure(const RecipeCatalog& catalog, const SubstitutionGraph& graph,
+                        const std::vector<Ingredient>& inventory, float maxCost = 1e30f);
+
+    // In stock, or replaceable by something that is.
+    bool isAvailable(IngredientId id) const;
+    // What to use instead of an ingredient that is not in stock; nullptr if the ingredient
+    // is in stock itself or nothing in stock can replace it.
+    const Substitute* substituteFor(IngredientId id) const;
+    // Indexed by IngredientId, for RecipeCatalog::findMakeable.
+    const std::vector<char>& getAvailable() const;
+};
+
+#endif
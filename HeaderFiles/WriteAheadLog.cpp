@@ -0,0 +1,211 @@
+#include "WriteAheadLog.h"
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// Reads the complete, parseable lines at the start of a log and how many bytes they span.
+static std::vector<json> scanLog(const std::string& path, std::uintmax_t& validBytes) {
+    std::vector<json> entries;
+    validBytes = 0;
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (in.eof()) {
+            break;   // no newline: the write of this line never finished
+        }
+        json entry = json::parse(line, nullptr, false);
+        if (entry.is_discarded() || !entry.is_object()) {
+            break;
+        }
+        entries.push_back(std::move(entry));
+        validBytes += line.size() + 1;
+    }
+    return entries;
+}
+
+WriteAheadLog::WriteAheadLog(std::string logPath, std::uint64_t startAfter)
+    : path(std::move(logPath)), sequence(startAfter), durableSequence(startAfter) {
+    std::uintmax_t validBytes = 0;
+    std::vector<json> existing = scanLog(path, validBytes);
+    for (const auto& entry : existing) {
+        sequence = std::max<std::uint64_t>(sequence, entry.value("seq", std::uint64_t(0)));
+    }
+    durableSequence = sequence;
+    durableBytes = validBytes;
+
+    std::error_code ec;
+    if (fs::exists(path, ec) && fs::file_size(path, ec) != validBytes) {
+        fs::resize_file(path, validBytes, ec);
+    }
+
+#ifdef __unix__
+    fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+#else
+    file.open(path, std::ios::binary | std::ios::app);
+#endif
+    if (!isOpen()) {
+        std::cerr << "Unable to open log " << path << "\n";
+    }
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    commit();
+#ifdef __unix__
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+}
+
+bool WriteAheadLog::isOpen() const {
+#ifdef __unix__
+    return fd >= 0;
+#else
+    return file.is_open();
+#endif
+}
+
+bool WriteAheadLog::writeAndSync(const std::string& data) {
+#ifdef __unix__
+    std::size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            return false;
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    return ::fsync(fd) == 0;
+#else
+    // Without POSIX, flushing to the OS is the strongest guarantee available.
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.flush();
+    return static_cast<bool>(file);
+#endif
+}
+
+// Cuts the file back to size; with O_APPEND the next write then continues from there.
+bool WriteAheadLog::truncateTo(std::uintmax_t size) {
+#ifdef __unix__
+    return fd >= 0 && ::ftruncate(fd, static_cast<off_t>(size)) == 0 && ::fsync(fd) == 0;
+#else
+    file.close();
+    std::error_code ec;
+    fs::resize_file(path, size, ec);
+    file.open(path, std::ios::binary | std::ios::app);
+    return !ec && file.is_open();
+#endif
+}
+
+std::uint64_t WriteAheadLog::add(json entry) {
+    std::lock_guard<std::mutex> guard(lock);
+    entry["seq"] = ++sequence;
+    queued += entry.dump();
+    queued += '\n';
+    return sequence;
+}
+
+std::uint64_t WriteAheadLog::addAll(std::vector<json>& entries) {
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto& entry : entries) {
+        entry["seq"] = ++sequence;
+        queued += entry.dump();
+        queued += '\n';
+    }
+    return sequence;
+}
+
+bool WriteAheadLog::commit() {
+    std::uint64_t target = lastSequence();
+    return commit(target, target);
+}
+
+bool WriteAheadLog::commit(std::uint64_t first, std::uint64_t last) {
+    std::unique_lock<std::mutex> guard(lock);
+    while (durableSequence < last && !failed) {
+        if (writing) {
+            // Someone else is syncing; our entries go out with the next write.
+            synced.wait(guard);
+            continue;
+        }
+        writing = true;
+        std::string data;
+        data.swap(queued);
+        std::uint64_t from = durableSequence + 1;
+        std::uint64_t upTo = sequence;
+        std::uintmax_t before = durableBytes;
+        guard.unlock();
+        bool ok = isOpen() && writeAndSync(data);
+        // Part or all of the batch may have reached the file even though the call failed;
+        // the caller rolls back its changes, so the entries must not be replayed later.
+        bool cutOff = ok || truncateTo(before);
+        guard.lock();
+        writing = false;
+        ++syncs;
+        durableSequence = upTo;
+        if (ok) {
+            durableBytes = before + data.size();
+        } else {
+            lostBatches.emplace_back(from, upTo);
+            failed = !cutOff;
+            std::cerr << "Unable to write log " << path << (cutOff ? "\n" : "; it needs a checkpoint before further use\n");
+        }
+        synced.notify_all();
+    }
+    if (durableSequence < last) {
+        // Stopped by a batch that could not be cut off; nothing after it is written.
+        return false;
+    }
+    // The entries may have gone out in other threads' batches; only those batches count,
+    // not ones written before or after them.
+    for (auto batch = lostBatches.rbegin(); batch != lostBatches.rend() && batch->second >= first; ++batch) {
+        if (batch->first <= last) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WriteAheadLog::reset() {
+    commit();
+    std::unique_lock<std::mutex> guard(lock);
+    while (writing) {
+        synced.wait(guard);
+    }
+    if (failed) {
+        // Nothing was written since the failure, and every commit since has reported it.
+        queued.clear();
+        if (durableSequence < sequence) {
+            lostBatches.emplace_back(durableSequence + 1, sequence);
+        }
+        durableSequence = sequence;
+    }
+    if (!truncateTo(0)) {
+        return false;
+    }
+    durableBytes = 0;
+    failed = false;
+    return true;
+}
+
+std::uint64_t WriteAheadLog::lastSequence() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return sequence;
+}
+
+std::size_t WriteAheadLog::syncCount() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return syncs;
+}
+
+std::vector<json> WriteAheadLog::readEntries(const std::string& logPath) {
+    std::uintmax_t validBytes;
+    return scanLog(logPath, validBytes);
+}
@@ -0,0 +1,82 @@
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+// An append-only log of JSON entries, one per line, each stamped with a "seq" number.
+//
+// add() only queues an entry; commit() returns once everything queued so far is on disk.
+// Commits use group commit: while one caller is writing and syncing, callers arriving
+// meanwhile wait and go out together in the next write, so a burst of entries costs one
+// fsync rather than one each.
+//
+// A batch that fails to write or sync is cut off the end of the file again, so its entries
+// are never replayed, and the log carries on with the next batch.
+class WriteAheadLog {
+private:
+    std::string path;
+    mutable std::mutex lock;
+    std::condition_variable synced;
+    std::string queued;                 // serialized entries not yet written
+    std::uint64_t sequence;             // last number handed out
+    std::uint64_t durableSequence;      // last number on disk or cut off after a failed write
+    // First and last numbers of each batch cut off after a failed write, oldest first.
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> lostBatches;
+    std::uintmax_t durableBytes = 0;    // length of the file up to durableSequence
+    bool writing = false;
+    bool failed = false;                // a failed batch could not be cut off; see reset()
+    std::size_t syncs = 0;
+#ifdef __unix__
+    int fd = -1;
+#else
+    std::ofstream file;
+#endif
+
+    bool writeAndSync(const std::string& data);
+    bool truncateTo(std::uintmax_t size);
+
+public:
+    // Opens (or creates) the log at path. Numbering continues after the larger of
+    // startAfter and the last entry already in the file. A half-written last line, left
+    // by a crash in the middle of a write, is cut off.
+    explicit WriteAheadLog(std::string path, std::uint64_t startAfter = 0);
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    bool isOpen() const;
+    // Sets the entry's "seq" and queues it; returns the sequence number.
+    std::uint64_t add(json entry);
+    // Sets each entry's "seq" and queues them together, so they go out in one batch and
+    // are written or lost as a whole; returns the last sequence number.
+    std::uint64_t addAll(std::vector<json>& entries);
+    // Returns once every entry queued before the call is on disk; false if the batch holding
+    // the last of them failed and was dropped. A commit with nothing queued asks about the
+    // last entry queued before it.
+    bool commit();
+    // Returns once entries first through last are on disk; false if any of them was in a
+    // batch that failed. Other threads' entries, queued in between or after, do not count.
+    bool commit(std::uint64_t first, std::uint64_t last);
+    // Empties the log once its entries have been folded into the files it protects, and
+    // clears a failure that left the file in doubt. Sequence numbers keep counting from
+    // where they were.
+    bool reset();
+
+    std::uint64_t lastSequence() const;
+    std::size_t syncCount() const;
+
+    // The complete entries in a log file, oldest first. Missing files give no entries.
+    static std::vector<json> readEntries(const std::string& path);
+};
+
+#endif
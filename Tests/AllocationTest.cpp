@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Ingredient.h"
+#include "Storage.h"
+#include "Recipe.h"
+
+// Replace the global operator new so each test can count how many heap allocations a construction path makes.
+static std::atomic<bool> countingAllocations{false};
+static std::atomic<int> allocationCount{0};
+
+void* operator new(std::size_t size) {
+    if (countingAllocations) {
+        ++allocationCount;
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static void startCounting() {
+    allocationCount = 0;
+    countingAllocations = true;
+}
+
+static int stopCounting() {
+    countingAllocations = false;
+    return allocationCount;
+}
+
+// Names longer than the small-string buffer, so every copy shows up as an allocation.
+static const char* kLongName = "extra virgin olive oil from the pantry";
+static const char* kLongStep = "Whisk everything together until completely smooth";
+
+TEST(AllocationTest, IngredientConstructorMovesStrings) {
+    Ingredient::internName(kLongName);   // only the first sight of a name stores it
+    std::string name = kLongName;
+    std::string exp = "2024-10-15";
+
+    startCounting();
+    Ingredient ingredient(std::move(name), 2, std::move(exp));
+    EXPECT_EQ(stopCounting(), 0);
+    EXPECT_EQ(ingredient.getName(), kLongName);
+}
+
+TEST(AllocationTest, FromJsonKnownNameDoesNotCopy) {
+    json j = {{"name", kLongName}, {"quantity", 3}, {"expirationDate", "2024-10-15"}};
+    Ingredient::internName(kLongName);
+
+    startCounting();
+    Ingredient ingredient = Ingredient::fromJSON(j);
+    EXPECT_EQ(stopCounting(), 0); // the name is already interned
+    EXPECT_EQ(ingredient.getName(), kLongName);
+}
+
+TEST(AllocationTest, FromJsonRvalueStealsStrings) {
+    json j = {{"name", kLongName}, {"quantity", 3}, {"expirationDate", "2024-10-15"}};
+    Ingredient::internName(kLongName);
+
+    startCounting();
+    Ingredient ingredient = Ingredient::fromJSON(std::move(j));
+    EXPECT_EQ(stopCounting(), 0);
+    EXPECT_EQ(ingredient.getName(), kLongName);
+    EXPECT_EQ(ingredient.getExpirationDate(), "2024-10-15");
+}
+
+TEST(AllocationTest, StorageAddIngredientRvalue) {
+    Storage storage;
+    storage.addIngredient(Ingredient("flour", 1, ""));
+    Ingredient oil(kLongName, 1, "");
+
+    startCounting();
+    storage.addIngredient(std::move(oil));
+    EXPECT_EQ(stopCounting(), 1); // vector growth only
+    EXPECT_EQ(storage.getIngredients()[1].getName(), kLongName);
+}
+
+TEST(AllocationTest, StorageFromJsonRvalue) {
+    json j = json::array();
+    for (int i = 0; i < 8; ++i) {
+        j.push_back({{"name", kLongName}, {"quantity", i}, {"expirationDate", ""}});
+    }
+    Ingredient::internName(kLongName);
+    Storage storage;
+
+    startCounting();
+    storage.fromJSON(std::move(j));
+    EXPECT_EQ(stopCounting(), 1); // a single reserve for all eight items
+    EXPECT_EQ(storage.getIngredients().size(), 8);
+}
+
+TEST(AllocationTest, RecipeConstructorMovesMembers) {
+    std::vector<std::pair<std::string, std::string>> ingredients = { {kLongName, "1 cup"} };
+    std::vector<std::pair<std::string, std::string>> condiments = { {"Salt", "1 tsp"} };
+    std::vector<std::string> steps = { kLongStep };
+    std::string name = kLongName;
+    std::string type = "Savory";
+
+    startCounting();
+    Recipe recipe(std::move(name), std::move(ingredients), std::move(condiments), std::move(steps), std::move(type));
+    EXPECT_EQ(stopCounting(), 0);
+    EXPECT_EQ(recipe.getSteps()[0], kLongStep);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/Ingredient.cpp /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/HeaderFiles/Storage.cpp /path/to/project/HeaderFiles/Recipe.cpp /path/to/project/Tests/AllocationTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
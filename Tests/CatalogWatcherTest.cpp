@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "CatalogWatcher.h"
+#include "RecipeManager.h"
+
+namespace fs = std::filesystem;
+
+class CatalogWatcherTest : public ::testing::Test {
+protected:
+    fs::path recipeFile;
+
+    void SetUp() override {
+        fs::create_directories(fs::temp_directory_path() / "catalog_watcher_test");
+        recipeFile = fs::temp_directory_path() / "catalog_watcher_test" / "recipes.json";
+        writeRecipes({"Pancakes"});
+    }
+
+    void TearDown() override {
+        fs::remove_all(recipeFile.parent_path());
+    }
+
+    void writeRecipes(const std::vector<std::string>& names) {
+        json j;
+        j["recipes"] = json::array();
+        for (const auto& name : names) {
+            j["recipes"].push_back({{"name", name}, {"category", "Sweet"}, {"ingredients", json::array()},
+                                    {"condiments", json::array()}, {"steps", {"Serve"}}});
+        }
+        std::ofstream(recipeFile) << j.dump();
+    }
+
+    // Polls until the condition holds or two seconds pass.
+    template <typename Condition>
+    bool waitFor(Condition condition) {
+        for (int i = 0; i < 200 && !condition(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return condition();
+    }
+};
+
+TEST_F(CatalogWatcherTest, NotifiesOnChange) {
+    std::atomic<int> changes{0};
+    CatalogWatcher watcher(recipeFile.string(), [&]() { ++changes; });
+    watcher.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    writeRecipes({"Pancakes", "Waffles"});
+    EXPECT_TRUE(waitFor([&]() { return changes > 0; }));
+}
+
+TEST_F(CatalogWatcherTest, IgnoresOtherFiles) {
+    std::atomic<int> changes{0};
+    CatalogWatcher watcher(recipeFile.string(), [&]() { ++changes; });
+    watcher.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::ofstream(recipeFile.parent_path() / "unrelated.txt") << "hello";
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_EQ(changes, 0);
+}
+
+TEST_F(CatalogWatcherTest, ManagerPublishesNewSnapshot) {
+    RecipeManager manager(recipeFile.string());
+    std::shared_ptr<const RecipeCatalog> before = manager.getCatalog();
+    ASSERT_EQ(before->size(), 1);
+
+    manager.watchRecipes();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeRecipes({"Pancakes", "Waffles", "Crepes"});
+
+    EXPECT_TRUE(waitFor([&]() { return manager.getCatalog()->size() == 3; }));
+    EXPECT_EQ(before->size(), 1); // the old snapshot is untouched
+    EXPECT_EQ(before->getRecipes()[0].getRecipeName(), "Pancakes");
+}
+
+TEST_F(CatalogWatcherTest, BrokenFileKeepsPreviousCatalog) {
+    RecipeManager manager(recipeFile.string());
+    std::ofstream(recipeFile) << "{ \"recipes\": [";
+    manager.reloadRecipes();
+    EXPECT_EQ(manager.getCatalog()->size(), 1);
+}
+
+TEST_F(CatalogWatcherTest, ReloadRereadsSubstitutes) {
+    RecipeManager manager(recipeFile.string());
+    std::shared_ptr<const SubstitutionGraph> before = manager.getSubstitutes();
+    EXPECT_EQ(before->edgeCount(), 0);
+
+    std::ofstream(recipeFile.parent_path() / "ingredient_substitutes.json") << "{\"butter\": {\"margarine\": 1}}";
+    manager.reloadRecipes();
+    EXPECT_EQ(manager.getSubstitutes()->edgeCount(), 1);
+    EXPECT_NE(manager.getSubstitutes()->findNode("margarine"), SubstitutionGraph::kNoNode);
+    EXPECT_EQ(before->edgeCount(), 0);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/CatalogWatcherTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "CivilDate.h"
+
+TEST(CivilDateTest, DayNumbers) {
+    EXPECT_EQ(daysFromCivil(1970, 1, 1), 0);
+    EXPECT_EQ(daysFromCivil(2000, 3, 1), 11017);
+    EXPECT_EQ(daysFromCivil(1969, 12, 31), -1);
+    EXPECT_EQ(daysFromCivil(2024, 3, 1) - daysFromCivil(2024, 2, 28), 2);   // leap year
+    EXPECT_EQ(daysFromCivil(2100, 3, 1) - daysFromCivil(2100, 2, 28), 1);   // not a leap year
+
+    // Every day from 1900 to 2200 survives the round trip.
+    for (int days = daysFromCivil(1900, 1, 1); days <= daysFromCivil(2200, 12, 31); ++days) {
+        int year;
+        unsigned month, day;
+        civilFromDays(days, year, month, day);
+        ASSERT_EQ(daysFromCivil(year, month, day), days);
+    }
+}
+
+TEST(CivilDateTest, ParseAndFormat) {
+    int days = 0;
+    EXPECT_TRUE(parseDate("2024-01-05", days));
+    EXPECT_EQ(days, daysFromCivil(2024, 1, 5));
+    EXPECT_EQ(formatDate(days), "2024-01-05");
+    EXPECT_TRUE(parseDate("2024-02-29", days));
+    EXPECT_EQ(formatDate(days), "2024-02-29");
+    EXPECT_TRUE(parseDate("2024-1-5", days));
+    EXPECT_EQ(formatDate(days), "2024-01-05");
+
+    EXPECT_FALSE(parseDate("", days));
+    EXPECT_FALSE(parseDate("2023-02-29", days));
+    EXPECT_FALSE(parseDate("2024-13-01", days));
+    EXPECT_FALSE(parseDate("2024-00-10", days));
+    EXPECT_FALSE(parseDate("2024/01/05", days));
+    EXPECT_FALSE(parseDate("2024-01-05x", days));
+    EXPECT_FALSE(parseDate("24-01-05", days));
+    EXPECT_FALSE(parseDate("2024-0a-05", days));
+}
+
+TEST(CivilDateTest, TodayMatchesLocalClock) {
+    time_t now = time(0);
+    char expected[11];
+    strftime(expected, sizeof(expected), "%Y-%m-%d", localtime(&now));
+
+    std::vector<int> seen(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&seen, t]() { seen[t] = today(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int day : seen) {
+        EXPECT_EQ(formatDate(day), expected);
+    }
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/Tests/CivilDateTest.cpp -I/path/to/project/HeaderFiles -lgtest -lgtest_main -o runTests
+//./runTests
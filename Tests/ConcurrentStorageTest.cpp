@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "ConcurrentStorage.h"
+
+static int quantityOf(const Storage& storage, const std::string& name) {
+    for (const auto& ingredient : storage.getIngredients()) {
+        if (ingredient.getName() == name) {
+            return ingredient.getQuantity();
+        }
+    }
+    return -1;
+}
+
+TEST(ConcurrentStorageTest, SnapshotIsUnaffectedByLaterWrites) {
+    ConcurrentStorage storage;
+    storage.addIngredient(Ingredient("flour", 2, ""));
+    ConcurrentStorage::Snapshot before = storage.snapshot();
+
+    storage.addIngredient(Ingredient("flour", 3, ""));
+    storage.addIngredient(Ingredient("sugar", 1, ""));
+
+    EXPECT_EQ(before->getIngredients().size(), 1);
+    EXPECT_EQ(quantityOf(*before, "flour"), 2);
+    EXPECT_EQ(quantityOf(*storage.snapshot(), "flour"), 5);
+    EXPECT_EQ(storage.getVersion(), 3);
+}
+
+TEST(ConcurrentStorageTest, SetAndRemove) {
+    Storage initial;
+    initial.addIngredient(Ingredient("milk", 1, "2024-10-10"));
+    ConcurrentStorage storage(initial);
+
+    EXPECT_TRUE(storage.setQuantity("milk", 4));
+    EXPECT_FALSE(storage.setQuantity("cream", 4));
+    EXPECT_EQ(quantityOf(*storage.snapshot(), "milk"), 4);
+    EXPECT_TRUE(storage.removeIngredient("milk"));
+    EXPECT_TRUE(storage.snapshot()->getIngredients().empty());
+}
+
+// Writers move units between two ingredients (keeping the total fixed) and add new items,
+// while readers check that every snapshot they see is internally consistent.
+// Build with -fsanitize=thread to check for data races.
+TEST(ConcurrentStorageTest, MixedWorkloadStress) {
+    const int kTotal = 1000;
+    Storage initial;
+    initial.addIngredient(Ingredient("apples", kTotal, ""));
+    initial.addIngredient(Ingredient("pears", 0, ""));
+    ConcurrentStorage storage(initial);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<long> snapshotsRead{0};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < 6; ++r) {
+        threads.emplace_back([&]() {
+            std::uint64_t lastVersion = 0;
+            while (!done) {
+                std::uint64_t versionBefore = storage.getVersion();
+                ConcurrentStorage::Snapshot snap = storage.snapshot();
+                if (quantityOf(*snap, "apples") + quantityOf(*snap, "pears") != kTotal || versionBefore < lastVersion) {
+                    ++inconsistent;
+                }
+                lastVersion = versionBefore;
+                ++snapshotsRead;
+            }
+        });
+    }
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&, w]() {
+            for (int i = 0; i < 500; ++i) {
+                storage.update([](Storage& s) {
+                    int apples = quantityOf(s, "apples");
+                    int pears = quantityOf(s, "pears");
+                    if (apples > 0) {
+                        s.setQuantity("apples", apples - 1);
+                        s.setQuantity("pears", pears + 1);
+                    } else {
+                        s.setQuantity("apples", pears);
+                        s.setQuantity("pears", 0);
+                    }
+                });
+                storage.addIngredient(Ingredient("item" + std::to_string(w * 1000 + i % 50), 1, ""));
+            }
+        });
+    }
+
+    for (std::size_t t = 6; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    done = true;
+    for (int t = 0; t < 6; ++t) {
+        threads[t].join();
+    }
+
+    EXPECT_EQ(inconsistent, 0);
+    EXPECT_GT(snapshotsRead, 0);
+    EXPECT_EQ(storage.getVersion(), 2000);
+    EXPECT_EQ(storage.snapshot()->getIngredients().size(), 102);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread -fsanitize=thread /path/to/project/HeaderFiles/Ingredient.cpp /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/HeaderFiles/Storage.cpp /path/to/project/HeaderFiles/ConcurrentStorage.cpp /path/to/project/Tests/ConcurrentStorageTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <algorithm>
+#include "Cooking.h"
+#include "MealPlanner.h"
+#include "RecipeManager.h"
+
+namespace fs = std::filesystem;
+
+static Recipe omelette() {
+    return Recipe("Omelette", { {"Egg", "3 pieces"}, {"cheese", "1/2 cup"}, {"salt", "to taste "} }, {}, {}, "Savory");
+}
+
+TEST(CookingTest, PlanTakesFromFridgeThenPantry) {
+    Storage fridge;
+    Storage pantry;
+    fridge.addIngredient(Ingredient("egg", 2, "2030-01-01"));
+    fridge.addIngredient(Ingredient("cheese", 1, "2030-01-01"));
+    pantry.addIngredient(Ingredient("egg", 4, ""));
+    pantry.addIngredient(Ingredient("salt", 1, ""));
+
+    std::vector<Deduction> deductions;
+    std::vector<std::string> missing;
+    ASSERT_TRUE(planDeductions(omelette(), fridge, pantry, deductions, missing));
+    EXPECT_EQ(fridge.getIngredients().size(), 2);   // planning changes nothing
+
+    applyDeductions(fridge, pantry, deductions);
+    ASSERT_EQ(fridge.getIngredients().size(), 1);    // the eggs are used up, half the cheese is left
+    EXPECT_DOUBLE_EQ(fridge.getIngredients()[0].getAmount(), 0.5);
+    ASSERT_EQ(pantry.getIngredients().size(), 2);
+    EXPECT_EQ(pantry.getIngredients()[0].getQuantity(), 3);
+    EXPECT_EQ(pantry.getIngredients()[1].getQuantity(), 1);   // "to taste" takes nothing
+
+    undoDeductions(fridge, pantry, deductions);
+    ASSERT_EQ(fridge.getIngredients().size(), 2);
+    EXPECT_EQ(fridge.getIngredients()[0].getExpirationDate(), "2030-01-01");
+    EXPECT_EQ(pantry.getIngredients()[0].getQuantity(), 4);
+}
+
+TEST(CookingTest, ShortStockChangesNothing) {
+    Storage fridge;
+    Storage pantry;
+    fridge.addIngredient(Ingredient("egg", 2, ""));
+    fridge.addIngredient(Ingredient("cheese", 1, ""));
+
+    std::vector<Deduction> deductions;
+    std::vector<std::string> missing;
+    EXPECT_FALSE(planDeductions(omelette(), fridge, pantry, deductions, missing));
+    EXPECT_EQ(missing, (std::vector<std::string>{ "Egg", "salt" }));
+    EXPECT_TRUE(deductions.empty());
+}
+
+TEST(CookingTest, MeasuredAmountsTakeTheirNumber) {
+    Recipe stew("Beef Stew", { {"ground beef", "200 g"}, {"heavy cream", "1/2 cup"}, {"carrots", "1 1/2 pieces"} }, {}, {}, "Savory");
+    Storage fridge;
+    Storage pantry;
+    fridge.addIngredient(Ingredient("ground beef", 250, ""));
+    fridge.addIngredient(Ingredient("heavy cream", 1, ""));
+    fridge.addIngredient(Ingredient("carrots", 2, ""));
+
+    std::vector<Deduction> deductions;
+    std::vector<std::string> missing;
+    ASSERT_TRUE(planDeductions(stew, fridge, pantry, deductions, missing));
+    applyDeductions(fridge, pantry, deductions);
+    ASSERT_EQ(fridge.getIngredients().size(), 2);   // the carrots, rounded up to 2, are used up
+    EXPECT_EQ(fridge.getIngredients()[0].getQuantity(), 50);
+    EXPECT_DOUBLE_EQ(fridge.getIngredients()[1].getAmount(), 0.5);
+
+    EXPECT_FALSE(planDeductions(stew, fridge, pantry, deductions, missing));
+    EXPECT_EQ(missing, (std::vector<std::string>{ "ground beef", "carrots" }));
+}
+
+TEST(CookingTest, FractionalStockIsTakenAndRestoredExactly) {
+    Recipe toast("Toast", { {"bread", "1 slice"} }, {}, {}, "Savory");
+    Storage fridge;
+    Storage pantry;
+    Ingredient bread("bread", 0, "");
+    bread.setAmount(2.5);
+    pantry.addIngredient(bread);
+
+    std::vector<Deduction> deductions;
+    std::vector<std::string> missing;
+    ASSERT_TRUE(planDeductions(toast, fridge, pantry, deductions, missing));
+    applyDeductions(fridge, pantry, deductions);
+    EXPECT_DOUBLE_EQ(pantry.getIngredients()[0].getAmount(), 1.5);
+
+    ASSERT_TRUE(planDeductions(toast, fridge, pantry, deductions, missing));
+    applyDeductions(fridge, pantry, deductions);
+    EXPECT_DOUBLE_EQ(pantry.getIngredients()[0].getAmount(), 0.5);
+    // Half a slice is not a slice.
+    EXPECT_FALSE(planDeductions(toast, fridge, pantry, deductions, missing));
+
+    pantry.addIngredient(Ingredient("bread", 1, ""));
+    ASSERT_TRUE(planDeductions(toast, fridge, pantry, deductions, missing));
+    applyDeductions(fridge, pantry, deductions);
+    undoDeductions(fridge, pantry, deductions);
+    EXPECT_DOUBLE_EQ(pantry.getIngredients()[0].getAmount(), 1.5);
+}
+
+TEST(CookingTest, SubstitutesAreTakenInstead) {
+    Recipe toast("Toast", { {"bread", "2 slices"}, {"Butter", "1 tbsp"} }, {}, {}, "Savory");
+    Storage fridge;
+    Storage pantry;
+    fridge.addIngredient(Ingredient("margarine", 3, ""));
+    pantry.addIngredient(Ingredient("bread", 2, ""));
+
+    std::vector<Deduction> deductions;
+    std::vector<std::string> missing;
+    EXPECT_FALSE(planDeductions(toast, fridge, pantry, deductions, missing));
+    EXPECT_EQ(missing, (std::vector<std::string>{ "Butter" }));
+
+    ASSERT_TRUE(planDeductions(toast, fridge, pantry, deductions, missing, { {"butter", "margarine"} }));
+    applyDeductions(fridge, pantry, deductions);
+    EXPECT_EQ(fridge.getIngredients()[0].getQuantity(), 2);
+    EXPECT_TRUE(pantry.getIngredients().empty());
+}
+
+// The meal planner and cooking take stock by the same rule, so every planned day cooks.
+TEST(CookingTest, PlannedMealsCanBeCookedFromTheShippedStock) {
+    RecipeCatalog catalog = loadRecipeCatalog("recipes.json");
+    json stock;
+    ASSERT_TRUE(readDocument("storage.json", stock));
+    Storage fridge;
+    Storage pantry;
+    fridge.fromJSON(stock["Fridge"]);
+    pantry.fromJSON(stock["Pantry"]);
+    std::vector<Ingredient> inventory = fridge.getIngredients();
+    inventory.insert(inventory.end(), pantry.getIngredients().begin(), pantry.getIngredients().end());
+
+    MealPlanOptions options;
+    options.days = 5;
+    options.timeBudget = std::chrono::milliseconds(10000);
+    MealPlan plan = MealPlanner(catalog, inventory, {}).plan(options);
+
+    std::size_t cooked = 0;
+    std::vector<Deduction> deductions;
+    std::vector<std::string> missing;
+    for (std::size_t recipeId : plan.recipes) {
+        if (recipeId == RecipeCatalog::npos) {
+            continue;
+        }
+        const Recipe& recipe = catalog.getRecipes()[recipeId];
+        ASSERT_TRUE(planDeductions(recipe, fridge, pantry, deductions, missing)) << recipe.getRecipeName();
+        applyDeductions(fridge, pantry, deductions);
+        ++cooked;
+    }
+    EXPECT_GT(cooked, 0);
+
+    // Cookies take 2 cups of flour and only 1 is stocked: neither planned nor cooked.
+    const Recipe* cookies = catalog.findByName("Chocolate Chip Cookies");
+    ASSERT_NE(cookies, nullptr);
+    EXPECT_EQ(std::count(plan.recipes.begin(), plan.recipes.end(), catalog.idOf("Chocolate Chip Cookies")), 0);
+    EXPECT_FALSE(planDeductions(*cookies, fridge, pantry, deductions, missing));
+}
+
+class CookTransactionTest : public ::testing::Test {
+protected:
+    fs::path dir;
+    std::string recipes, storage, history;
+
+    void SetUp() override {
+        dir = fs::temp_directory_path() / "cook_transaction_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+        recipes = (dir / "recipes.json").string();
+        storage = (dir / "storage.json").string();
+        history = (dir / "history.json").string();
+
+        json r;
+        r["recipes"] = json::array({ {
+            {"name", "Toast"}, {"category", "Savory"}, {"time", "5 minutes"},
+            {"ingredients", json::array({ { {"name", "bread"}, {"quantity", "2"}, {"unit", "slices"} } })},
+            {"condiments", json::array()}, {"steps", json::array({ "Toast the bread." })}
+        } });
+        std::ofstream(recipes) << r.dump();
+        json s;
+        s["Fridge"] = json::array();
+        s["Pantry"] = json::array({ Ingredient("bread", 7, "").toJSON() });
+        std::ofstream(storage) << s.dump();
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+    }
+
+    int breadIn(const std::string& file) {
+        json s;
+        readDocument(file, s);
+        for (const auto& item : s["Pantry"]) {
+            if (item["name"] == "bread") {
+                return item["quantity"];
+            }
+        }
+        return 0;
+    }
+};
+
+TEST_F(CookTransactionTest, BatchDeductsLogsAndCheckpoints) {
+    {
+        RecipeManager manager(recipes, storage, history);
+        EXPECT_EQ(manager.cookAll({ "Toast", "Toast", "Unknown", "Toast", "Toast" }), 3);   // the fourth toast has 1 slice
+        EXPECT_EQ(manager.getPantry().getIngredients()[0].getQuantity(), 1);
+        // Durable in the log, not yet in the storage file.
+        EXPECT_EQ(WriteAheadLog::readEntries(storage + ".wal").size(), 3);
+        EXPECT_EQ(breadIn(storage), 7);
+        EXPECT_FALSE(manager.cook("Toast"));
+    }
+    // Destruction checkpoints.
+    EXPECT_EQ(breadIn(storage), 1);
+    EXPECT_TRUE(WriteAheadLog::readEntries(storage + ".wal").empty());
+    json h;
+    readDocument(history, h);
+    ASSERT_EQ(h.size(), 3);
+    EXPECT_EQ(h[2]["name"], "Toast");
+}
+
+TEST_F(CookTransactionTest, RefusedCookOnAFreshLogIsNotALogFailure) {
+    RecipeManager manager(recipes, storage, history);
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(manager.cook("Nope"));
+    EXPECT_EQ(manager.cookAll({ "Toast", "Toast", "Toast", "Toast" }), 3);
+    EXPECT_FALSE(manager.cook("Toast"));
+    EXPECT_EQ(testing::internal::GetCapturedStderr().find("Could not record"), std::string::npos);
+}
+
+TEST_F(CookTransactionTest, RecoversLoggedCooksOnce) {
+    // A crash after logging two cooks, before any checkpoint.
+    {
+        WriteAheadLog log(storage + ".wal");
+        for (int i = 0; i < 2; ++i) {
+            log.add(cookRecord("Toast", 0, { Deduction{ "Pantry", Ingredient("bread", 7 - 2 * i, ""), 2 } }));
+        }
+        log.commit();
+    }
+    {
+        RecipeManager manager(recipes, storage, history);
+        EXPECT_EQ(manager.getPantry().getIngredients()[0].getQuantity(), 3);
+    }
+    EXPECT_EQ(breadIn(storage), 3);
+    {
+        // Starting again does not apply them a second time.
+        RecipeManager manager(recipes, storage, history);
+        EXPECT_EQ(manager.getPantry().getIngredients()[0].getQuantity(), 3);
+        EXPECT_TRUE(manager.cook("Toast"));
+    }
+    EXPECT_EQ(breadIn(storage), 1);
+    json h;
+    readDocument(history, h);
+    EXPECT_EQ(h.size(), 3);
+}
+
+TEST_F(CookTransactionTest, AliasesStayWithTheManager) {
+    std::ofstream((dir / "ingredient_aliases.json").string()) << R"({"bread": ["sourdough"]})";
+    std::shared_ptr<const IngredientAliases> before = IngredientAliases::current();
+    RecipeManager manager(recipes, storage, history);
+    EXPECT_EQ(IngredientAliases::current(), before);
+    EXPECT_NE(manager.getCatalog()->findIngredient("sourdough"), RecipeCatalog::kNoIngredient);
+    EXPECT_EQ(loadRecipeCatalog(recipes).findIngredient("sourdough"), RecipeCatalog::kNoIngredient);
+}
+
+TEST_F(CookTransactionTest, CompletionsCountCooks) {
+    {
+        RecipeManager manager(recipes, storage, history);
+        EXPECT_EQ(manager.completeName("TO")[0].score, 0);
+        EXPECT_EQ(manager.cookAll({ "Toast", "Toast" }), 2);
+        std::vector<Completion> found = manager.completeName("to");
+        ASSERT_EQ(found.size(), 1);
+        EXPECT_EQ(found[0].name, "Toast");
+        EXPECT_EQ(found[0].score, 2);
+        EXPECT_EQ(manager.completeName("b")[0].kind, CompletionKind::Ingredient);
+    }
+    // Counted again from the history file on the next start.
+    RecipeManager manager(recipes, storage, history);
+    EXPECT_EQ(manager.completeName("toast")[0].score, 2);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/CookingTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
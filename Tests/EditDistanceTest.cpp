@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "EditDistance.h"
+
+static bool shareDeletion(const std::string& a, const std::string& b, std::size_t depth) {
+    std::vector<std::uint64_t> left;
+    std::vector<std::uint64_t> right;
+    deletionHashes(a, depth, left);
+    deletionHashes(b, depth, right);
+    std::vector<std::uint64_t> common;
+    std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(common));
+    return !common.empty();
+}
+
+TEST(EditDistanceTest, PatternDistance) {
+    std::string kitten = "kitten";
+    EditDistancePattern pattern(kitten);
+    EXPECT_EQ(pattern.distance("sitting"), 3);
+    EXPECT_EQ(pattern.distance("kitten"), 0);
+    EXPECT_EQ(pattern.distance(""), 6);
+    EXPECT_EQ(boundedEditDistance("kitten", "sitting", 2), 3);
+    EXPECT_EQ(boundedEditDistance("kitten", "kit", 1), 2);   // the length gap alone is too large
+}
+
+TEST(EditDistanceTest, DeletionsCoverEditsUpToTheirDepth) {
+    std::vector<std::uint64_t> hashes;
+    deletionHashes("abc", 1, hashes);
+    EXPECT_EQ(hashes.size(), 4);   // "abc", "bc", "ac", "ab"
+    deletionHashes("aab", 2, hashes);
+    EXPECT_EQ(hashes.size(), 5);   // "aab", "ab", "aa", "b" and "a"
+
+    EXPECT_TRUE(shareDeletion("tomato", "tomatoe", 1));
+    EXPECT_TRUE(shareDeletion("cheddar", "chedar", 1));
+    EXPECT_TRUE(shareDeletion("parmesan", "parmasen", 2));   // two substitutions
+    EXPECT_FALSE(shareDeletion("parmesan", "parmasen", 1));
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/EditDistance.cpp /path/to/project/Tests/EditDistanceTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "ExpiryRanking.h"
+#include "TestRecipes.h"
+
+class ExpiryRankingTest : public ::testing::Test {
+protected:
+    RecipeCatalog catalog{ {
+        makeRecipe("Omelette", { "egg", "cheese" }),
+        makeRecipe("Cheese Toast", { "bread", "cheese" }),
+        makeRecipe("Milkshake", { "milk", "ice cream" }),
+        makeRecipe("Pancakes", { "egg", "flour", "milk" }),
+        makeRecipe("Rice", { "rice" }),
+    } };
+    std::vector<Ingredient> inventory = { Ingredient("egg", 6, ""), Ingredient("Cheese", 1, ""), Ingredient("bread", 1, ""),
+                                          Ingredient("milk", 1, ""), Ingredient("rice", 1, "") };
+
+    std::vector<std::string> names(const std::vector<ExpiryRanker::Ranked>& ranked) {
+        std::vector<std::string> found;
+        for (const auto& r : ranked) {
+            found.push_back(catalog.getRecipes()[r.recipeId].getRecipeName());
+        }
+        return found;
+    }
+};
+
+TEST_F(ExpiryRankingTest, UrgencyFallsWithDaysLeft) {
+    ExpiryRanker ranker(catalog, inventory, { {"milk", 0}, {"cheese", 3}, {"egg", -2}, {"bread", 8}, {"saffron", 0} }, 7);
+    EXPECT_FLOAT_EQ(ranker.getUrgency(catalog.findIngredient("milk")), 1.0f);
+    EXPECT_FLOAT_EQ(ranker.getUrgency(catalog.findIngredient("egg")), 1.0f);
+    EXPECT_FLOAT_EQ(ranker.getUrgency(catalog.findIngredient("cheese")), 5.0f / 8.0f);
+    EXPECT_FLOAT_EQ(ranker.getUrgency(catalog.findIngredient("bread")), 0.0f);
+    EXPECT_FLOAT_EQ(ranker.getUrgency(RecipeCatalog::kNoIngredient), 0.0f);
+}
+
+TEST_F(ExpiryRankingTest, SoonestDateWins) {
+    ExpiryRanker ranker(catalog, inventory, { {"Cheese", 6}, {"cheese", 1} }, 7);
+    EXPECT_FLOAT_EQ(ranker.getUrgency(catalog.findIngredient("cheese")), 7.0f / 8.0f);
+}
+
+TEST_F(ExpiryRankingTest, RanksByUrgencyThenMissing) {
+    ExpiryRanker ranker(catalog, inventory, { {"cheese", 1}, {"milk", 2} }, 7);
+    auto ranked = ranker.rank(1, 10);
+    // Omelette and Cheese Toast: 7/8 each, makeable. Pancakes: 6/8 with flour missing -> 3/8.
+    // Milkshake: 6/8 with ice cream missing -> 3/8. Rice uses nothing urgent.
+    EXPECT_EQ(names(ranked), (std::vector<std::string>{ "Omelette", "Cheese Toast", "Milkshake", "Pancakes" }));
+    EXPECT_EQ(ranked[0].missing, 0);
+    EXPECT_EQ(ranked[2].missing, 1);
+    EXPECT_FLOAT_EQ(ranked[2].score, 3.0f / 8.0f);
+
+    EXPECT_EQ(names(ranker.rank(0, 10)), (std::vector<std::string>{ "Omelette", "Cheese Toast" }));
+    EXPECT_EQ(ranker.rank(1, 1).size(), 1);
+}
+
+TEST_F(ExpiryRankingTest, NothingExpiringNothingRanked) {
+    ExpiryRanker ranker(catalog, inventory, {}, 7);
+    EXPECT_TRUE(ranker.rank().empty());
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/ExpiryRankingTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
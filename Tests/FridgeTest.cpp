@@ -14,6 +14,7 @@ TEST_F(FridgeTest, AddIngredientToFridge) {
     ASSERT_EQ(fridge.getIngredients().size(), 1);
     EXPECT_EQ(fridge.getIngredients()[0].getName(), "Milk");
     EXPECT_EQ(fridge.getIngredients()[0].getQuantity(), 1);
+    EXPECT_EQ(fridge.getIngredients()[0].getLocation(), IngredientLocation::Fridge);
 }
 
 TEST_F(FridgeTest, ExpiringSoon) {
@@ -31,4 +32,17 @@ TEST_F(FridgeTest, ExpiringSoon) {
 
 }
 
-//to run: g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Storage.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Fridge.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/FridgeTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -lgtest -lgtest_main -o runTests
+TEST_F(FridgeTest, DaysUntilExpiry) {
+    time_t inThreeDays = time(0) + 3 * 24 * 60 * 60;
+    char date[11];
+    strftime(date, sizeof(date), "%Y-%m-%d", localtime(&inThreeDays));
+
+    int days = 0;
+    EXPECT_TRUE(Fridge::daysUntilExpiry(Ingredient("Yogurt", 1, date), days));
+    EXPECT_EQ(days, 3);
+    EXPECT_TRUE(Fridge::daysUntilExpiry(Ingredient("Cheese", 1, "2024-01-05"), days));
+    EXPECT_LT(days, 0);
+    EXPECT_FALSE(Fridge::daysUntilExpiry(Ingredient("Rice", 1, ""), days));
+}
+
+//to run: g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/CivilDate.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/IngredientAliases.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Storage.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Fridge.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/FridgeTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -lgtest -lgtest_main -o runTests
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "FuzzyIngredientIndex.h"
+
+// Textbook dynamic programming, to check the bit-parallel version against.
+static std::uint32_t referenceDistance(const std::string& a, const std::string& b) {
+    std::vector<std::vector<std::uint32_t>> table(a.size() + 1, std::vector<std::uint32_t>(b.size() + 1));
+    for (std::size_t i = 0; i <= a.size(); ++i) table[i][0] = static_cast<std::uint32_t>(i);
+    for (std::size_t j = 0; j <= b.size(); ++j) table[0][j] = static_cast<std::uint32_t>(j);
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            table[i][j] = std::min({ table[i - 1][j] + 1, table[i][j - 1] + 1, table[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0u : 1u) });
+        }
+    }
+    return table[a.size()][b.size()];
+}
+
+TEST(FuzzyIngredientIndexTest, EditDistanceMatchesReference) {
+    EXPECT_EQ(FuzzyIngredientIndex::editDistance("tomatoe", "tomato"), 1);
+    EXPECT_EQ(FuzzyIngredientIndex::editDistance("", "abc"), 3);
+    EXPECT_EQ(FuzzyIngredientIndex::editDistance("kitten", "sitting"), 3);
+
+    std::mt19937 random(7);
+    for (int i = 0; i < 2000; ++i) {
+        std::string a(random() % 80, 'a');
+        std::string b(random() % 80, 'a');
+        for (auto& c : a) c = static_cast<char>('a' + random() % 4);
+        for (auto& c : b) c = static_cast<char>('a' + random() % 4);
+        ASSERT_EQ(FuzzyIngredientIndex::editDistance(a, b), referenceDistance(a, b)) << a << " / " << b;
+    }
+}
+
+TEST(FuzzyIngredientIndexTest, SuggestsCloseNamesBestFirst) {
+    FuzzyIngredientIndex index;
+    index.add("Tomato", 5);
+    index.add("potato", 9);
+    index.add("cheddar", 2);
+    index.add("chicken", 4);
+    index.add("tomatoes", 1);   // the plural of a known name
+    EXPECT_EQ(index.size(), 4);
+
+    std::vector<FuzzyIngredientIndex::Match> found = index.suggest("tomatoe", 3);
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[0].name, "tomato");
+    EXPECT_EQ(found[0].distance, 1);
+    EXPECT_EQ(found[0].uses, 6);
+    EXPECT_EQ(found[1].name, "potato");
+    EXPECT_EQ(found[1].distance, 3);
+    EXPECT_EQ(index.suggest("tomatoe", 2).size(), 1);
+    EXPECT_TRUE(index.suggest("xylophone", 2).empty());
+}
+
+TEST(FuzzyIngredientIndexTest, CorrectionNeedsOneClearWinner) {
+    FuzzyIngredientIndex index;
+    for (const char* name : { "cheddar", "tomato", "flour", "floor", "milk" }) {
+        index.add(name);
+    }
+    EXPECT_EQ(index.correction("chedar"), "cheddar");
+    EXPECT_EQ(index.correction("Tomatoes"), "");   // already known
+    EXPECT_EQ(index.correction("flohr"), "");      // flour and floor are equally close
+    EXPECT_EQ(index.correction("mil"), "");        // too short to guess
+    EXPECT_EQ(index.correction("chickpea"), "");
+}
+
+TEST(FuzzyIngredientIndexTest, AliasesOfKnownNamesAreNotTypos) {
+    FuzzyIngredientIndex index;
+    index.add("shrimp");
+    index.add("brawn");
+    EXPECT_EQ(index.correction("prawns"), "");   // an alias of shrimp, not a misspelled brawn
+    EXPECT_EQ(index.correction("brawns"), "");
+    EXPECT_EQ(index.correction("brawm"), "brawn");
+}
+
+TEST(FuzzyIngredientIndexTest, IndexedSearchMatchesLinearScan) {
+    std::mt19937 random(11);
+    std::vector<std::string> words;
+    FuzzyIngredientIndex index;
+    for (int i = 0; i < 3000; ++i) {
+        std::string word(4 + random() % 8, 'a');
+        for (auto& c : word) c = static_cast<char>('a' + random() % 6);
+        if (!index.contains(word)) {
+            index.add(word);
+            words.push_back(word);
+        }
+    }
+    for (int q = 0; q < 200; ++q) {
+        std::string query = words[random() % words.size()];
+        query[random() % query.size()] = 'z';
+        std::size_t expected = 0;
+        for (const auto& word : words) {
+            expected += referenceDistance(query, word) <= 2 ? 1 : 0;
+        }
+        ASSERT_EQ(index.suggest(query, 2, words.size()).size(), expected) << query;
+    }
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/FuzzyIngredientIndexTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include "HouseholdManager.h"
+#include "PersistenceFormat.h"
+
+namespace fs = std::filesystem;
+
+class HouseholdManagerTest : public ::testing::Test {
+protected:
+    fs::path root;
+    std::shared_ptr<const RecipeCatalog> catalog;
+
+    void SetUp() override {
+        root = fs::temp_directory_path() / "household_manager_test";
+        fs::remove_all(root);
+
+        std::vector<Recipe> recipes;
+        recipes.emplace_back("Omelette", std::vector<std::pair<std::string, std::string>>{ {"egg", "2"} },
+                             std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{ "Fry" }, "Savory");
+        recipes.emplace_back("Pancakes", std::vector<std::pair<std::string, std::string>>{ {"egg", "1"}, {"flour", "1 cup"} },
+                             std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{ "Mix" }, "Sweet");
+        catalog = std::make_shared<const RecipeCatalog>(std::move(recipes));
+
+        writeStorage("alice", R"({ "Fridge": [ { "name": "egg", "quantity": 6, "expirationDate": "2024-10-13" } ], "Pantry": [] })");
+        writeStorage("bob", R"({ "Fridge": [ { "name": "egg", "quantity": 2, "expirationDate": "2024-10-13" } ],
+                                 "Pantry": [ { "name": "flour", "quantity": 3 } ] })");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    void writeStorage(const std::string& tenant, const std::string& contents) {
+        fs::create_directories(root / tenant);
+        std::ofstream(root / tenant / "storage.json") << contents;
+    }
+};
+
+TEST_F(HouseholdManagerTest, LoadsHouseholdsLazily) {
+    HouseholdManager manager(catalog, root.string());
+    EXPECT_EQ(manager.residentCount(), 0);
+
+    auto alice = manager.acquire("alice");
+    ASSERT_NE(alice, nullptr);
+    EXPECT_EQ(alice->getFridge().getIngredients().size(), 1);
+    EXPECT_EQ(manager.residentCount(), 1);
+    EXPECT_EQ(manager.acquire("alice"), alice);
+}
+
+TEST_F(HouseholdManagerTest, EachTenantSeesItsOwnStorage) {
+    HouseholdManager manager(catalog, root.string());
+    EXPECT_EQ(manager.findMakeableRecipes("alice"), std::vector<std::string>{ "Omelette" });
+    EXPECT_EQ(manager.findMakeableRecipes("bob", "sweet"), std::vector<std::string>{ "Pancakes" });
+    EXPECT_TRUE(manager.findMakeableRecipes("carol").empty()); // unknown tenants start empty
+}
+
+TEST_F(HouseholdManagerTest, RejectsPathLikeIds) {
+    HouseholdManager manager(catalog, root.string());
+    EXPECT_EQ(manager.acquire("../alice"), nullptr);
+    EXPECT_EQ(manager.acquire(""), nullptr);
+}
+
+TEST_F(HouseholdManagerTest, EvictedHouseholdsAreSaved) {
+    HouseholdManager manager(catalog, root.string(), 1); // one household per shard
+    {
+        auto carol = manager.acquire("carol");
+        std::lock_guard<std::mutex> guard(carol->lock);
+        carol->addToPantry(Ingredient("flour", 4, ""));
+    }
+    for (int i = 0; i < 200; ++i) {
+        manager.acquire("tenant" + std::to_string(i));
+    }
+    EXPECT_LE(manager.residentCount(), 16);
+    ASSERT_TRUE(fs::exists(root / "carol" / "storage.json"));
+
+    auto carol = manager.acquire("carol");
+    ASSERT_EQ(carol->getPantry().getIngredients().size(), 1);
+    EXPECT_EQ(carol->getPantry().getIngredients()[0].getQuantity(), 4);
+}
+
+TEST_F(HouseholdManagerTest, ReadsBinaryStorage) {
+    json storage;
+    storage["Fridge"] = json::array();
+    storage["Pantry"] = json::array({ Ingredient("flour", 2, "").toJSON() });
+    fs::create_directories(root / "dave");
+    ASSERT_TRUE(writeDocument((root / "dave" / "storage.json").string(), storage, PersistenceFormat::Cbor));
+
+    HouseholdManager manager(catalog, root.string());
+    auto dave = manager.acquire("dave");
+    ASSERT_EQ(dave->getPantry().getIngredients().size(), 1);
+    EXPECT_EQ(dave->getPantry().getIngredients()[0].getQuantity(), 2);
+}
+
+TEST_F(HouseholdManagerTest, ParallelQueriesAcrossTenants) {
+    std::vector<std::string> tenants;
+    for (int i = 0; i < 64; ++i) {
+        tenants.push_back(i % 2 == 0 ? "alice" : "bob");
+        tenants.push_back("empty" + std::to_string(i));
+    }
+
+    HouseholdManager manager(catalog, root.string(), 32);
+    auto results = manager.findMakeableRecipes(tenants, "", 8);
+    ASSERT_EQ(results.size(), tenants.size());
+    for (std::size_t i = 0; i < tenants.size(); ++i) {
+        if (tenants[i] == "alice") {
+            EXPECT_EQ(results[i], std::vector<std::string>{ "Omelette" });
+        } else if (tenants[i] == "bob") {
+            EXPECT_EQ(results[i], (std::vector<std::string>{ "Pancakes", "Omelette" })); // sweet recipes come first
+        } else {
+            EXPECT_TRUE(results[i].empty());
+        }
+    }
+}
+
+TEST_F(HouseholdManagerTest, RecordCookedWritesTenantHistory) {
+    HouseholdManager manager(catalog, root.string());
+    manager.recordCooked("bob", "Pancakes");
+
+    std::ifstream file(root / "bob" / "history.json");
+    json history;
+    file >> history;
+    ASSERT_EQ(history.size(), 1);
+    EXPECT_EQ(history[0]["name"], "Pancakes");
+    EXPECT_FALSE(fs::exists(root / "alice" / "history.json"));
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/HouseholdManagerTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "IngredientAliases.h"
+
+TEST(IngredientAliasesTest, PluralsAndCase) {
+    IngredientAliases aliases;
+    EXPECT_EQ(aliases.canonical("Eggs"), "egg");
+    EXPECT_EQ(aliases.canonical("egg"), "egg");
+    EXPECT_EQ(aliases.canonical("Tomatoes"), aliases.canonical("tomato"));
+    EXPECT_EQ(aliases.canonical("berries"), aliases.canonical("berry"));
+    EXPECT_EQ(aliases.canonical("peaches"), "peach");
+    EXPECT_EQ(aliases.canonical("cookies"), aliases.canonical("cookie"));
+    EXPECT_EQ(aliases.canonical("bay leaves"), "bay leaf");
+    EXPECT_EQ(aliases.canonical("hummus"), "hummus");
+    EXPECT_EQ(aliases.canonical("molasses"), aliases.canonical("molasses"));
+    EXPECT_EQ(aliases.canonical("  Olive   Oil "), "olive oil");
+    EXPECT_EQ(aliases.canonical(""), "");
+}
+
+TEST(IngredientAliasesTest, MultiWordTerms) {
+    IngredientAliases aliases;
+    EXPECT_EQ(aliases.canonical("cheddar cheese"), "cheese");
+    EXPECT_EQ(aliases.canonical("Cheddar Cheese Sauce"), "cheese sauce");
+    EXPECT_EQ(aliases.canonical("2 large eggs"), "2 egg");
+    EXPECT_EQ(aliases.canonical("fresh chopped scallions"), "green onion");
+    EXPECT_EQ(aliases.canonical("cheddar"), "cheese");
+    // Whole words only.
+    EXPECT_EQ(aliases.canonical("cheddars"), "cheese");
+    EXPECT_EQ(aliases.canonical("freshwater fish"), "freshwater fish");
+}
+
+TEST(IngredientAliasesTest, UserDictionaryOverridesBuiltIns) {
+    json dictionary = { {"aged cheddar", {"cheddar", "sharp cheddar cheese"}}, {"", {"organic"}} };
+    IngredientAliases aliases(dictionary);
+    EXPECT_EQ(aliases.canonical("cheddar"), "aged cheddar");
+    EXPECT_EQ(aliases.canonical("organic sharp cheddar cheese"), "aged cheddar");
+    EXPECT_EQ(aliases.canonical("cheddar cheese"), "cheese");   // the longer built-in term still applies
+}
+
+TEST(IngredientAliasesTest, InstalledTableIsShared) {
+    auto previous = IngredientAliases::current();
+    IngredientAliases::install(std::make_shared<const IngredientAliases>(json{ {"egg", {"hen egg"}} }));
+    EXPECT_EQ(IngredientAliases::current()->canonical("hen eggs"), "egg");
+    IngredientAliases::install(previous);
+    EXPECT_EQ(IngredientAliases::current()->canonical("hen eggs"), "hen egg");
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/Tests/IngredientAliasesTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
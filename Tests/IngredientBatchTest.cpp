@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "IngredientBatch.h"
+#include "Fridge.h"
+#include "Pantry.h"
+
+TEST(IngredientBatchTest, CommitAddsEverythingOnce) {
+    Fridge fridge;
+    Pantry pantry;
+    int commits = 0;
+    IngredientBatch batch(fridge, pantry, [&]() { ++commits; });
+    batch.addToFridge(Ingredient("Milk", 1, "2030-01-01"))
+         .addToFridge(Ingredient("Milk", 2, ""))
+         .addToPantry(Ingredient("Rice", 3, ""));
+    EXPECT_EQ(batch.size(), 3);
+    EXPECT_TRUE(fridge.getIngredients().empty());
+
+    testing::internal::CaptureStdout();
+    batch.commit();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(commits, 1);
+    EXPECT_EQ(output, "2 ingredients added to Fridge.\n1 ingredient added to Pantry.\n");
+    ASSERT_EQ(fridge.getIngredients().size(), 1);
+    EXPECT_EQ(fridge.getIngredients()[0].getQuantity(), 3);
+    EXPECT_EQ(fridge.getIngredients()[0].getLocation(), IngredientLocation::Fridge);
+    ASSERT_EQ(pantry.getIngredients().size(), 1);
+    EXPECT_EQ(pantry.getIngredients()[0].getLocation(), IngredientLocation::Pantry);
+    EXPECT_EQ(batch.size(), 0);
+
+    batch.commit();   // nothing new: no second save
+    EXPECT_EQ(commits, 1);
+}
+
+TEST(IngredientBatchTest, UncommittedBatchIsDropped) {
+    Fridge fridge;
+    Pantry pantry;
+    int commits = 0;
+    {
+        IngredientBatch batch(fridge, pantry, [&]() { ++commits; });
+        batch.addToFridge(Ingredient("Milk", 1, ""));
+    }
+    EXPECT_EQ(commits, 0);
+    EXPECT_TRUE(fridge.getIngredients().empty());
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/Ingredient.cpp /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/HeaderFiles/Storage.cpp /path/to/project/HeaderFiles/Fridge.cpp /path/to/project/HeaderFiles/Pantry.cpp /path/to/project/HeaderFiles/IngredientBatch.cpp /path/to/project/Tests/IngredientBatchTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <climits>
 #include "Ingredient.h" 
 
 //Unit tests for the Ingredient class: IngredientTest Suite
@@ -32,6 +33,57 @@ TEST(IngredientTest, FromJsonConversion) {
     EXPECT_EQ(ingredient.getExpirationDate(), "2024-10-15");
 }
 
+TEST(IngredientTest, PackedFields) {
+    EXPECT_EQ(sizeof(Ingredient), 16u);
+
+    Ingredient a("flour", 2, "2024-10-15");
+    Ingredient b("flour", 5, "");
+    EXPECT_EQ(a.getNameId(), b.getNameId()); // one interned copy of the name
+    EXPECT_EQ(&a.getName(), &b.getName());
+    EXPECT_EQ(b.getExpirationDate(), "");
+    EXPECT_EQ(b.getExpiryDay(), kNoDate);
+    EXPECT_EQ(Ingredient("milk", 1, "not a date").getExpirationDate(), "");
+
+    a.setAmount(1.5);
+    EXPECT_EQ(a.getQuantity(), 1);
+    EXPECT_DOUBLE_EQ(a.getAmount(), 1.5);
+    Ingredient back = Ingredient::fromJSON(a.toJSON());
+    EXPECT_DOUBLE_EQ(back.getAmount(), 1.5);
+    EXPECT_EQ(back.getExpirationDate(), "2024-10-15");
+
+    a.setLocation(IngredientLocation::Pantry);
+    EXPECT_EQ(a.getLocation(), IngredientLocation::Pantry);
+    EXPECT_EQ(a.getNameId(), b.getNameId());
+}
+
+TEST(IngredientTest, UnreadableDateIsReported) {
+    testing::internal::CaptureStderr();
+    Ingredient hello = Ingredient::fromJSON(json{ {"name", "hello"}, {"quantity", 12}, {"expirationDate", "1221-21-1"} });
+    std::string warning = testing::internal::GetCapturedStderr();
+    EXPECT_EQ(hello.getExpiryDay(), kNoDate);
+    EXPECT_NE(warning.find("1221-21-1"), std::string::npos);
+    EXPECT_NE(warning.find("hello"), std::string::npos);
+
+    testing::internal::CaptureStderr();
+    Ingredient("salt", 1, "");
+    EXPECT_EQ(testing::internal::GetCapturedStderr(), "");
+}
+
+TEST(IngredientTest, LargeQuantitiesAreKept) {
+    Ingredient flour("flour", 3000000, "");
+    EXPECT_EQ(flour.getQuantity(), 3000000);
+    EXPECT_EQ(flour.toJSON()["quantity"], 3000000);
+
+    Ingredient loaded = Ingredient::fromJSON(json{ {"name", "flour"}, {"quantity", 5000000000LL} });
+    EXPECT_DOUBLE_EQ(loaded.getAmount(), 5e9);
+    EXPECT_EQ(loaded.toJSON()["quantity"], 5000000000LL);
+    EXPECT_EQ(loaded.getQuantity(), INT_MAX);   // the int getter caps
+
+    Ingredient max("sugar", INT_MAX, "");
+    max.setAmount(max.getAmount() + 1.25);
+    EXPECT_DOUBLE_EQ(max.getAmount(), 2147483648.25);
+}
+
 //to run:
-// g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/IngredientTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/ -lgtest -lgtest_main -o runTests
+// g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/CivilDate.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/IngredientAliases.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/IngredientTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/ -lgtest -lgtest_main -o runTests
 //./runTests
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "InventoryImport.h"
+#include "FuzzyIngredientIndex.h"
+#include "Fridge.h"
+#include "Pantry.h"
+
+static std::string writeFile(const std::string& name, const std::string& contents) {
+    std::ofstream out(name, std::ios::binary);
+    out << contents;
+    return name;
+}
+
+TEST(InventoryImportTest, NormalizesNames) {
+    EXPECT_EQ(normalizeIngredientName("  Olive   Oil ", 14), "olive oil");
+    EXPECT_EQ(normalizeIngredientName("EGGS", 4), "eggs");
+}
+
+TEST(InventoryImportTest, ReadsHeaderQuotesAndLocations) {
+    std::string path = writeFile("import_test.csv",
+        "Quantity,Name,Location,Expiration\r\n"
+        "2,Milk,,2030-01-05\r\n"
+        "1.5,\"Tomatoes, canned\",pantry,\r\n"
+        "\r\n"
+        "3,  milk ,fridge,\r\n"
+        "x,Flour,,\r\n"
+        "4,Rice,cellar,\r\n");
+    Fridge fridge;
+    Pantry pantry;
+    IngredientBatch batch(fridge, pantry);
+    ImportReport report;
+    ASSERT_TRUE(importInventory(path, batch, report));
+    testing::internal::CaptureStdout();
+    batch.commit();
+    testing::internal::GetCapturedStdout();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(report.lines, 5);
+    EXPECT_EQ(report.imported, 3);
+    EXPECT_EQ(report.skipped, 2);
+    EXPECT_EQ(report.badLines, (std::vector<std::size_t>{ 6, 7 }));
+
+    ASSERT_EQ(fridge.getIngredients().size(), 1);
+    EXPECT_EQ(fridge.getIngredients()[0].getName(), "milk");
+    EXPECT_EQ(fridge.getIngredients()[0].getQuantity(), 5);
+    EXPECT_EQ(fridge.getIngredients()[0].getExpirationDate(), "2030-01-05");
+    ASSERT_EQ(pantry.getIngredients().size(), 1);
+    EXPECT_EQ(pantry.getIngredients()[0].getName(), "tomatoes, canned");
+    EXPECT_DOUBLE_EQ(pantry.getIngredients()[0].getAmount(), 1.5);
+}
+
+TEST(InventoryImportTest, ParallelChunksMatchOneThread) {
+    // Large enough to be split into several chunks, tab separated and without a header.
+    std::string contents;
+    for (int i = 0; i < 100000; ++i) {
+        contents += "item " + std::to_string(i % 977) + "\t" + std::to_string(1 + i % 3) + (i % 2 ? "\t2030-02-01\n" : "\t\n");
+    }
+    contents += "broken line\n";
+    std::string path = writeFile("import_test.tsv", contents);
+
+    auto run = [&](unsigned threads, Fridge& fridge, Pantry& pantry, ImportReport& report) {
+        IngredientBatch batch(fridge, pantry);
+        ImportOptions options;
+        options.threadCount = threads;
+        ASSERT_TRUE(importInventory(path, batch, report, options));
+        testing::internal::CaptureStdout();
+        batch.commit();
+        testing::internal::GetCapturedStdout();
+    };
+    Fridge fridgeOne, fridgeMany;
+    Pantry pantryOne, pantryMany;
+    ImportReport one, many;
+    run(1, fridgeOne, pantryOne, one);
+    run(4, fridgeMany, pantryMany, many);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(many.imported, 100000);
+    EXPECT_EQ(many.badLines, (std::vector<std::size_t>{ 100001 }));
+    EXPECT_EQ(one.badLines, many.badLines);
+    EXPECT_EQ(fridgeOne.toJSON(), fridgeMany.toJSON());
+    EXPECT_EQ(pantryOne.toJSON(), pantryMany.toJSON());
+}
+
+TEST(InventoryImportTest, MissingFile) {
+    Fridge fridge;
+    Pantry pantry;
+    IngredientBatch batch(fridge, pantry);
+    ImportReport report;
+    EXPECT_FALSE(importInventory("no_such_manifest.csv", batch, report));
+}
+
+TEST(InventoryImportTest, CorrectsTyposOfKnownNames) {
+    std::string path = writeFile("import_typo_test.csv", "tomatoe,2\nchedar,1\nTomatoes,1\negg,3\n");
+    FuzzyIngredientIndex known;
+    known.add("tomato");
+    known.add("cheddar");
+    known.add("egg");
+    Fridge fridge;
+    Pantry pantry;
+    IngredientBatch batch(fridge, pantry);
+    ImportReport report;
+    ImportOptions options;
+    options.spelling = &known;
+    ASSERT_TRUE(importInventory(path, batch, report, options));
+    testing::internal::CaptureStdout();
+    batch.commit();
+    testing::internal::GetCapturedStdout();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(report.imported, 4);
+    EXPECT_EQ(report.corrected, 2);   // "tomatoes" is a known name in another form, not a typo
+    EXPECT_EQ(report.corrections, (std::vector<std::pair<std::string, std::string>>{ {"tomatoe", "tomato"}, {"chedar", "cheddar"} }));
+    std::vector<std::string> names;
+    for (const auto& item : pantry.getIngredients()) {
+        names.push_back(item.getName());
+    }
+    // "tomatoes" is added to "tomato": the pantry merges plurals.
+    EXPECT_EQ(names, (std::vector<std::string>{ "tomato", "cheddar", "egg" }));
+    EXPECT_EQ(pantry.getIngredients()[0].getQuantity(), 3);
+}
+
+TEST(InventoryImportTest, MergesIntoExistingStock) {
+    std::string path = writeFile("import_merge_test.csv", "milk,2,2030-02-01\neggs,6,2030-02-01\nolive  oil,1\n");
+    Fridge fridge;
+    Pantry pantry;
+    testing::internal::CaptureStdout();
+    fridge.addIngredient(Ingredient("Milk", 1, "2030-01-01"));
+    fridge.addIngredient(Ingredient("egg", 2, ""));
+    pantry.addIngredient(Ingredient("Olive Oil", 1, ""));
+    IngredientBatch batch(fridge, pantry);
+    ImportReport report;
+    ASSERT_TRUE(importInventory(path, batch, report));
+    batch.commit();
+    testing::internal::GetCapturedStdout();
+    std::remove(path.c_str());
+
+    // One row per item, under the spelling already in stock.
+    ASSERT_EQ(fridge.getIngredients().size(), 2);
+    EXPECT_EQ(fridge.getIngredients()[0].getName(), "Milk");
+    EXPECT_EQ(fridge.getIngredients()[0].getQuantity(), 3);
+    EXPECT_EQ(fridge.getIngredients()[0].getExpirationDate(), "2030-02-01");
+    EXPECT_EQ(fridge.getIngredients()[1].getName(), "egg");
+    EXPECT_EQ(fridge.getIngredients()[1].getQuantity(), 8);
+    ASSERT_EQ(pantry.getIngredients().size(), 1);
+    EXPECT_EQ(pantry.getIngredients()[0].getName(), "Olive Oil");
+    EXPECT_EQ(pantry.getIngredients()[0].getQuantity(), 2);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/Ingredient.cpp /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/HeaderFiles/Storage.cpp /path/to/project/HeaderFiles/Fridge.cpp /path/to/project/HeaderFiles/Pantry.cpp /path/to/project/HeaderFiles/IngredientBatch.cpp /path/to/project/HeaderFiles/InventoryImport.cpp /path/to/project/HeaderFiles/FuzzyIngredientIndex.cpp /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/Tests/InventoryImportTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
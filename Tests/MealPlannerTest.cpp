@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "MealPlanner.h"
+#include "TestRecipes.h"
+
+class MealPlannerTest : public ::testing::Test {
+protected:
+    RecipeCatalog catalog{ {
+        recipeWithAmounts("Omelette", { {"egg", "2 pieces"}, {"cheese", "1/2 cup"} }),
+        recipeWithAmounts("Scrambled Eggs", { {"egg", "3 pieces"} }),
+        recipeWithAmounts("Spinach Salad", { {"spinach", "1 bunch"}, {"salt", "to taste"} }),
+        recipeWithAmounts("Beef Stew", { {"ground beef", "200 g"}, {"carrots", "2 pieces"} }),
+    } };
+
+    std::vector<std::string> names(const MealPlan& plan) {
+        std::vector<std::string> found;
+        for (std::size_t id : plan.recipes) {
+            found.push_back(id == RecipeCatalog::npos ? "-" : catalog.getRecipes()[id].getRecipeName());
+        }
+        return found;
+    }
+};
+
+TEST_F(MealPlannerTest, DecrementsStockAcrossDays) {
+    std::vector<Ingredient> inventory = { Ingredient("egg", 5, ""), Ingredient("cheese", 1, "") };
+    MealPlanOptions options;
+    options.days = 3;
+    MealPlan plan = MealPlanner(catalog, inventory, {}).plan(options);
+
+    // Two omelettes use 4/5 of the eggs and all the cheese (1.8), which beats an omelette
+    // plus scrambled eggs (1 + 0.5). The single egg left is not enough for a third meal.
+    std::vector<std::string> meals = names(plan);
+    ASSERT_EQ(meals.size(), 3);
+    EXPECT_EQ(std::count(meals.begin(), meals.end(), "Omelette"), 2);
+    EXPECT_EQ(std::count(meals.begin(), meals.end(), "-"), 1);
+    EXPECT_NEAR(plan.usage, 0.8 + 1.0, 1e-9);
+    EXPECT_TRUE(plan.completed);
+    EXPECT_LE(plan.score, plan.upperBound + 1e-9);
+}
+
+TEST_F(MealPlannerTest, UsesItemsBeforeTheyExpire) {
+    std::vector<Ingredient> inventory = { Ingredient("spinach", 1, ""), Ingredient("salt", 1, ""),
+                                          Ingredient("ground beef", 200, ""), Ingredient("carrots", 2, "") };
+    MealPlanOptions options;
+    options.days = 2;
+    // Spinach is only good today; the beef lasts longer.
+    MealPlan plan = MealPlanner(catalog, inventory, { {"spinach", 0}, {"ground beef", 3} }).plan(options);
+    EXPECT_EQ(names(plan), (std::vector<std::string>{ "Spinach Salad", "Beef Stew" }));
+    EXPECT_NEAR(plan.waste, 0.0, 1e-9);
+
+    // With a single day, something must spoil: the salad saves the spinach, the stew would waste it.
+    options.days = 1;
+    plan = MealPlanner(catalog, inventory, { {"spinach", 0}, {"ground beef", 3} }).plan(options);
+    EXPECT_EQ(names(plan), std::vector<std::string>{ "Spinach Salad" });
+}
+
+TEST_F(MealPlannerTest, ExpiredItemsAreNotUsed) {
+    std::vector<Ingredient> inventory = { Ingredient("spinach", 1, ""), Ingredient("salt", 1, "") };
+    MealPlanOptions options;
+    options.days = 2;
+    MealPlan plan = MealPlanner(catalog, inventory, { {"spinach", -1} }).plan(options);
+    EXPECT_EQ(names(plan), (std::vector<std::string>{ "-", "-" }));
+    EXPECT_DOUBLE_EQ(plan.upperBound, 0.0);
+}
+
+TEST_F(MealPlannerTest, SameStockIsMemoized) {
+    std::vector<Ingredient> inventory = { Ingredient("egg", 12, ""), Ingredient("cheese", 4, "") };
+    MealPlanOptions options;
+    options.days = 4;
+    options.threadCount = 4;
+    MealPlan parallel = MealPlanner(catalog, inventory, {}).plan(options);
+    // Omelette then eggs reaches the same stock as eggs then omelette.
+    EXPECT_GT(parallel.memoHits, 0);
+
+    options.threadCount = 1;
+    MealPlan serial = MealPlanner(catalog, inventory, {}).plan(options);
+    EXPECT_EQ(parallel.recipes, serial.recipes);
+    EXPECT_DOUBLE_EQ(parallel.score, serial.score);
+}
+
+TEST_F(MealPlannerTest, ZeroBudgetStillGivesAPlan) {
+    std::vector<Ingredient> inventory = { Ingredient("egg", 12, ""), Ingredient("cheese", 4, "") };
+    MealPlanOptions options;
+    options.days = 5;
+    options.timeBudget = std::chrono::milliseconds(0);
+    MealPlan plan = MealPlanner(catalog, inventory, {}).plan(options);
+    EXPECT_EQ(plan.recipes.size(), 5);
+    EXPECT_GT(plan.usage, 0.0);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/MealPlannerTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
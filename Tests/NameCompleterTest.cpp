@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include "NameCompleter.h"
+
+static std::vector<std::string> names(const std::vector<Completion>& completions) {
+    std::vector<std::string> found;
+    for (const auto& completion : completions) {
+        found.push_back(completion.name);
+    }
+    return found;
+}
+
+TEST(NameCompleterTest, CompletesByScoreIgnoringCase) {
+    NameCompleter completer;
+    completer.setScore("chocolate chips", CompletionKind::Ingredient, 5);
+    completer.setScore("Chocolate Chip Cookies", CompletionKind::Recipe, 2);
+    completer.setScore("chicken", CompletionKind::Ingredient, 9);
+    completer.setScore("cheese", CompletionKind::Ingredient, 2);
+    completer.add("carrot", CompletionKind::Ingredient);
+
+    EXPECT_EQ(names(completer.complete("CH")), (std::vector<std::string>{ "chicken", "chocolate chips", "cheese", "Chocolate Chip Cookies" }));
+    EXPECT_EQ(names(completer.complete("choc")), (std::vector<std::string>{ "chocolate chips", "Chocolate Chip Cookies" }));
+    EXPECT_EQ(names(completer.complete("chocolate chip ")), std::vector<std::string>{ "Chocolate Chip Cookies" });
+    EXPECT_EQ(completer.complete("chocolate chip ")[0].kind, CompletionKind::Recipe);
+    EXPECT_EQ(names(completer.complete("c", 2)), (std::vector<std::string>{ "chicken", "chocolate chips" }));
+    EXPECT_TRUE(completer.complete("chx").empty());
+    EXPECT_EQ(completer.complete("").size(), 5);
+}
+
+TEST(NameCompleterTest, UpdatesInPlace) {
+    NameCompleter completer;
+    completer.setScore("milk", CompletionKind::Ingredient, 3);
+    completer.setScore("mint", CompletionKind::Ingredient, 2);
+    completer.addScore("Minestrone", CompletionKind::Recipe);   // new, splits the "mi" edge further
+    EXPECT_EQ(names(completer.complete("mi")), (std::vector<std::string>{ "milk", "mint", "Minestrone" }));
+
+    completer.addScore("Minestrone", CompletionKind::Recipe, 3);
+    completer.setScore("milk", CompletionKind::Ingredient, 0);
+    EXPECT_EQ(names(completer.complete("mi")), (std::vector<std::string>{ "Minestrone", "mint", "milk" }));
+    EXPECT_EQ(names(completer.complete("min")), (std::vector<std::string>{ "Minestrone", "mint" }));
+
+    completer.add("mint", CompletionKind::Ingredient);   // already known: keeps its score
+    EXPECT_EQ(completer.complete("mint")[0].score, 2);
+    EXPECT_EQ(completer.size(), 3);
+}
+
+TEST(NameCompleterTest, MatchesSortingEveryName) {
+    std::mt19937 random(3);
+    NameCompleter completer;
+    std::map<std::string, double> scores;
+    for (int i = 0; i < 3000; ++i) {
+        std::string name(1 + random() % 7, 'a');
+        for (auto& c : name) c = static_cast<char>('a' + random() % 3);
+        double score = static_cast<double>(random() % 50);
+        if (i % 3 == 0) {
+            completer.addScore(name, CompletionKind::Ingredient, score);
+            scores[name] += score;
+        } else {
+            completer.setScore(name, CompletionKind::Ingredient, score);
+            scores[name] = score;
+        }
+    }
+    for (const std::string prefix : { "", "a", "ab", "abc", "cc", "bab", "caaa" }) {
+        std::vector<std::pair<double, std::string>> expected;
+        for (const auto& entry : scores) {
+            if (entry.first.compare(0, prefix.size(), prefix) == 0) {
+                expected.emplace_back(-entry.second, entry.first);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min(expected.size(), NameCompleter::kTopK));
+        std::vector<std::string> expectedNames;
+        for (const auto& entry : expected) {
+            expectedNames.push_back(entry.second);
+        }
+        EXPECT_EQ(names(completer.complete(prefix)), expectedNames) << prefix;
+    }
+}
+
+TEST(NameCompleterTest, ScoresCatalogIngredientsByUse) {
+    std::vector<Recipe> recipes;
+    recipes.emplace_back("Pancakes", std::vector<std::pair<std::string, std::string>>{ {"flour", "1"}, {"egg", "1"} },
+                         std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Sweet");
+    recipes.emplace_back("Pasta", std::vector<std::pair<std::string, std::string>>{ {"flour", "1"}, {"eggs", "2"}, {"parsley", "1"} },
+                         std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Savory");
+    RecipeCatalog catalog(std::move(recipes));
+    NameCompleter completer(catalog);
+    completer.setScore("Pasta", CompletionKind::Recipe, 4);   // e.g. cooked four times
+
+    std::vector<Completion> found = completer.complete("p");
+    EXPECT_EQ(names(found), (std::vector<std::string>{ "Pasta", "parsley", "Pancakes" }));
+    EXPECT_EQ(completer.complete("egg")[0].score, 2);
+
+    completer.addCatalog(catalog);   // a reload keeps the recipe scores
+    EXPECT_EQ(completer.complete("pas")[0].score, 4);
+}
+
+TEST(NameCompleterTest, SetCatalogDropsRemovedNames) {
+    auto recipe = [](const std::string& name, const std::vector<std::string>& ingredients) {
+        std::vector<std::pair<std::string, std::string>> amounts;
+        for (const auto& ingredient : ingredients) {
+            amounts.push_back({ ingredient, "1" });
+        }
+        return Recipe(name, amounts, std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Sweet");
+    };
+    std::vector<Recipe> before;
+    before.push_back(recipe("Pancakes", { "flour", "parsnip" }));
+    before.push_back(recipe("Pasta", { "flour", "parsley" }));
+    NameCompleter completer{ RecipeCatalog(std::move(before)) };
+    completer.setScore("Pancakes", CompletionKind::Recipe, 3);
+    completer.add("parsley", CompletionKind::Ingredient);   // also in stock
+
+    std::vector<Recipe> after;
+    after.push_back(recipe("Pancakes", { "flour" }));
+    after.push_back(recipe("Pizza", { "flour" }));
+    completer.setCatalog(RecipeCatalog(std::move(after)));
+
+    std::vector<Completion> found = completer.complete("p");
+    EXPECT_EQ(names(found), (std::vector<std::string>{ "Pancakes", "parsley", "Pizza" }));
+    EXPECT_EQ(found[0].score, 3);
+    EXPECT_EQ(found[1].score, 0);
+    EXPECT_EQ(completer.size(), 4);
+
+    completer.addScore("Pasta", CompletionKind::Recipe);   // a name can come back
+    EXPECT_EQ(completer.complete("pas")[0].name, "Pasta");
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/NameCompleterTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -27,4 +27,4 @@ TEST_F(PantryTest, RunningLow) {
     EXPECT_NE(output.find("Salt is running low."), std::string::npos);
 }
 
-//to run: g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Storage.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Pantry.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/PantryTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -lgtest -lgtest_main -o runTests
\ No newline at end of file
+//to run: g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/CivilDate.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/IngredientAliases.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Storage.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Pantry.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/PantryTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -lgtest -lgtest_main -o runTests
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "PersistenceFormat.h"
+#include "Storage.h"
+
+class PersistenceFormatTest : public ::testing::Test {
+protected:
+    json document;
+
+    void SetUp() override {
+        Storage fridge;
+        fridge.addIngredient(Ingredient("milk", 2, "2024-10-10"));
+        fridge.addIngredient(Ingredient("eggs", 12, "2024-10-20"));
+        document["Fridge"] = fridge.toJSON();
+        document["Pantry"] = json::array();
+    }
+
+    void TearDown() override {
+        remove("test_document.bin");
+    }
+};
+
+TEST_F(PersistenceFormatTest, RoundTripsEveryFormat) {
+    for (PersistenceFormat format : { PersistenceFormat::Json, PersistenceFormat::Cbor, PersistenceFormat::MessagePack }) {
+        std::vector<std::uint8_t> bytes = encodeDocument(document, format);
+        EXPECT_EQ(detectFormat(bytes), format) << formatName(format);
+        EXPECT_EQ(decodeDocument(bytes), document) << formatName(format);
+    }
+}
+
+TEST_F(PersistenceFormatTest, DetectsArrays) {
+    json history = json::array({ {{"name", "Pancakes"}, {"date", "2024-10-07"}} });
+    EXPECT_EQ(detectFormat(encodeDocument(history, PersistenceFormat::MessagePack)), PersistenceFormat::MessagePack);
+    EXPECT_EQ(detectFormat(encodeDocument(history, PersistenceFormat::Cbor)), PersistenceFormat::Cbor);
+    EXPECT_EQ(detectFormat(encodeDocument(history, PersistenceFormat::Json)), PersistenceFormat::Json);
+}
+
+TEST_F(PersistenceFormatTest, BinaryFormatsAreSmaller) {
+    std::size_t text = encodeDocument(document, PersistenceFormat::Json).size();
+    EXPECT_LT(encodeDocument(document, PersistenceFormat::Cbor).size(), text);
+    EXPECT_LT(encodeDocument(document, PersistenceFormat::MessagePack).size(), text);
+}
+
+TEST_F(PersistenceFormatTest, ReadsBackWhateverWasWritten) {
+    ASSERT_TRUE(writeDocument("test_document.bin", document, PersistenceFormat::Cbor));
+    json loaded;
+    ASSERT_TRUE(readDocument("test_document.bin", loaded));
+    EXPECT_EQ(loaded["Fridge"][1]["name"], "eggs");
+
+    EXPECT_FALSE(readDocument("missing_document.bin", loaded));
+}
+
+TEST_F(PersistenceFormatTest, ReplacesTheFileWithoutLeavingATempFile) {
+    ASSERT_TRUE(writeDocument("test_document.bin", json::array(), PersistenceFormat::Json));
+    ASSERT_TRUE(writeDocument("test_document.bin", document, PersistenceFormat::MessagePack));
+    json loaded;
+    ASSERT_TRUE(readDocument("test_document.bin", loaded));
+    EXPECT_EQ(loaded, document);
+    EXPECT_FALSE(std::ifstream("test_document.bin.tmp").is_open());
+
+    // A file that cannot be created is reported.
+    EXPECT_FALSE(writeDocument("missing_directory/test_document.bin", document, PersistenceFormat::Json));
+}
+
+TEST_F(PersistenceFormatTest, ParseFormatName) {
+    PersistenceFormat format = PersistenceFormat::Json;
+    EXPECT_TRUE(parseFormatName("MsgPack", format));
+    EXPECT_EQ(format, PersistenceFormat::MessagePack);
+    EXPECT_FALSE(parseFormatName("xml", format));
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/Ingredient.cpp /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/HeaderFiles/Storage.cpp /path/to/project/HeaderFiles/PersistenceFormat.cpp /path/to/project/Tests/PersistenceFormatTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "RecipeCatalog.h"
+#include "RecipeManager.h"
+
+namespace fs = std::filesystem;
+
+// Writes a few recipe shard files (with one recipe duplicated across shards) into a scratch directory.
+class RecipeCatalogTest : public ::testing::Test {
+protected:
+    fs::path shardDir;
+
+    void SetUp() override {
+        shardDir = fs::temp_directory_path() / "recipe_catalog_test";
+        fs::remove_all(shardDir);
+        fs::create_directories(shardDir);
+
+        writeShard("a_shard.json", {"Pancakes", "Omelette"});
+        writeShard("b_shard.json", {"Omelette", "Fried Rice"});
+        writeShard("c_shard.json", {"Brownies"});
+        std::ofstream(shardDir / "notes.txt") << "not a recipe file";
+    }
+
+    void TearDown() override {
+        fs::remove_all(shardDir);
+    }
+
+    void writeShard(const std::string& filename, const std::vector<std::string>& names) {
+        json j;
+        j["recipes"] = json::array();
+        for (const auto& name : names) {
+            j["recipes"].push_back({
+                {"name", name},
+                {"category", "Savory"},
+                {"ingredients", {{{"name", "egg"}, {"quantity", "2"}, {"unit", ""}}}},
+                {"condiments", json::array()},
+                {"steps", {"Cook " + name}}
+            });
+        }
+        std::ofstream(shardDir / filename) << j.dump();
+    }
+};
+
+TEST_F(RecipeCatalogTest, FindShardsInDirectory) {
+    auto shards = findRecipeShards(shardDir.string());
+    ASSERT_EQ(shards.size(), 3); // notes.txt is ignored
+    EXPECT_EQ(fs::path(shards[0]).filename(), "a_shard.json");
+    EXPECT_EQ(fs::path(shards[2]).filename(), "c_shard.json");
+}
+
+TEST_F(RecipeCatalogTest, FindShardsWithPattern) {
+    auto shards = findRecipeShards((shardDir / "b_*.json").string());
+    ASSERT_EQ(shards.size(), 1);
+    EXPECT_EQ(fs::path(shards[0]).filename(), "b_shard.json");
+}
+
+TEST_F(RecipeCatalogTest, MergesAndDeduplicatesShards) {
+    RecipeCatalog catalog = loadRecipeCatalog(shardDir.string(), 4);
+
+    ASSERT_EQ(catalog.size(), 4); // Omelette appears in two shards but is kept once
+    EXPECT_EQ(catalog.getRecipes()[0].getRecipeName(), "Pancakes");
+    EXPECT_EQ(catalog.getRecipes()[1].getRecipeName(), "Omelette");
+    EXPECT_EQ(catalog.getRecipes()[2].getRecipeName(), "Fried Rice");
+    EXPECT_EQ(catalog.getRecipes()[3].getRecipeName(), "Brownies");
+}
+
+TEST_F(RecipeCatalogTest, ThreadCountDoesNotChangeResult) {
+    RecipeCatalog serial = loadRecipeCatalog(shardDir.string(), 1);
+    RecipeCatalog parallel = loadRecipeCatalog(shardDir.string(), 8);
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial.getRecipes()[i].getRecipeName(), parallel.getRecipes()[i].getRecipeName());
+    }
+}
+
+TEST_F(RecipeCatalogTest, MalformedShardIsSkipped) {
+    std::ofstream(shardDir / "d_broken.json") << "{ \"recipes\": [ ";
+    RecipeCatalog catalog = loadRecipeCatalog(shardDir.string(), 2);
+    EXPECT_EQ(catalog.size(), 4);
+}
+
+TEST_F(RecipeCatalogTest, SingleFileSource) {
+    RecipeCatalog catalog = loadRecipeCatalog((shardDir / "c_shard.json").string());
+    ASSERT_EQ(catalog.size(), 1);
+    EXPECT_EQ(catalog.getRecipes()[0].getRecipeName(), "Brownies");
+}
+
+TEST_F(RecipeCatalogTest, LookupByNameAndId) {
+    RecipeCatalog catalog = loadRecipeCatalog(shardDir.string());
+    std::size_t id = catalog.idOf("Fried Rice");
+    ASSERT_NE(id, RecipeCatalog::npos);
+    EXPECT_EQ(catalog.findById(id)->getRecipeName(), "Fried Rice");
+    EXPECT_EQ(catalog.findByName("Brownies"), &catalog.getRecipes()[catalog.idOf("Brownies")]);
+    EXPECT_EQ(catalog.idOf("Lasagna"), RecipeCatalog::npos);
+    EXPECT_EQ(catalog.findById(catalog.size()), nullptr);
+    EXPECT_EQ(RecipeCatalog().idOf("Brownies"), RecipeCatalog::npos);
+}
+
+TEST_F(RecipeCatalogTest, LookupInLargeCatalog) {
+    std::vector<Recipe> recipes;
+    for (int i = 0; i < 5000; ++i) {
+        recipes.emplace_back("Recipe " + std::to_string(i), std::vector<std::pair<std::string, std::string>>{},
+                             std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Sweet");
+    }
+    recipes.emplace_back("Recipe 42", std::vector<std::pair<std::string, std::string>>{},
+                         std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Savory");
+    RecipeCatalog catalog(std::move(recipes));
+
+    ASSERT_EQ(catalog.size(), 5000);
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(catalog.idOf("Recipe " + std::to_string(i)), static_cast<std::size_t>(i));
+    }
+    EXPECT_EQ(catalog.findByName("Recipe 42")->getType(), "Sweet");
+}
+
+TEST_F(RecipeCatalogTest, ResolveHistoryEntries) {
+    RecipeCatalog catalog = loadRecipeCatalog(shardDir.string());
+    std::size_t brownies = catalog.idOf("Brownies");
+
+    EXPECT_EQ(findHistoryRecipe(catalog, {{"name", "Brownies"}, {"id", brownies}}), catalog.findById(brownies));
+    // A stale id (the catalog changed since the entry was written) falls back to the name.
+    EXPECT_EQ(findHistoryRecipe(catalog, {{"name", "Brownies"}, {"id", 0}}), catalog.findById(brownies));
+    // Entries written before ids were recorded.
+    EXPECT_EQ(findHistoryRecipe(catalog, {{"name", "Pancakes"}, {"date", "2024-10-07"}}), catalog.findByName("Pancakes"));
+    EXPECT_EQ(findHistoryRecipe(catalog, {{"name", "Lasagna"}}), nullptr);
+    EXPECT_EQ(findHistoryRecipe(catalog, {{"date", "2024-10-07"}}), nullptr);
+}
+
+TEST_F(RecipeCatalogTest, PartitionsByCategory) {
+    auto recipe = [](const std::string& name, const std::string& category) {
+        return Recipe(name, { {"egg", "1"} }, {}, {}, category);
+    };
+    std::vector<Recipe> recipes;
+    recipes.push_back(recipe("Tacos", "Savory"));
+    recipes.push_back(recipe("Carbonara", "Italian"));
+    recipes.push_back(recipe("Cookies", "sweet"));
+    recipes.push_back(recipe("Omelette", "SAVORY"));
+    recipes.push_back(recipe("Tiramisu", "italian"));
+    RecipeCatalog catalog(std::move(recipes));
+
+    EXPECT_EQ(catalog.getCategories().find("Italian"), toId(Category::FirstCustom));
+    EXPECT_EQ(catalog.getCategories().find("Mexican"), CategoryRegistry::kUnknown);
+
+    RecipeCatalog::Partition savory = catalog.getPartition(toId(Category::Savory));
+    ASSERT_EQ(savory.end - savory.begin, 2);
+    EXPECT_EQ(catalog.getRecipes()[savory.begin].getRecipeName(), "Tacos");
+    EXPECT_EQ(catalog.getRecipes()[savory.begin + 1].getRecipeName(), "Omelette");
+    EXPECT_EQ(catalog.getCategoryId(savory.begin), toId(Category::Savory));
+
+    RecipeCatalog::Partition sweet = catalog.getPartition(toId(Category::Sweet));
+    EXPECT_EQ(sweet.begin, 0);
+    EXPECT_EQ(sweet.end, 1);
+
+    // Name lookups still work after recipes were regrouped.
+    EXPECT_EQ(catalog.findByName("Tiramisu")->getType(), "italian");
+
+    std::vector<Ingredient> eggs = { Ingredient("egg", 6, "") };
+    EXPECT_EQ(catalog.findMakeable(eggs, "ITALIAN").size(), 2);
+    EXPECT_EQ(catalog.findMakeable(eggs, toId(Category::Sweet)).size(), 1);
+    EXPECT_EQ(catalog.findMakeable(eggs).size(), 5);
+    EXPECT_TRUE(catalog.findMakeable(eggs, "Mexican").empty());
+}
+
+TEST_F(RecipeCatalogTest, IngredientIndex) {
+    std::vector<Recipe> recipes;
+    recipes.emplace_back("Omelette", std::vector<std::pair<std::string, std::string>>{ {"Egg", "2"}, {"cheese", "1"}, {"egg", "1"} },
+                         std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Savory");
+    recipes.emplace_back("Cheese Toast", std::vector<std::pair<std::string, std::string>>{ {"bread", "2"}, {"Cheese", "1"} },
+                         std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Savory");
+    RecipeCatalog catalog(std::move(recipes));
+
+    ASSERT_EQ(catalog.ingredientCount(), 3);
+    IngredientId cheese = catalog.findIngredient("CHEESE");
+    ASSERT_NE(cheese, RecipeCatalog::kNoIngredient);
+    EXPECT_EQ(catalog.getIngredientName(cheese), "cheese");
+    EXPECT_EQ(std::vector<std::uint32_t>(catalog.getRecipesUsing(cheese).begin(), catalog.getRecipesUsing(cheese).end()),
+              (std::vector<std::uint32_t>{ 0, 1 }));
+    EXPECT_EQ(catalog.getRecipesUsing(catalog.findIngredient("egg")).size(), 1); // listed twice, indexed once
+    EXPECT_EQ(catalog.getRecipeIngredients(0).size(), 3);
+    EXPECT_EQ(catalog.findIngredient("saffron"), RecipeCatalog::kNoIngredient);
+    EXPECT_TRUE(catalog.getRecipesUsing(RecipeCatalog::kNoIngredient).empty());
+}
+
+TEST_F(RecipeCatalogTest, TimeIndex) {
+    std::vector<Recipe> recipes;
+    auto add = [&](const std::string& name, int minutes, const std::string& ingredient) {
+        recipes.emplace_back(name, std::vector<std::pair<std::string, std::string>>{ {ingredient, "1"} },
+                             std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, "Savory", minutes);
+    };
+    add("Stew", 90, "beef");
+    add("Toast", 5, "bread");
+    add("Soup", 30, "carrots");
+    add("Salad", 5, "lettuce");
+    add("Bread", -1, "flour");
+    RecipeCatalog catalog(std::move(recipes));
+
+    auto names = [&](IdRange ids) {
+        std::vector<std::string> found;
+        for (std::uint32_t id : ids) {
+            found.push_back(catalog.getRecipes()[id].getRecipeName());
+        }
+        return found;
+    };
+    EXPECT_EQ(names(catalog.getRecipesByTime(0, 30)), (std::vector<std::string>{ "Toast", "Salad", "Soup" }));
+    EXPECT_EQ(names(catalog.getRecipesByTime(6, 1000)), (std::vector<std::string>{ "Soup", "Stew" }));
+    EXPECT_TRUE(catalog.getRecipesByTime(31, 89).empty());
+    EXPECT_TRUE(catalog.getRecipesByTime(-1, -1).empty());
+
+    std::vector<Ingredient> have = { Ingredient("Bread", 1, ""), Ingredient("beef", 1, ""), Ingredient("carrots", 1, ""), Ingredient("flour", 1, "") };
+    std::vector<const Recipe*> quick = catalog.findMakeableWithin(have, 30);
+    ASSERT_EQ(quick.size(), 2);
+    EXPECT_EQ(quick[0]->getRecipeName(), "Toast");
+    EXPECT_EQ(quick[1]->getRecipeName(), "Soup");
+}
+
+TEST_F(RecipeCatalogTest, LoadsTimesFromRecipeFile) {
+    json j;
+    j["recipes"] = json::array();
+    for (const auto& [name, time] : std::vector<std::pair<std::string, std::string>>{ {"Stew", "1 hour 30 minutes"}, {"Toast", "5 minutes"}, {"Bread", ""} }) {
+        json recipe = { {"name", name}, {"category", "Savory"}, {"ingredients", json::array()}, {"condiments", json::array()}, {"steps", json::array()} };
+        if (!time.empty()) {
+            recipe["time"] = time;
+        }
+        j["recipes"].push_back(recipe);
+    }
+    std::ofstream(shardDir / "timed.json") << j.dump();
+
+    RecipeCatalog catalog = loadRecipeCatalog((shardDir / "timed.json").string());
+    EXPECT_EQ(catalog.findByName("Stew")->getTimeMinutes(), 90);
+    EXPECT_EQ(catalog.findByName("Toast")->getTimeMinutes(), 5);
+    EXPECT_EQ(catalog.findByName("Bread")->getTimeMinutes(), -1);
+    EXPECT_EQ(catalog.getRecipesByTime(0, 100).size(), 2);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/RecipeCatalogTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "RecipeCatalog.h"
+#include "RecipeDeduplication.h"
+#include "TestRecipes.h"
+
+namespace fs = std::filesystem;
+
+TEST(RecipeDeduplicationTest, NormalizesNames) {
+    EXPECT_EQ(RecipeDeduplicator::normalizedName("The Best Pancakes!"), "pancake");
+    EXPECT_EQ(RecipeDeduplicator::normalizedName("Mac & Cheese"), RecipeDeduplicator::normalizedName("mac and cheese"));
+    EXPECT_EQ(RecipeDeduplicator::normalizedName("Curry, Chicken"), "chicken curry");
+    EXPECT_NE(RecipeDeduplicator::normalizedName("Apple Pie"), RecipeDeduplicator::normalizedName("Apple Crumble"));
+}
+
+TEST(RecipeDeduplicationTest, MergesExactDuplicates) {
+    RecipeDeduplicator deduplicator;
+    EXPECT_TRUE(deduplicator.add(makeRecipe("Pancakes", { "flour", "milk", "eggs" }, "Sweet")));
+    // Same category, ingredients up to aliases and order, and name up to filler words.
+    EXPECT_FALSE(deduplicator.add(makeRecipe("Easy pancakes", { "Egg", "milk", "flour", "milk" }, "sweet", 20)));
+    EXPECT_TRUE(deduplicator.add(makeRecipe("Pancakes", { "flour", "milk", "eggs" }, "Savory")));
+    EXPECT_TRUE(deduplicator.add(makeRecipe("Crepes", { "flour", "milk", "eggs" }, "Sweet")));
+
+    const DedupReport& report = deduplicator.getReport();
+    EXPECT_EQ(report.recipes, 4);
+    ASSERT_EQ(report.merged.size(), 1);
+    EXPECT_EQ(report.merged[0].name, "Easy pancakes");
+    EXPECT_EQ(report.merged[0].duplicateOf, "Pancakes");
+
+    std::vector<Recipe> recipes = deduplicator.release();
+    ASSERT_EQ(recipes.size(), 3);
+    EXPECT_EQ(recipes[0].getTimeMinutes(), 20);   // filled in from the duplicate
+    EXPECT_EQ(recipes[1].getType(), "Savory");
+}
+
+TEST(RecipeDeduplicationTest, FlagsNearDuplicates) {
+    RecipeDeduplicator deduplicator;
+    deduplicator.add(makeRecipe("Pancakes", { "flour", "milk", "egg", "butter", "sugar" }, "Sweet"));
+    deduplicator.add(makeRecipe("Fluffy Pancakes", { "flour", "milk", "egg", "butter", "sugar", "baking powder" }, "Sweet"));
+    deduplicator.add(makeRecipe("Crepes", { "flour", "milk", "egg", "butter" }, "Sweet"));
+    deduplicator.add(makeRecipe("Savory Pancakes", { "flour", "milk", "egg", "butter", "sugar" }, "Savory"));
+
+    const DedupReport& report = deduplicator.getReport();
+    EXPECT_TRUE(report.merged.empty());
+    ASSERT_EQ(report.nearDuplicates.size(), 1);   // not Crepes (4/7), not another category
+    EXPECT_EQ(report.nearDuplicates[0].name, "Fluffy Pancakes");
+    EXPECT_EQ(report.nearDuplicates[0].duplicateOf, "Pancakes");
+    EXPECT_FLOAT_EQ(report.nearDuplicates[0].similarity, 6.0f / 8.0f);
+    EXPECT_EQ(deduplicator.release().size(), 4);
+}
+
+TEST(RecipeDeduplicationTest, CatalogLoadMergesAcrossShards) {
+    fs::path dir = fs::temp_directory_path() / "recipe_dedup_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto recipe = [](const std::string& name) {
+        return json{ {"name", name}, {"category", "Sweet"}, {"condiments", json::array()}, {"steps", json::array()},
+                     {"ingredients", json::array({ { {"name", "apple"}, {"quantity", "2"}, {"unit", ""} },
+                                                   { {"name", "flour"}, {"quantity", "1"}, {"unit", "cup"} } })} };
+    };
+    std::ofstream((dir / "a.json").string()) << json{ {"recipes", json::array({ recipe("Apple Pie") })} }.dump();
+    std::ofstream((dir / "b.json").string()) << json{ {"recipes", json::array({ recipe("apple pie (classic)"), recipe("Apple Cake") })} }.dump();
+
+    DedupReport report;
+    RecipeCatalog catalog = loadRecipeCatalog(dir.string(), 2, &report);
+    EXPECT_EQ(catalog.size(), 2);
+    EXPECT_NE(catalog.findByName("Apple Pie"), nullptr);
+    EXPECT_EQ(catalog.findByName("apple pie (classic)"), nullptr);
+    ASSERT_EQ(report.merged.size(), 1);
+    fs::remove_all(dir);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/RecipeDeduplicationTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
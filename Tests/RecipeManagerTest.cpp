@@ -108,4 +108,4 @@ TEST_F(RecipeManagerTest, SaveHistory) {
     EXPECT_EQ(history[0]["name"], "Test Recipe");
 }
 */
-//to run: g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/RecipeManager.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Fridge.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Pantry.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Recipe.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Storage.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/RecipeManagerTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project- -lgtest -lgtest_main -o runRecipeManagerTests
\ No newline at end of file
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/RecipeManagerTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
\ No newline at end of file
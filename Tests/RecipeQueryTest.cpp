@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "RecipeQuery.h"
+#include "TestRecipes.h"
+
+class RecipeQueryTest : public ::testing::Test {
+protected:
+    RecipeCatalog catalog{ {
+        makeRecipe("Omelette", { "egg", "cheese" }, "Savory", 10),
+        makeRecipe("Beef Tacos", { "ground beef", "taco shells", "cheese" }, "Savory", 20),
+        makeRecipe("Beef Stew", { "ground beef", "carrots", "potato" }, "Savory", 90),
+        makeRecipe("Pancakes", { "egg", "flour", "milk" }, "Sweet", 25),
+        makeRecipe("Fruit Salad", { "apple", "banana" }, "Sweet", 5),
+        makeRecipe("Carrot Cake", { "carrots", "flour", "egg" }, "Sweet", 60),
+        makeRecipe("Mystery Dish", { "egg" }),
+    } };
+    QueryContext context;
+
+    void SetUp() override {
+        context.inventory = { Ingredient("Egg", 6, ""), Ingredient("cheese", 1, ""), Ingredient("flour", 2, ""),
+                              Ingredient("milk", 1, ""), Ingredient("carrots", 3, "") };
+        context.expiringItems = { "milk" };
+    }
+
+    std::vector<std::string> run(const RecipeQuery& query, RecipeQueryEngine::Plan* plan = nullptr) {
+        std::vector<std::string> names;
+        for (std::size_t id : RecipeQueryEngine(catalog).execute(query, context, plan)) {
+            names.push_back(catalog.getRecipes()[id].getRecipeName());
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+};
+
+TEST_F(RecipeQueryTest, CategoryUsesPartition) {
+    RecipeQueryEngine::Plan plan;
+    auto names = run(RecipeQuery::allOf({ RecipeQuery::inCategory("sweet"), RecipeQuery::readyWithin(30) }), &plan);
+    EXPECT_EQ(names, (std::vector<std::string>{ "Fruit Salad", "Pancakes" }));
+    EXPECT_EQ(plan.path, RecipeQueryEngine::AccessPath::CategoryPartition);
+    EXPECT_EQ(plan.candidates, 3);
+}
+
+TEST_F(RecipeQueryTest, RareIngredientBeatsCategory) {
+    RecipeQueryEngine::Plan plan;
+    auto names = run(RecipeQuery::allOf({ RecipeQuery::inCategory("Savory"), RecipeQuery::withIngredient("Ground Beef"),
+                                          RecipeQuery::withoutIngredient("potato") }), &plan);
+    EXPECT_EQ(names, std::vector<std::string>{ "Beef Tacos" });
+    EXPECT_EQ(plan.path, RecipeQueryEngine::AccessPath::IngredientPostings);
+    EXPECT_EQ(plan.candidates, 2);
+}
+
+TEST_F(RecipeQueryTest, MakeableWithUnknownTimeExcluded) {
+    EXPECT_EQ(run(RecipeQuery::makeable()), (std::vector<std::string>{ "Carrot Cake", "Mystery Dish", "Omelette", "Pancakes" }));
+    EXPECT_EQ(run(RecipeQuery::allOf({ RecipeQuery::makeable(), RecipeQuery::readyWithin(30) })),
+              (std::vector<std::string>{ "Omelette", "Pancakes" }));
+}
+
+TEST_F(RecipeQueryTest, ExpiringItemsAccessPath) {
+    RecipeQueryEngine::Plan plan;
+    auto names = run(RecipeQuery::allOf({ RecipeQuery::usesExpiringItems(), RecipeQuery::makeable() }), &plan);
+    EXPECT_EQ(names, std::vector<std::string>{ "Pancakes" });
+    EXPECT_EQ(plan.path, RecipeQueryEngine::AccessPath::ExpiringPostings);
+    EXPECT_EQ(plan.candidates, 1);
+}
+
+TEST_F(RecipeQueryTest, OrAndNotFallBackToScan) {
+    RecipeQueryEngine::Plan plan;
+    auto names = run(RecipeQuery::anyOf({ RecipeQuery::withIngredient("apple"), RecipeQuery::negate(RecipeQuery::readyWithin(60)) }), &plan);
+    EXPECT_EQ(names, (std::vector<std::string>{ "Beef Stew", "Fruit Salad", "Mystery Dish" }));
+    EXPECT_EQ(plan.path, RecipeQueryEngine::AccessPath::FullScan);
+}
+
+TEST_F(RecipeQueryTest, TimeLimitUsesTimeIndex) {
+    RecipeQueryEngine::Plan plan;
+    auto names = run(RecipeQuery::allOf({ RecipeQuery::readyWithin(10), RecipeQuery::makeable() }), &plan);
+    EXPECT_EQ(names, std::vector<std::string>{ "Omelette" });
+    EXPECT_EQ(plan.path, RecipeQueryEngine::AccessPath::TimeRange);
+    EXPECT_EQ(plan.candidates, 2);
+}
+
+TEST_F(RecipeQueryTest, UnknownNamesMatchNothing) {
+    RecipeQueryEngine::Plan plan;
+    EXPECT_TRUE(run(RecipeQuery::withIngredient("saffron"), &plan).empty());
+    EXPECT_EQ(plan.candidates, 0);
+    EXPECT_TRUE(run(RecipeQuery::inCategory("Thai")).empty());
+    EXPECT_EQ(run(RecipeQuery::allOf({ RecipeQuery::withoutIngredient("saffron"), RecipeQuery::inCategory("Sweet") })).size(), 3);
+}
+
+TEST_F(RecipeQueryTest, EstimatesComeFromStatistics) {
+    RecipeQueryEngine::Plan plan = RecipeQueryEngine(catalog).plan(
+        RecipeQuery::allOf({ RecipeQuery::inCategory("Sweet"), RecipeQuery::withIngredient("egg") }), context);
+    // 3/7 sweet * 4/7 with egg * 7 recipes
+    EXPECT_NEAR(plan.estimatedMatches, 3.0 * 4.0 / 7.0, 1e-9);
+    EXPECT_FALSE(plan.description.empty());
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/RecipeQueryTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
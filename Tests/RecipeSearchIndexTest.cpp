@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "RecipeSearchIndex.h"
+#include "RecipeCatalog.h"
+
+class RecipeSearchIndexTest : public ::testing::Test {
+protected:
+    std::vector<Recipe> recipes;
+
+    void SetUp() override {
+        addRecipe("Chocolate Chip Cookies", { "Cream butter and sugar", "Fold in chocolate chips", "Bake until golden" }, { "vanilla extract" });
+        addRecipe("Beef Tacos", { "Brown the beef", "Fill the taco shells" }, { "chili powder" });
+        addRecipe("Chocolate Mousse", { "Melt the chocolate", "Fold in whipped cream", "Chill" }, { "sugar" });
+        addRecipe("Garden Salad", { "Chop the lettuce", "Toss with dressing" }, { "olive oil", "salt" });
+    }
+
+    void addRecipe(const std::string& name, std::vector<std::string> steps, const std::vector<std::string>& condimentNames) {
+        std::vector<std::pair<std::string, std::string>> condiments;
+        for (const auto& condiment : condimentNames) {
+            condiments.push_back({ condiment, "1 tsp" });
+        }
+        recipes.emplace_back(name, std::vector<std::pair<std::string, std::string>>{}, condiments, steps, "Sweet");
+    }
+};
+
+TEST_F(RecipeSearchIndexTest, Tokenize) {
+    EXPECT_EQ(RecipeSearchIndex::tokenize("Preheat oven to 350°F!"), (std::vector<std::string>{ "preheat", "oven", "to", "350", "f" }));
+}
+
+TEST_F(RecipeSearchIndexTest, RanksNameMatchesFirst) {
+    RecipeSearchIndex index(recipes);
+    auto results = index.search("chocolate ");
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_TRUE(results[0].recipeId == 0 || results[0].recipeId == 2);
+    EXPECT_GT(results[0].score, 0);
+
+    results = index.search("chocolate mousse ");
+    ASSERT_FALSE(results.empty());
+    EXPECT_EQ(results[0].recipeId, 2);
+}
+
+TEST_F(RecipeSearchIndexTest, LastWordIsPrefix) {
+    RecipeSearchIndex index(recipes);
+    auto results = index.search("shel");
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].recipeId, 1);
+
+    EXPECT_TRUE(index.search("shel ").empty()); // a finished word is not expanded
+}
+
+TEST_F(RecipeSearchIndexTest, ToleratesTypos) {
+    RecipeSearchIndex index(recipes);
+    auto results = index.search("lettuse salad");
+    ASSERT_FALSE(results.empty());
+    EXPECT_EQ(results[0].recipeId, 3);
+}
+
+TEST_F(RecipeSearchIndexTest, SearchesStepsAndCondiments) {
+    RecipeSearchIndex index(recipes);
+    auto results = index.search("vanilla ");
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].recipeId, 0);
+}
+
+TEST_F(RecipeSearchIndexTest, CompleteAndSimilarTerms) {
+    RecipeSearchIndex index(recipes);
+    EXPECT_EQ(index.completeTerm("cho", 5), (std::vector<std::string>{ "chocolate", "chop" }));
+    auto similar = index.similarTerms("choclate");
+    ASSERT_FALSE(similar.empty());
+    EXPECT_EQ(similar[0], "chocolate");
+    EXPECT_GT(index.postingBytes(), 0);
+}
+
+TEST_F(RecipeSearchIndexTest, IndexedSimilarTermsMatchLinearScan) {
+    recipes.clear();
+    std::mt19937 random(7);
+    std::vector<std::string> words;
+    for (int r = 0; r < 300; ++r) {
+        std::vector<std::string> steps;
+        for (int w = 0; w < 10; ++w) {
+            std::string word(3 + random() % 8, 'a');
+            for (auto& c : word) c = static_cast<char>('a' + random() % 8);
+            words.push_back(word);
+            steps.push_back(word);
+        }
+        addRecipe("", steps, {});
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    RecipeSearchIndex index(recipes);
+    for (int q = 0; q < 200; ++q) {
+        std::string query = words[random() % words.size()];
+        query[random() % query.size()] = 'z';
+        for (std::size_t maxDistance = 1; maxDistance <= 3; ++maxDistance) {
+            std::vector<std::string> expected;
+            for (std::size_t distance = 0; distance <= maxDistance; ++distance) {
+                for (const auto& word : words) {
+                    if (boundedEditDistance(query, word, maxDistance) == distance) {
+                        expected.push_back(word);
+                    }
+                }
+            }
+            expected.resize(std::min<std::size_t>(expected.size(), 64));
+            ASSERT_EQ(index.similarTerms(query, maxDistance), expected) << query;
+        }
+    }
+}
+
+TEST_F(RecipeSearchIndexTest, CatalogBuildsIndexAtLoad) {
+    RecipeCatalog catalog(recipes);
+    auto found = catalog.search("garden", 5);
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0]->getRecipeName(), "Garden Salad");
+    EXPECT_EQ(boundedEditDistance("kitten", "sitting", 5), 3);
+    EXPECT_EQ(boundedEditDistance("kitten", "sitting", 1), 2);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/Ingredient.cpp /path/to/project/HeaderFiles/CivilDate.cpp /path/to/project/HeaderFiles/IngredientAliases.cpp /path/to/project/HeaderFiles/Recipe.cpp /path/to/project/HeaderFiles/RecipeSearchIndex.cpp /path/to/project/HeaderFiles/EditDistance.cpp /path/to/project/HeaderFiles/RecipeCatalog.cpp /path/to/project/Tests/RecipeSearchIndexTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
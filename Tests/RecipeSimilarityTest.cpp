@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <random>
+#include "RecipeManager.h"
+#include "RecipeSimilarity.h"
+#include "TestRecipes.h"
+
+namespace fs = std::filesystem;
+
+class RecipeSimilarityTest : public ::testing::Test {
+protected:
+    std::shared_ptr<const RecipeCatalog> catalog;
+
+    void SetUp() override {
+        std::vector<Recipe> recipes;
+        recipes.push_back(makeRecipe("Pancakes", { "flour", "milk", "egg", "butter", "sugar" }));
+        recipes.push_back(makeRecipe("Crepes", { "flour", "milk", "eggs", "butter" }));
+        recipes.push_back(makeRecipe("Waffles", { "flour", "milk", "egg", "butter", "baking powder" }));
+        recipes.push_back(makeRecipe("Omelette", { "egg", "butter", "cheese" }));
+        recipes.push_back(makeRecipe("Salad", { "lettuce", "tomato", "olive oil" }));
+        recipes.push_back(makeRecipe("Water", {}));
+        catalog = std::make_shared<const RecipeCatalog>(std::move(recipes));
+    }
+
+    std::vector<std::string> names(const std::vector<RecipeSimilarityIndex::Similar>& found) {
+        std::vector<std::string> result;
+        for (const auto& similar : found) {
+            result.push_back(catalog->getRecipes()[similar.recipeId].getRecipeName());
+        }
+        return result;
+    }
+};
+
+TEST_F(RecipeSimilarityTest, RanksByJaccardSimilarity) {
+    // Many bands of one row make every recipe sharing an ingredient a candidate.
+    SimilarityOptions options;
+    options.bands = 64;
+    options.rows = 1;
+    RecipeSimilarityIndex index(catalog, options);
+
+    std::vector<RecipeSimilarityIndex::Similar> found = index.similarTo(catalog->idOf("Pancakes"));
+    EXPECT_EQ(names(found), (std::vector<std::string>{ "Crepes", "Waffles", "Omelette" }));   // 4/5 each, then 2/6
+    EXPECT_FLOAT_EQ(found[0].similarity, 0.8f);
+    EXPECT_FLOAT_EQ(found[2].similarity, 2.0f / 6.0f);
+    EXPECT_FLOAT_EQ(index.jaccard(catalog->idOf("Pancakes"), catalog->idOf("Omelette")), 2.0f / 6.0f);
+    EXPECT_FLOAT_EQ(index.jaccard(catalog->idOf("Pancakes"), catalog->idOf("Salad")), 0.0f);
+}
+
+TEST_F(RecipeSimilarityTest, LeavesOutUnrelatedAndEmptyRecipes) {
+    RecipeSimilarityIndex index(catalog);
+    EXPECT_TRUE(index.similarTo(catalog->idOf("Salad")).empty());
+    EXPECT_TRUE(index.similarTo(catalog->idOf("Water")).empty());
+    EXPECT_EQ(names(index.similarTo(catalog->idOf("Crepes"), 1)), (std::vector<std::string>{ "Pancakes" }));
+}
+
+TEST_F(RecipeSimilarityTest, SimilarToAnyExcludesTheGivenRecipes) {
+    SimilarityOptions options;
+    options.bands = 64;
+    options.rows = 1;
+    RecipeSimilarityIndex index(catalog, options);
+
+    std::vector<RecipeSimilarityIndex::Similar> found = index.similarToAny({ catalog->idOf("Pancakes"), catalog->idOf("Crepes") });
+    EXPECT_EQ(names(found), (std::vector<std::string>{ "Waffles", "Omelette" }));
+    EXPECT_FLOAT_EQ(found[0].similarity, 0.8f);   // its best match, Pancakes
+
+    std::vector<IngredientId> ingredients = { catalog->findIngredient("tomato"), catalog->findIngredient("lettuce"),
+                                              catalog->findIngredient("unknown") };
+    EXPECT_EQ(names(index.similarToIngredients(ingredients)), (std::vector<std::string>{ "Salad" }));
+}
+
+TEST(RecipeSimilarityRecallTest, FindsMostOfTheTrueTopResults) {
+    // Clusters of recipes drawn around a few base ingredient sets, like variations of a dish.
+    std::mt19937 random(7);
+    std::vector<Recipe> recipes;
+    for (int cluster = 0; cluster < 50; ++cluster) {
+        std::vector<std::string> base;
+        for (int i = 0; i < 8; ++i) {
+            base.push_back("ingredient " + std::to_string(random() % 400));
+        }
+        for (int variant = 0; variant < 10; ++variant) {
+            std::vector<std::string> ingredients;
+            for (const auto& name : base) {
+                if (random() % 5 != 0) {
+                    ingredients.push_back(name);
+                }
+            }
+            ingredients.push_back("ingredient " + std::to_string(random() % 400));
+            recipes.push_back(makeRecipe("Recipe " + std::to_string(recipes.size()), ingredients));
+        }
+    }
+    auto catalog = std::make_shared<const RecipeCatalog>(std::move(recipes));
+    RecipeSimilarityIndex index(catalog);
+
+    std::size_t found = 0;
+    std::size_t expected = 0;
+    for (std::size_t query = 0; query < catalog->size(); query += 7) {
+        // Brute force: the similarity of the 5th best recipe, and how many reach it.
+        std::vector<float> all;
+        for (std::size_t other = 0; other < catalog->size(); ++other) {
+            if (other != query) {
+                all.push_back(index.jaccard(query, other));
+            }
+        }
+        std::sort(all.rbegin(), all.rend());
+        float threshold = all[4];
+        for (const auto& similar : index.similarTo(query, 5)) {
+            EXPECT_FLOAT_EQ(similar.similarity, index.jaccard(query, similar.recipeId));
+            found += similar.similarity >= threshold ? 1 : 0;
+        }
+        expected += 5;
+    }
+    EXPECT_GE(static_cast<double>(found) / expected, 0.9);
+}
+
+TEST(RecipeSimilarityManagerTest, SuggestsFromRecentHistory) {
+    fs::path dir = fs::temp_directory_path() / "recipe_similarity_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::string recipes = (dir / "recipes.json").string();
+    auto recipe = [](const std::string& name, const std::vector<std::string>& ingredients) {
+        json entry = { {"name", name}, {"category", "Savory"}, {"ingredients", json::array()}, {"condiments", json::array()},
+                       {"steps", json::array()} };
+        for (const auto& ingredient : ingredients) {
+            entry["ingredients"].push_back({ {"name", ingredient}, {"quantity", "1"}, {"unit", ""} });
+        }
+        return entry;
+    };
+    json r;
+    r["recipes"] = json::array({ recipe("Toast", { "bread", "butter" }), recipe("French Toast", { "bread", "butter", "egg", "milk" }),
+                                 recipe("Salad", { "lettuce", "tomato" }), recipe("Tomato Soup", { "tomato", "onion", "stock" }) });
+    std::ofstream(recipes) << r.dump();
+    json s;
+    s["Fridge"] = json::array();
+    s["Pantry"] = json::array({ Ingredient("bread", 4, "").toJSON(), Ingredient("butter", 1, "").toJSON(),
+                                Ingredient("lettuce", 1, "").toJSON(), Ingredient("tomato", 1, "").toJSON() });
+    std::ofstream((dir / "storage.json").string()) << s.dump();
+
+    {
+        RecipeManager manager(recipes, (dir / "storage.json").string(), (dir / "history.json").string());
+        EXPECT_EQ(manager.similarRecipes("Toast"), (std::vector<std::string>{ "French Toast" }));
+        EXPECT_TRUE(manager.suggestFromHistory().empty());
+        ASSERT_EQ(manager.cookAll({ "Salad", "Toast" }), 2);
+        EXPECT_EQ(manager.suggestFromHistory(), (std::vector<std::string>{ "French Toast", "Tomato Soup" }));
+        EXPECT_EQ(manager.suggestFromHistory(1), (std::vector<std::string>{ "French Toast" }));   // Toast is the latest
+    }
+    fs::remove_all(dir);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/RecipeSimilarityTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -42,6 +42,14 @@ TEST_F(RecipeTest, MissingIngredients) {
     EXPECT_EQ(missingIngredients[0], "Sugar");
 }
 
+TEST(RecipeAliasTest, CanMakeRecipeMatchesAliases) {
+    Recipe omelette("Omelette", { {"Eggs", "2"}, {"Cheddar Cheese", "50 g"}, {"Scallions", "1"} }, {}, {}, "Savory");
+    std::vector<Ingredient> stock = { Ingredient("egg", 6, ""), Ingredient("cheese", 1, ""), Ingredient("green onion", 2, "") };
+    std::vector<std::string> missingIngredients;
+    EXPECT_TRUE(omelette.canMakeRecipe(stock, missingIngredients));
+    EXPECT_TRUE(missingIngredients.empty());
+}
+
 TEST_F(RecipeTest, GetRequiredIngredients) {
     auto ingredients = recipe->getRequiredIngredients();
     EXPECT_EQ(ingredients.size(), 2);
@@ -55,3 +63,49 @@ TEST_F(RecipeTest, GetSteps) {
     EXPECT_EQ(steps[0], "Mix ingredients");
     EXPECT_EQ(steps[1], "Bake at 350F");
 }
+
+TEST(RecipeTimeTest, ParseMinutes) {
+    EXPECT_EQ(parseMinutes("25 minutes"), 25);
+    EXPECT_EQ(parseMinutes("1 hour"), 60);
+    EXPECT_EQ(parseMinutes("1 hour 30 minutes"), 90);
+    EXPECT_EQ(parseMinutes("2h"), 120);
+    EXPECT_EQ(parseMinutes("1.5 hours"), 90);
+    EXPECT_EQ(parseMinutes("1 1/2 hours"), 90);
+    EXPECT_EQ(parseMinutes("1/2 hour"), 30);
+    EXPECT_EQ(parseMinutes("2 hours 15 minutes"), 135);
+    EXPECT_EQ(parseMinutes(""), -1);
+    EXPECT_EQ(parseMinutes("overnight"), -1);
+}
+
+TEST_F(RecipeTest, TimeDefaultsToUnknown) {
+    EXPECT_EQ(recipe->getTimeMinutes(), -1);
+}
+
+TEST(ParseAmountTest, Numbers) {
+    EXPECT_DOUBLE_EQ(parseAmount("2 pieces"), 2.0);
+    EXPECT_DOUBLE_EQ(parseAmount("1/2 cup"), 0.5);
+    EXPECT_DOUBLE_EQ(parseAmount("1 1/2 cups"), 1.5);
+    EXPECT_DOUBLE_EQ(parseAmount("0.25 l"), 0.25);
+    EXPECT_DOUBLE_EQ(parseAmount("to taste "), 0.0);
+    EXPECT_DOUBLE_EQ(parseAmount("200"), 200.0);
+}
+
+TEST(ParseAmountTest, MeasuredOrCounted) {
+    EXPECT_TRUE(isMeasuredAmount("200 g"));
+    EXPECT_TRUE(isMeasuredAmount("1/2 cup"));
+    EXPECT_TRUE(isMeasuredAmount("1 1/2 Tablespoons"));
+    EXPECT_TRUE(isMeasuredAmount("2 cups, sifted"));
+    EXPECT_FALSE(isMeasuredAmount("3 "));
+    EXPECT_FALSE(isMeasuredAmount("2 slices"));
+    EXPECT_FALSE(isMeasuredAmount("1 large"));
+    EXPECT_FALSE(isMeasuredAmount("4 cloves"));
+    EXPECT_FALSE(isMeasuredAmount("a pinch"));
+}
+
+TEST(ParseAmountTest, StockNeeded) {
+    EXPECT_DOUBLE_EQ(stockNeeded("200 g"), 200.0);
+    EXPECT_DOUBLE_EQ(stockNeeded("1/2 cup"), 0.5);
+    EXPECT_DOUBLE_EQ(stockNeeded("1 1/2 slices"), 2.0);
+    EXPECT_DOUBLE_EQ(stockNeeded("3 "), 3.0);
+    EXPECT_DOUBLE_EQ(stockNeeded("to taste "), 0.0);
+}
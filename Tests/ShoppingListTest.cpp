@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "ShoppingList.h"
+#include "TestRecipes.h"
+
+class ShoppingListTest : public ::testing::Test {
+protected:
+    RecipeCatalog catalog{ {
+        makeRecipe("Omelette", { "egg", "cheese" }),
+        makeRecipe("Scrambled Eggs", { "egg", "butter" }),
+        makeRecipe("Fried Egg", { "egg", "oil" }),
+        makeRecipe("Beef Stew", { "beef", "carrots", "potato" }),
+        makeRecipe("Cheese Toast", { "bread", "cheese" }),
+        makeRecipe("Toast", { "bread" }),
+    } };
+    std::vector<Ingredient> inventory = { Ingredient("cheese", 1, ""), Ingredient("butter", 1, ""), Ingredient("oil", 1, ""), Ingredient("bread", 1, "") };
+
+    std::vector<std::string> names(const std::vector<std::size_t>& ids) {
+        std::vector<std::string> found;
+        for (std::size_t id : ids) {
+            found.push_back(catalog.getRecipes()[id].getRecipeName());
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+};
+
+TEST_F(ShoppingListTest, ForRecipesListsEachMissingItemOnce) {
+    ShoppingList list = ShoppingListPlanner(catalog, inventory).forRecipes({ "Omelette", "Beef Stew", "Fried Egg", "Nope" });
+    EXPECT_EQ(list.items, (std::vector<std::string>{ "egg", "beef", "carrots", "potato" }));
+    EXPECT_DOUBLE_EQ(list.cost, 4.0);
+    EXPECT_EQ(names(list.enabledRecipes), (std::vector<std::string>{ "Beef Stew", "Fried Egg", "Omelette" }));
+}
+
+TEST_F(ShoppingListTest, GreedyPicksTheIngredientThatUnlocksMost) {
+    ShoppingListPlanner planner(catalog, inventory);
+    ShoppingList one = planner.enableMost(1);
+    EXPECT_EQ(one.items, std::vector<std::string>{ "egg" });
+    EXPECT_EQ(names(one.enabledRecipes), (std::vector<std::string>{ "Fried Egg", "Omelette", "Scrambled Eggs" }));
+
+    ShoppingList all = planner.enableMost(10);
+    EXPECT_EQ(all.items.size(), 4);   // then the three stew ingredients; nothing else helps
+    EXPECT_EQ(all.enabledRecipes.size(), 4);
+}
+
+TEST_F(ShoppingListTest, CostsSteerTheChoice) {
+    ShoppingListPlanner planner(catalog, inventory);
+    planner.setCost("egg", 10.0);
+    // Egg now scores 3 / 10; any stew ingredient scores 1/3 per unit of cost.
+    ShoppingList one = planner.enableMost(1);
+    EXPECT_EQ(one.items, std::vector<std::string>{ "beef" });
+    EXPECT_TRUE(one.enabledRecipes.empty());
+}
+
+TEST_F(ShoppingListTest, ThreadCountDoesNotChangeTheResult) {
+    ShoppingListPlanner planner(catalog, inventory);
+    EXPECT_EQ(planner.enableMost(10, 1).items, planner.enableMost(10, 8).items);
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/ShoppingListTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
@@ -30,6 +30,30 @@ TEST_F(StorageTest, AddExistingIngredientUpdatesQuantity) {
     EXPECT_EQ(storage.getIngredients()[0].getQuantity(), 5);  // Quantity should be updated to 5
 }
 
+TEST_F(StorageTest, MergesNamesUpToCaseAndPlurals) {
+    storage.addIngredient(Ingredient("Egg", 2, ""));
+    storage.addIngredient(Ingredient("eggs", 6, ""));
+    storage.addIngredients({ Ingredient("EGG", 1, ""), Ingredient("egg white", 1, "") });
+
+    ASSERT_EQ(storage.getIngredients().size(), 2);
+    EXPECT_EQ(storage.getIngredients()[0].getName(), "Egg");   // the first spelling stays
+    EXPECT_EQ(storage.getIngredients()[0].getQuantity(), 9);
+}
+
+TEST_F(StorageTest, FindsItemsByAnySpellingItMergesUnder) {
+    storage.addIngredient(Ingredient("Egg", 2, ""));
+    storage.addIngredient(Ingredient("milk", 1, ""));
+
+    EXPECT_TRUE(storage.setQuantity("eggs", 5));
+    EXPECT_EQ(storage.getIngredients()[0].getQuantity(), 5);
+    EXPECT_TRUE(storage.setAmount("MILK", 0.5));
+    EXPECT_DOUBLE_EQ(storage.getIngredients()[1].getAmount(), 0.5);
+    EXPECT_FALSE(storage.removeIngredient("egg white"));
+    EXPECT_TRUE(storage.removeIngredient("EGGS"));
+    ASSERT_EQ(storage.getIngredients().size(), 1);
+    EXPECT_EQ(storage.getIngredients()[0].getName(), "milk");
+}
+
 TEST_F(StorageTest, ConvertToJson) {
     Ingredient sugar("Sugar", 2, "2024-12-31");
     storage.addIngredient(sugar);
@@ -53,5 +77,18 @@ TEST_F(StorageTest, ConvertFromJson) {
     EXPECT_EQ(storage.getIngredients()[1].getName(), "Flour");
 }
 
-//to run: g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Storage.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/StorageTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/ -lgtest -lgtest_main -o runTests
+TEST_F(StorageTest, AddIngredientsMergesInOnePass) {
+    storage.addIngredient(Ingredient("Sugar", 2, "2024-12-31"));
+    storage.addIngredients({ Ingredient("Flour", 1, ""), Ingredient("Sugar", 3, ""), Ingredient("Flour", 4, "2025-01-10") });
+
+    ASSERT_EQ(storage.getIngredients().size(), 2);
+    EXPECT_EQ(storage.getIngredients()[0].getName(), "Sugar");
+    EXPECT_EQ(storage.getIngredients()[0].getQuantity(), 5);
+    EXPECT_EQ(storage.getIngredients()[0].getExpirationDate(), "2024-12-31");
+    EXPECT_EQ(storage.getIngredients()[1].getName(), "Flour");
+    EXPECT_EQ(storage.getIngredients()[1].getQuantity(), 5);
+    EXPECT_EQ(storage.getIngredients()[1].getExpirationDate(), "2025-01-10");
+}
+
+//to run: g++ -std=c++14 -isystem /usr/include/gtest -pthread /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Ingredient.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/CivilDate.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/IngredientAliases.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles/Storage.cpp /Users/makennawarner/RecipeManager/CompProgramming-2-Project-/Tests/StorageTest.cpp -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/HeaderFiles -I/Users/makennawarner/RecipeManager/CompProgramming-2-Project-/ -lgtest -lgtest_main -o runTests
 //./runTests
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "SubstitutionGraph.h"
+#include "TestRecipes.h"
+
+class SubstitutionGraphTest : public ::testing::Test {
+protected:
+    RecipeCatalog catalog{ {
+        makeRecipe("Scrambled Eggs", { "Eggs", "Butter" }),
+        makeRecipe("Pancakes", { "flour", "buttermilk", "egg" }),
+        makeRecipe("Toast", { "bread", "butter" }),
+        makeRecipe("Salad", { "lettuce", "vegetable oil" }),
+    } };
+    SubstitutionGraph graph{ json::parse(R"({
+        "butter": {"margarine": 1, "vegetable oil": 3},
+        "vegetable oil": {"olive oil": 1},
+        "buttermilk": ["milk"]
+    })") };
+
+    std::vector<std::string> makeable(const SubstitutionClosure& closure) {
+        std::vector<std::string> names;
+        for (const Recipe* recipe : catalog.findMakeable(closure.getAvailable(), catalog.getCategories().find("savory"))) {
+            names.push_back(recipe->getRecipeName());
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+};
+
+TEST_F(SubstitutionGraphTest, ParsesBothForms) {
+    EXPECT_EQ(graph.nodeCount(), 6);
+    EXPECT_EQ(graph.edgeCount(), 4);
+    std::vector<SubstitutionGraph::Edge> forButter = graph.getSubstitutes(graph.findNode("Butter"));
+    ASSERT_EQ(forButter.size(), 2);
+    EXPECT_EQ(graph.getNodeName(forButter[0].node), "margarine");   // cheapest first
+    EXPECT_FLOAT_EQ(forButter[1].cost, 3.0f);
+    EXPECT_EQ(graph.findNode("cream"), SubstitutionGraph::kNoNode);
+}
+
+TEST_F(SubstitutionGraphTest, SubstituteInStockSatisfiesIngredient) {
+    std::vector<Ingredient> inventory = { Ingredient("egg", 2, ""), Ingredient("margarine", 1, "") };
+    SubstitutionClosure closure(catalog, graph, inventory);
+    EXPECT_EQ(makeable(closure), std::vector<std::string>{ "Scrambled Eggs" });
+
+    const SubstitutionClosure::Substitute* substitute = closure.substituteFor(catalog.findIngredient("butter"));
+    ASSERT_NE(substitute, nullptr);
+    EXPECT_EQ(substitute->name, "margarine");
+    EXPECT_FLOAT_EQ(substitute->cost, 1.0f);
+    EXPECT_EQ(closure.substituteFor(catalog.findIngredient("egg")), nullptr);   // in stock itself
+}
+
+TEST_F(SubstitutionGraphTest, ChainsAddUpAndRespectMaxCost) {
+    std::vector<Ingredient> inventory = { Ingredient("bread", 1, ""), Ingredient("olive oil", 1, "") };
+    SubstitutionClosure closure(catalog, graph, inventory);
+    EXPECT_EQ(makeable(closure), std::vector<std::string>{ "Toast" });
+    EXPECT_FLOAT_EQ(closure.substituteFor(catalog.findIngredient("butter"))->cost, 4.0f);
+
+    SubstitutionClosure cheap(catalog, graph, inventory, 3.0f);
+    EXPECT_FALSE(cheap.isAvailable(catalog.findIngredient("butter")));
+    EXPECT_TRUE(makeable(cheap).empty());
+}
+
+TEST_F(SubstitutionGraphTest, SubstitutionsOnlyGoOneWay) {
+    // Vegetable oil can replace butter, but butter cannot replace vegetable oil.
+    std::vector<Ingredient> inventory = { Ingredient("flour", 1, ""), Ingredient("milk", 1, ""), Ingredient("eggs", 6, ""),
+                                          Ingredient("butter", 1, ""), Ingredient("lettuce", 1, "") };
+    SubstitutionClosure closure(catalog, graph, inventory);
+    EXPECT_EQ(makeable(closure), (std::vector<std::string>{ "Pancakes", "Scrambled Eggs" }));
+    EXPECT_FALSE(closure.isAvailable(catalog.findIngredient("vegetable oil")));
+    ASSERT_NE(closure.substituteFor(catalog.findIngredient("buttermilk")), nullptr);
+    EXPECT_EQ(closure.substituteFor(catalog.findIngredient("buttermilk"))->name, "milk");
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/SubstitutionGraphTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests
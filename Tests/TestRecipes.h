@@ -0,0 +1,25 @@
+#ifndef TESTRECIPES_H
+#define TESTRECIPES_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Recipe.h"
+
+// Recipes for tests that build a catalog in memory. makeRecipe needs one of each ingredient;
+// recipeWithAmounts takes the amounts as the recipe file would give them.
+inline Recipe recipeWithAmounts(const std::string& name, std::vector<std::pair<std::string, std::string>> amounts,
+                                const std::string& category = "Savory", int minutes = -1) {
+    return Recipe(name, std::move(amounts), std::vector<std::pair<std::string, std::string>>{}, std::vector<std::string>{}, category, minutes);
+}
+
+inline Recipe makeRecipe(const std::string& name, const std::vector<std::string>& ingredients,
+                         const std::string& category = "Savory", int minutes = -1) {
+    std::vector<std::pair<std::string, std::string>> amounts;
+    for (const auto& ingredient : ingredients) {
+        amounts.push_back({ ingredient, "1" });
+    }
+    return recipeWithAmounts(name, std::move(amounts), category, minutes);
+}
+
+#endif
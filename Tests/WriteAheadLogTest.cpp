@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <set>
+#include <thread>
+#include "WriteAheadLog.h"
+
+#ifdef __unix__
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+class WriteAheadLogTest : public ::testing::Test {
+protected:
+    fs::path logFile;
+
+    void SetUp() override {
+        logFile = fs::temp_directory_path() / "write_ahead_log_test.wal";
+        fs::remove(logFile);
+    }
+
+    void TearDown() override {
+        fs::remove(logFile);
+    }
+};
+
+TEST_F(WriteAheadLogTest, BatchIsOneSync) {
+    {
+        WriteAheadLog log(logFile.string());
+        for (int i = 0; i < 200; ++i) {
+            EXPECT_EQ(log.add({ {"n", i} }), static_cast<std::uint64_t>(i + 1));
+        }
+        EXPECT_TRUE(log.commit());
+        EXPECT_EQ(log.syncCount(), 1);
+        EXPECT_TRUE(log.commit());   // nothing new, nothing to sync
+        EXPECT_EQ(log.syncCount(), 1);
+    }
+    std::vector<json> entries = WriteAheadLog::readEntries(logFile.string());
+    ASSERT_EQ(entries.size(), 200);
+    EXPECT_EQ(entries[199]["n"], 199);
+    EXPECT_EQ(entries[199]["seq"], 200);
+}
+
+TEST_F(WriteAheadLogTest, AddAllNumbersEntriesTogether) {
+    WriteAheadLog log(logFile.string());
+    log.add({ {"n", 0} });
+    std::vector<json> entries = { { {"n", 1} }, { {"n", 2} } };
+    EXPECT_EQ(log.addAll(entries), 3);
+    EXPECT_EQ(entries[0]["seq"], 2);
+    EXPECT_EQ(entries[1]["seq"], 3);
+    EXPECT_TRUE(log.commit(2, 3));
+    EXPECT_EQ(WriteAheadLog::readEntries(logFile.string()).size(), 3);
+}
+
+TEST_F(WriteAheadLogTest, ConcurrentCommitsShareSyncs) {
+    WriteAheadLog log(logFile.string());
+    const int threads = 8;
+    const int perThread = 50;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                log.add({ {"thread", t}, {"i", i} });
+                EXPECT_TRUE(log.commit());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(WriteAheadLog::readEntries(logFile.string()).size(), threads * perThread);
+    EXPECT_LE(log.syncCount(), static_cast<std::size_t>(threads * perThread));
+    EXPECT_EQ(log.lastSequence(), static_cast<std::uint64_t>(threads * perThread));
+}
+
+TEST_F(WriteAheadLogTest, TornTailIsDroppedAndNumberingContinues) {
+    {
+        WriteAheadLog log(logFile.string());
+        log.add({ {"n", 1} });
+        log.add({ {"n", 2} });
+        log.commit();
+    }
+    std::ofstream(logFile, std::ios::app) << "{\"n\": 3, \"se";   // crash mid-write
+
+    EXPECT_EQ(WriteAheadLog::readEntries(logFile.string()).size(), 2);
+    WriteAheadLog log(logFile.string());
+    EXPECT_EQ(log.lastSequence(), 2);
+    EXPECT_EQ(log.add({ {"n", 3} }), 3);
+    log.commit();
+    std::vector<json> entries = WriteAheadLog::readEntries(logFile.string());
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_EQ(entries[2]["n"], 3);
+}
+
+TEST_F(WriteAheadLogTest, ResetKeepsCounting) {
+    WriteAheadLog log(logFile.string(), 41);
+    log.add({ {"n", 1} });
+    EXPECT_TRUE(log.reset());
+    EXPECT_TRUE(WriteAheadLog::readEntries(logFile.string()).empty());
+    EXPECT_EQ(log.add({ {"n", 2} }), 43);
+    log.commit();
+    EXPECT_EQ(WriteAheadLog::readEntries(logFile.string()).size(), 1);
+}
+
+TEST_F(WriteAheadLogTest, CommittingNothingSucceeds) {
+    WriteAheadLog log(logFile.string());
+    EXPECT_TRUE(log.commit());
+    EXPECT_EQ(log.syncCount(), 0);
+}
+
+#ifdef __unix__
+// A file size limit makes the write stop part way through the batch, as a full disk would.
+TEST_F(WriteAheadLogTest, FailedBatchIsCutOffAndLogCarriesOn) {
+    WriteAheadLog log(logFile.string());
+    log.add({ {"n", 1} });
+    ASSERT_TRUE(log.commit());
+    std::uintmax_t size = fs::file_size(logFile);
+
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit previous;
+    getrlimit(RLIMIT_FSIZE, &previous);
+    rlimit limited = previous;
+    limited.rlim_cur = size + 10;
+    setrlimit(RLIMIT_FSIZE, &limited);
+    log.add({ {"n", 2}, {"note", std::string(100, 'x')} });
+    bool committed = log.commit();
+    setrlimit(RLIMIT_FSIZE, &previous);
+
+    EXPECT_FALSE(committed);
+    EXPECT_EQ(fs::file_size(logFile), size);   // nothing of the failed entry is left to replay
+    log.add({ {"n", 3} });
+    EXPECT_TRUE(log.commit());
+    std::vector<json> entries = WriteAheadLog::readEntries(logFile.string());
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[1]["n"], 3);
+    EXPECT_TRUE(log.reset());
+}
+
+// Once the file reaches the size limit every later batch fails. A commit reports failure
+// exactly when its entry did not reach the log, even when the batch that did write it is
+// followed by a failed one before the committing thread wakes up.
+TEST_F(WriteAheadLogTest, ConcurrentCommitsReportOnlyTheirOwnBatch) {
+    WriteAheadLog log(logFile.string());
+    const int threads = 8;
+    const int perThread = 40;
+    const std::string padding(60, 'x');
+
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit previous;
+    getrlimit(RLIMIT_FSIZE, &previous);
+    rlimit limited = previous;
+    limited.rlim_cur = threads * perThread / 2 * 100;
+    setrlimit(RLIMIT_FSIZE, &limited);
+    std::vector<std::vector<std::pair<std::uint64_t, bool>>> results(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                std::uint64_t sequence = log.add({ {"note", padding} });
+                results[t].emplace_back(sequence, log.commit(sequence, sequence));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    setrlimit(RLIMIT_FSIZE, &previous);
+
+    std::set<std::uint64_t> logged;
+    for (const auto& entry : WriteAheadLog::readEntries(logFile.string())) {
+        logged.insert(entry["seq"].get<std::uint64_t>());
+    }
+    std::size_t failures = 0;
+    for (const auto& thread : results) {
+        for (const auto& result : thread) {
+            EXPECT_EQ(result.second, logged.count(result.first) == 1) << "entry " << result.first;
+            failures += result.second ? 0 : 1;
+        }
+    }
+    EXPECT_GT(failures, 0);
+    EXPECT_GT(logged.size(), 0);
+    EXPECT_TRUE(log.reset());
+}
+#endif
+
+TEST_F(WriteAheadLogTest, MissingFileHasNoEntries) {
+    EXPECT_TRUE(WriteAheadLog::readEntries((fs::temp_directory_path() / "no_such_log.wal").string()).empty());
+}
+
+//to run: g++ -std=c++17 -isystem /usr/include/gtest -pthread /path/to/project/HeaderFiles/*.cpp /path/to/project/Tests/WriteAheadLogTest.cpp -I/path/to/project/HeaderFiles -I/path/to/project/ -lgtest -lgtest_main -o runTests
+//./runTests